@@ -4,14 +4,16 @@ const common = require('../common');
 
 const bench = common.createBenchmark(main, {
   len: [4, 8, 16, 32],
+  scanner: ['legacy', 'simd'],
   n: [1e5]
 }, {
   flags: ['--expose-internals', '--no-warnings']
 });
 
-function main({ len, n }) {
+function main({ len, scanner, n }) {
   const { internalBinding } = require('internal/test/binding');
-  const { HTTPParser } = internalBinding('http_parser');
+  const { HTTPParser, setScanner } = internalBinding('http_parser');
+  setScanner(scanner);
   const REQUEST = HTTPParser.REQUEST;
   const kOnHeaders = HTTPParser.kOnHeaders | 0;
   const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
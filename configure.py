@@ -387,6 +387,12 @@ parser.add_option('--with-etw',
     dest='with_etw',
     help='build with ETW (default is true on Windows)')
 
+parser.add_option('--with-uv-work-stealing',
+    action='store_true',
+    dest='with_uv_work_stealing',
+    help='make the work-stealing libuv threadpool the default (it can also '
+         'be selected at run time with UV_THREADPOOL_WORK_STEALING=1)')
+
 intl_optgroup.add_option('--with-intl',
     action='store',
     dest='with_intl',
@@ -904,6 +910,8 @@ def configure_node(o):
     o['variables']['OS'] = 'android'
   o['variables']['node_prefix'] = options.prefix
   o['variables']['node_install_npm'] = b(not options.without_npm)
+  o['variables']['uv_threadpool_work_stealing'] = \
+      b(options.with_uv_work_stealing)
   o['default_configuration'] = 'Debug' if options.debug else 'Release'
 
   host_arch = host_arch_win() if os.name == 'nt' else host_arch_cc()
@@ -25,6 +25,24 @@
 #include <string.h>
 #include <limits.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# define HTTP_PARSER_SSE2 1
+# include <emmintrin.h>
+/* AVX2 is picked at run time, so it needs per-function target attributes. */
+# if (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)) && \
+     (defined(__x86_64__) || defined(__i386__))
+#  define HTTP_PARSER_AVX2 1
+#  include <immintrin.h>
+# endif
+# ifdef _MSC_VER
+#  include <intrin.h>
+# endif
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__GNUC__)
+# define HTTP_PARSER_NEON 1
+# include <arm_neon.h>
+#endif
+
 #ifndef ULLONG_MAX
 # define ULLONG_MAX ((uint64_t) -1) /* 2^64-1 */
 #endif
@@ -443,6 +461,293 @@ enum http_host_state
 #define start_state (parser->type == HTTP_REQUEST ? s_start_req : s_start_res)
 
 
+/* Scanners used by HTTP_PARSER_SCAN_SIMD. Each one returns a pointer to the
+ * first byte in [p, end) that the state machine has to look at, or end.
+ *
+ * header_field: skips [A-Za-z0-9-], which cannot end a header name and
+ *               cannot matter once header_state is h_general.
+ * header_value: finds the first CR or LF.
+ * url:          skips %x21-7E except '?' and '#', which leave the path and
+ *               query states where they are.
+ */
+struct http_parser_scanner {
+  const char *name;
+  const char *(*header_field)(const char *p, const char *end);
+  const char *(*header_value)(const char *p, const char *end);
+  const char *(*url)(const char *p, const char *end);
+};
+
+#define IS_PLAIN_FIELD_CHAR(c)                                       \
+  (IS_ALPHANUM(c) || (c) == '-')
+#define IS_PLAIN_URL_CHAR(c)                                         \
+  ((unsigned char) (c) > 0x20 && (unsigned char) (c) < 0x7F &&       \
+   (c) != '?' && (c) != '#')
+
+static const char *
+scan_header_field_table(const char *p, const char *end)
+{
+  while (p != end && IS_PLAIN_FIELD_CHAR(*p))
+    p++;
+  return p;
+}
+
+static const char *
+scan_header_value_table(const char *p, const char *end)
+{
+  while (p != end && *p != CR && *p != LF)
+    p++;
+  return p;
+}
+
+static const char *
+scan_url_table(const char *p, const char *end)
+{
+  while (p != end && IS_PLAIN_URL_CHAR(*p))
+    p++;
+  return p;
+}
+
+#if !defined(HTTP_PARSER_SSE2) && !defined(HTTP_PARSER_NEON)
+static const struct http_parser_scanner scanner_table =
+  { "table"
+  , scan_header_field_table
+  , scan_header_value_table
+  , scan_url_table
+  };
+#endif
+
+#if defined(_MSC_VER)
+static unsigned
+first_bit(unsigned x)
+{
+  unsigned long i;
+  _BitScanForward(&i, x);
+  return (unsigned) i;
+}
+#elif defined(HTTP_PARSER_SSE2) || defined(HTTP_PARSER_NEON)
+# define first_bit(x) ((unsigned) __builtin_ctz(x))
+#endif
+
+#ifdef HTTP_PARSER_SSE2
+/* The x86 comparisons are signed, so bytes >= 0x80 never fall in a range. */
+static const char *
+scan_header_field_sse2(const char *p, const char *end)
+{
+  const __m128i dash = _mm_set1_epi8('-');
+  const __m128i case_bit = _mm_set1_epi8(0x20);
+  const __m128i before_a = _mm_set1_epi8('a' - 1);
+  const __m128i after_z = _mm_set1_epi8('z' + 1);
+  const __m128i before_0 = _mm_set1_epi8('0' - 1);
+  const __m128i after_9 = _mm_set1_epi8('9' + 1);
+
+  for (; end - p >= 16; p += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *) p);
+    __m128i lower = _mm_or_si128(v, case_bit);
+    __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, before_a),
+                                  _mm_cmplt_epi8(lower, after_z));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, before_0),
+                                  _mm_cmplt_epi8(v, after_9));
+    __m128i plain = _mm_or_si128(_mm_or_si128(alpha, digit),
+                                 _mm_cmpeq_epi8(v, dash));
+    unsigned mask = ~(unsigned) _mm_movemask_epi8(plain) & 0xFFFF;
+    if (mask != 0)
+      return p + first_bit(mask);
+  }
+  return scan_header_field_table(p, end);
+}
+
+static const char *
+scan_header_value_sse2(const char *p, const char *end)
+{
+  const __m128i cr = _mm_set1_epi8(CR);
+  const __m128i lf = _mm_set1_epi8(LF);
+
+  for (; end - p >= 16; p += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *) p);
+    __m128i eol = _mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, lf));
+    unsigned mask = (unsigned) _mm_movemask_epi8(eol);
+    if (mask != 0)
+      return p + first_bit(mask);
+  }
+  return scan_header_value_table(p, end);
+}
+
+static const char *
+scan_url_sse2(const char *p, const char *end)
+{
+  const __m128i bang = _mm_set1_epi8('!');
+  const __m128i tilde = _mm_set1_epi8('~');
+  const __m128i question = _mm_set1_epi8('?');
+  const __m128i hash = _mm_set1_epi8('#');
+
+  for (; end - p >= 16; p += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *) p);
+    __m128i stop = _mm_or_si128(
+        _mm_or_si128(_mm_cmplt_epi8(v, bang), _mm_cmpgt_epi8(v, tilde)),
+        _mm_or_si128(_mm_cmpeq_epi8(v, question), _mm_cmpeq_epi8(v, hash)));
+    unsigned mask = (unsigned) _mm_movemask_epi8(stop);
+    if (mask != 0)
+      return p + first_bit(mask);
+  }
+  return scan_url_table(p, end);
+}
+
+static const struct http_parser_scanner scanner_sse2 =
+  { "sse2"
+  , scan_header_field_sse2
+  , scan_header_value_sse2
+  , scan_url_sse2
+  };
+#endif  /* HTTP_PARSER_SSE2 */
+
+#ifdef HTTP_PARSER_AVX2
+# define AVX2_TARGET __attribute__((target("avx2")))
+
+AVX2_TARGET static const char *
+scan_header_field_avx2(const char *p, const char *end)
+{
+  const __m256i dash = _mm256_set1_epi8('-');
+  const __m256i case_bit = _mm256_set1_epi8(0x20);
+  const __m256i before_a = _mm256_set1_epi8('a' - 1);
+  const __m256i z = _mm256_set1_epi8('z');
+  const __m256i before_0 = _mm256_set1_epi8('0' - 1);
+  const __m256i nine = _mm256_set1_epi8('9');
+
+  for (; end - p >= 32; p += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *) p);
+    __m256i lower = _mm256_or_si256(v, case_bit);
+    __m256i alpha = _mm256_andnot_si256(_mm256_cmpgt_epi8(lower, z),
+                                        _mm256_cmpgt_epi8(lower, before_a));
+    __m256i digit = _mm256_andnot_si256(_mm256_cmpgt_epi8(v, nine),
+                                        _mm256_cmpgt_epi8(v, before_0));
+    __m256i plain = _mm256_or_si256(_mm256_or_si256(alpha, digit),
+                                    _mm256_cmpeq_epi8(v, dash));
+    unsigned mask = ~(unsigned) _mm256_movemask_epi8(plain);
+    if (mask != 0)
+      return p + first_bit(mask);
+  }
+  return scan_header_field_sse2(p, end);
+}
+
+AVX2_TARGET static const char *
+scan_header_value_avx2(const char *p, const char *end)
+{
+  const __m256i cr = _mm256_set1_epi8(CR);
+  const __m256i lf = _mm256_set1_epi8(LF);
+
+  for (; end - p >= 32; p += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *) p);
+    __m256i eol = _mm256_or_si256(_mm256_cmpeq_epi8(v, cr),
+                                  _mm256_cmpeq_epi8(v, lf));
+    unsigned mask = (unsigned) _mm256_movemask_epi8(eol);
+    if (mask != 0)
+      return p + first_bit(mask);
+  }
+  return scan_header_value_sse2(p, end);
+}
+
+AVX2_TARGET static const char *
+scan_url_avx2(const char *p, const char *end)
+{
+  const __m256i bang = _mm256_set1_epi8('!');
+  const __m256i tilde = _mm256_set1_epi8('~');
+  const __m256i question = _mm256_set1_epi8('?');
+  const __m256i hash = _mm256_set1_epi8('#');
+
+  for (; end - p >= 32; p += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *) p);
+    __m256i stop = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpgt_epi8(bang, v),
+                        _mm256_cmpgt_epi8(v, tilde)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, question),
+                        _mm256_cmpeq_epi8(v, hash)));
+    unsigned mask = (unsigned) _mm256_movemask_epi8(stop);
+    if (mask != 0)
+      return p + first_bit(mask);
+  }
+  return scan_url_sse2(p, end);
+}
+
+static const struct http_parser_scanner scanner_avx2 =
+  { "avx2"
+  , scan_header_field_avx2
+  , scan_header_value_avx2
+  , scan_url_avx2
+  };
+#endif  /* HTTP_PARSER_AVX2 */
+
+#ifdef HTTP_PARSER_NEON
+/* Index of the first nonzero byte in a comparison result, or 16. */
+static unsigned
+neon_first(uint8x16_t m)
+{
+  uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(m), 4);
+  uint64_t bits = vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+  return bits == 0 ? 16 : (unsigned) __builtin_ctzll(bits) >> 2;
+}
+
+static const char *
+scan_header_field_neon(const char *p, const char *end)
+{
+  const uint8x16_t case_bit = vdupq_n_u8(0x20);
+
+  for (; end - p >= 16; p += 16) {
+    uint8x16_t v = vld1q_u8((const uint8_t *) p);
+    uint8x16_t lower = vorrq_u8(v, case_bit);
+    uint8x16_t alpha = vandq_u8(vcgeq_u8(lower, vdupq_n_u8('a')),
+                                vcleq_u8(lower, vdupq_n_u8('z')));
+    uint8x16_t digit = vandq_u8(vcgeq_u8(v, vdupq_n_u8('0')),
+                                vcleq_u8(v, vdupq_n_u8('9')));
+    uint8x16_t plain = vorrq_u8(vorrq_u8(alpha, digit),
+                                vceqq_u8(v, vdupq_n_u8('-')));
+    unsigned i = neon_first(vmvnq_u8(plain));
+    if (i != 16)
+      return p + i;
+  }
+  return scan_header_field_table(p, end);
+}
+
+static const char *
+scan_header_value_neon(const char *p, const char *end)
+{
+  for (; end - p >= 16; p += 16) {
+    uint8x16_t v = vld1q_u8((const uint8_t *) p);
+    unsigned i = neon_first(vorrq_u8(vceqq_u8(v, vdupq_n_u8(CR)),
+                                     vceqq_u8(v, vdupq_n_u8(LF))));
+    if (i != 16)
+      return p + i;
+  }
+  return scan_header_value_table(p, end);
+}
+
+static const char *
+scan_url_neon(const char *p, const char *end)
+{
+  for (; end - p >= 16; p += 16) {
+    uint8x16_t v = vld1q_u8((const uint8_t *) p);
+    uint8x16_t stop = vorrq_u8(vcleq_u8(v, vdupq_n_u8(' ')),
+                               vcgeq_u8(v, vdupq_n_u8(0x7F)));
+    stop = vorrq_u8(stop, vorrq_u8(vceqq_u8(v, vdupq_n_u8('?')),
+                                   vceqq_u8(v, vdupq_n_u8('#'))));
+    unsigned i = neon_first(stop);
+    if (i != 16)
+      return p + i;
+  }
+  return scan_url_table(p, end);
+}
+
+static const struct http_parser_scanner scanner_neon =
+  { "neon"
+  , scan_header_field_neon
+  , scan_header_value_neon
+  , scan_url_neon
+  };
+#endif  /* HTTP_PARSER_NEON */
+
+/* NULL means HTTP_PARSER_SCAN_SCALAR. */
+static const struct http_parser_scanner *scanner = NULL;
+
+
 #if HTTP_PARSER_STRICT
 # define STRICT_CHECK(cond)                                          \
 do {                                                                 \
@@ -644,6 +949,7 @@ size_t http_parser_execute (http_parser *parser,
   const char *status_mark = 0;
   enum state p_state = (enum state) parser->state;
   const unsigned int lenient = parser->lenient_http_headers;
+  const struct http_parser_scanner *scan = scanner;
 
   /* We're in an error state. Don't bother doing anything. */
   if (HTTP_PARSER_ERRNO(parser) != HPE_OK) {
@@ -1080,6 +1386,12 @@ reexecute:
               SET_ERRNO(HPE_INVALID_URL);
               goto error;
             }
+            if (scan != NULL && (CURRENT_STATE() == s_req_path ||
+                                 CURRENT_STATE() == s_req_query_string)) {
+              const char* next = scan->url(p + 1, data + len);
+              COUNT_HEADER_SIZE(next - (p + 1));
+              p = next - 1;
+            }
         }
         break;
       }
@@ -1239,6 +1551,8 @@ reexecute:
 
           switch (parser->header_state) {
             case h_general:
+              if (scan != NULL)
+                p = scan->header_field(p + 1, data + len) - 1;
               break;
 
             case h_C:
@@ -1473,6 +1787,12 @@ reexecute:
 
               limit = MIN(limit, HTTP_MAX_HEADER_SIZE);
 
+              if (scan != NULL) {
+                const char* eol = scan->header_value(p, p + limit);
+                p = (eol != p + limit ? eol : data + len) - 1;
+                break;
+              }
+
               p_cr = (const char*) memchr(p, CR, limit);
               p_lf = (const char*) memchr(p, LF, limit);
               if (p_cr != NULL) {
@@ -2431,6 +2751,34 @@ http_body_is_final(const struct http_parser *parser) {
     return parser->state == s_message_done;
 }
 
+void
+http_parser_set_scan(enum http_parser_scan scan) {
+  if (scan == HTTP_PARSER_SCAN_SCALAR) {
+    scanner = NULL;
+    return;
+  }
+
+#if defined(HTTP_PARSER_AVX2)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    scanner = &scanner_avx2;
+    return;
+  }
+#endif
+#if defined(HTTP_PARSER_SSE2)
+  scanner = &scanner_sse2;
+#elif defined(HTTP_PARSER_NEON)
+  scanner = &scanner_neon;
+#else
+  scanner = &scanner_table;
+#endif
+}
+
+const char *
+http_parser_scan_name(void) {
+  return scanner != NULL ? scanner->name : "scalar";
+}
+
 unsigned long
 http_parser_version(void) {
   return HTTP_PARSER_VERSION_MAJOR * 0x10000 |
@@ -427,6 +427,30 @@ void http_parser_pause(http_parser *parser, int paused);
 /* Checks if this is the final chunk of the body. */
 int http_body_is_final(const http_parser *parser);
 
+/* How http_parser_execute() gets through runs of plain bytes in the request
+ * target and in header names and values.
+ *
+ * HTTP_PARSER_SCAN_SCALAR feeds every byte through the state machine.
+ * HTTP_PARSER_SCAN_SIMD skips over such runs with SSE2, AVX2 or NEON
+ * comparisons where the CPU supports them, and with tight table-driven loops
+ * elsewhere. Both produce the same callbacks and errors.
+ */
+enum http_parser_scan
+  { HTTP_PARSER_SCAN_SCALAR = 0
+  , HTTP_PARSER_SCAN_SIMD
+  };
+
+/* Select the scanning strategy for all parsers in the process. This is not
+ * thread-safe and should be called before any data is parsed. The default
+ * is HTTP_PARSER_SCAN_SCALAR.
+ */
+void http_parser_set_scan(enum http_parser_scan scan);
+
+/* Returns the name of the scanner in use: "scalar", "table", "sse2", "avx2"
+ * or "neon".
+ */
+const char *http_parser_scan_name(void);
+
 #ifdef __cplusplus
 }
 #endif
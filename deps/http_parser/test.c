@@ -4112,7 +4112,7 @@ test_message_connect (const struct message *msg)
 }
 
 int
-main (void)
+main (int argc, char **argv)
 {
   parser = NULL;
   int i, j, k;
@@ -4131,6 +4131,10 @@ main (void)
 
   printf("sizeof(http_parser) = %u\n", (unsigned int)sizeof(http_parser));
 
+  if (argc == 2 && strcmp(argv[1], "simd") == 0)
+    http_parser_set_scan(HTTP_PARSER_SCAN_SIMD);
+  printf("scanner = %s\n", http_parser_scan_name());
+
   for (request_count = 0; requests[request_count].name; request_count++);
   for (response_count = 0; responses[response_count].name; response_count++);
 
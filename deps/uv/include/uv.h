@@ -236,7 +236,10 @@ typedef struct uv_dirent_s uv_dirent_t;
 typedef struct uv_passwd_s uv_passwd_t;
 
 typedef enum {
-  UV_LOOP_BLOCK_SIGNAL
+  UV_LOOP_BLOCK_SIGNAL,
+  UV_METRICS_IDLE_TIME,
+  UV_LOOP_BUSY_POLL,
+  UV_LOOP_TIMER_WHEEL
 } uv_loop_option;
 
 typedef enum {
@@ -543,7 +546,9 @@ UV_EXTERN int uv_tcp_simultaneous_accepts(uv_tcp_t* handle, int enable);
 
 enum uv_tcp_flags {
   /* Used with uv_tcp_bind, when an IPv6 address is used. */
-  UV_TCP_IPV6ONLY = 1
+  UV_TCP_IPV6ONLY = 1,
+  /* Used with uv_tcp_bind, lets several sockets bind to the same address. */
+  UV_TCP_REUSEPORT = 2
 };
 
 UV_EXTERN int uv_tcp_bind(uv_tcp_t* handle,
@@ -589,7 +594,17 @@ enum uv_udp_flags {
    * (provided they all set the flag) but only the last one to bind will receive
    * any traffic, in effect "stealing" the port from the previous listener.
    */
-  UV_UDP_REUSEADDR = 4
+  UV_UDP_REUSEADDR = 4,
+  /*
+   * Indicates that the message was received by recvmmsg, so the buffer
+   * provided must not be freed by the recv_cb callback.
+   */
+  UV_UDP_MMSG_CHUNK = 8,
+  /*
+   * Indicates that recvmmsg should be used, if available. Used in
+   * uv_udp_init_ex.
+   */
+  UV_UDP_RECVMMSG = 256
 };
 
 typedef void (*uv_udp_send_cb)(uv_udp_send_t* req, int status);
@@ -653,6 +668,12 @@ UV_EXTERN int uv_udp_try_send(uv_udp_t* handle,
                               const uv_buf_t bufs[],
                               unsigned int nbufs,
                               const struct sockaddr* addr);
+UV_EXTERN int uv_udp_try_send2(uv_udp_t* handle,
+                               unsigned int count,
+                               uv_buf_t* bufs[],
+                               unsigned int nbufs[],
+                               struct sockaddr* addrs[],
+                               unsigned int flags);
 UV_EXTERN int uv_udp_recv_start(uv_udp_t* handle,
                                 uv_alloc_cb alloc_cb,
                                 uv_udp_recv_cb recv_cb);
@@ -1004,6 +1025,49 @@ UV_EXTERN int uv_queue_work(uv_loop_t* loop,
                             uv_work_cb work_cb,
                             uv_after_work_cb after_work_cb);
 
+typedef enum {
+  UV_WORK_CLASS_FS,
+  UV_WORK_CLASS_DNS,
+  UV_WORK_CLASS_CPU,
+  UV_WORK_CLASS_USER,
+  UV_WORK_CLASS_MAX
+} uv_work_class_t;
+
+UV_EXTERN int uv_queue_work_ex(uv_loop_t* loop,
+                               uv_work_t* req,
+                               uv_work_class_t work_class,
+                               uv_work_cb work_cb,
+                               uv_after_work_cb after_work_cb);
+UV_EXTERN int uv_threadpool_set_class(uv_work_class_t work_class,
+                                      unsigned int share,
+                                      int priority);
+UV_EXTERN int uv_threadpool_get_class(uv_work_class_t work_class,
+                                      unsigned int* share,
+                                      int* priority);
+
+/* Bucket i counts durations from 2^i up to 2^(i+1) microseconds, the last one
+ * everything above.
+ */
+#define UV_THREADPOOL_HISTOGRAM_BUCKETS 24
+
+typedef struct {
+  unsigned int queued;
+  unsigned int running;
+  uint64_t completed;
+  uint64_t wait_time[UV_THREADPOOL_HISTOGRAM_BUCKETS];
+  uint64_t run_time[UV_THREADPOOL_HISTOGRAM_BUCKETS];
+} uv_threadpool_class_stats_t;
+
+typedef struct {
+  unsigned int size;
+  unsigned int idle;
+  uv_threadpool_class_stats_t classes[UV_WORK_CLASS_MAX];
+} uv_threadpool_stats_t;
+
+UV_EXTERN int uv_threadpool_set_size(unsigned int size);
+UV_EXTERN unsigned int uv_threadpool_get_size(void);
+UV_EXTERN int uv_threadpool_get_stats(uv_threadpool_stats_t* stats);
+
 UV_EXTERN int uv_cancel(uv_req_t* req);
 
 
@@ -1232,6 +1296,22 @@ UV_EXTERN int uv_fs_copyfile(uv_loop_t* loop,
                              const char* new_path,
                              int flags,
                              uv_fs_cb cb);
+
+/*
+ * The mechanism uv_fs_copyfile() used to copy the data, as reported by
+ * uv_fs_get_copyfile_method().
+ */
+typedef enum {
+  UV_FS_COPYFILE_METHOD_UNKNOWN = 0,
+  UV_FS_COPYFILE_METHOD_CLONE,
+  UV_FS_COPYFILE_METHOD_COPY_FILE_RANGE,
+  UV_FS_COPYFILE_METHOD_SENDFILE,
+  UV_FS_COPYFILE_METHOD_SYSTEM,
+  UV_FS_COPYFILE_METHOD_NONE,
+  UV_FS_COPYFILE_METHOD_COPY_FILE_RANGE_SENDFILE
+} uv_fs_copyfile_method;
+
+UV_EXTERN uv_fs_copyfile_method uv_fs_get_copyfile_method(const uv_fs_t* req);
 UV_EXTERN int uv_fs_mkdir(uv_loop_t* loop,
                           uv_fs_t* req,
                           const char* path,
@@ -1566,6 +1646,14 @@ union uv_any_req {
 #undef XX
 
 
+/* Time spent blocked in the backend poll, see uv_metrics_idle_time(). */
+#define UV_LOOP_METRICS_FIELDS                                                \
+  struct {                                                                    \
+    uint64_t idle_time;                                                       \
+    uint64_t entry_time;                                                      \
+    int enabled;                                                              \
+  } metrics;
+
 struct uv_loop_s {
   /* User data - use this for whatever. */
   void* data;
@@ -1584,7 +1672,20 @@ struct uv_loop_s {
 UV_EXTERN void* uv_loop_get_data(const uv_loop_t*);
 UV_EXTERN void uv_loop_set_data(uv_loop_t*, void* data);
 
+UV_EXTERN uint64_t uv_metrics_idle_time(uv_loop_t* loop);
+
+typedef struct {
+  unsigned int budget;  /* Microseconds to spin before blocking, 0 if off. */
+  uint64_t polls;       /* Non-blocking polls made while spinning. */
+  uint64_t hits;        /* Spins that found events within the budget. */
+  uint64_t blocks;      /* Spins that ran out of budget and then blocked. */
+} uv_busy_poll_stats_t;
+
+UV_EXTERN int uv_loop_busy_poll_stats(const uv_loop_t* loop,
+                                      uv_busy_poll_stats_t* stats);
+
 /* Don't export the private CPP symbols. */
+#undef UV_LOOP_METRICS_FIELDS
 #undef UV_HANDLE_TYPE_PRIVATE
 #undef UV_REQ_TYPE_PRIVATE
 #undef UV_REQ_PRIVATE_FIELDS
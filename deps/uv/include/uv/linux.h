@@ -26,6 +26,13 @@
   uv__io_t inotify_read_watcher;                                              \
   void* inotify_watchers;                                                     \
   int inotify_fd;                                                             \
+  void* io_uring;                                                             \
+  struct {                                                                    \
+    unsigned int budget;                                                      \
+    uint64_t polls;                                                           \
+    uint64_t hits;                                                            \
+    uint64_t blocks;                                                          \
+  } busy_poll;                                                                \
 
 #define UV_PLATFORM_FS_EVENT_FIELDS                                           \
   void* watchers[2];                                                          \
@@ -221,11 +221,13 @@ typedef struct {
     unsigned int nelts;                                                       \
   } timer_heap;                                                               \
   uint64_t timer_counter;                                                     \
+  void* timer_wheel;                                                          \
   uint64_t time;                                                              \
   int signal_pipefd[2];                                                       \
   uv__io_t signal_io_watcher;                                                 \
   uv_signal_t child_watcher;                                                  \
   int emfile_fd;                                                              \
+  UV_LOOP_METRICS_FIELDS                                                      \
   UV_PLATFORM_LOOP_FIELDS                                                     \
 
 #define UV_REQ_TYPE_PRIVATE /* empty */
@@ -321,6 +321,7 @@ typedef struct {
   uv_handle_t* endgame_handles;                                               \
   /* TODO(bnoordhuis) Stop heap-allocating |timer_heap| in libuv v2.x. */     \
   void* timer_heap;                                                           \
+  void* timer_wheel;                                                          \
     /* Lists of active loop (prepare / check / idle) watchers */              \
   uv_prepare_t* prepare_handles;                                              \
   uv_check_t* check_handles;                                                  \
@@ -343,7 +344,8 @@ typedef struct {
   /* Threadpool */                                                            \
   void* wq[2];                                                                \
   uv_mutex_t wq_mutex;                                                        \
-  uv_async_t wq_async;
+  uv_async_t wq_async;                                                        \
+  UV_LOOP_METRICS_FIELDS
 
 #define UV_REQ_TYPE_PRIVATE                                                   \
   /* TODO: remove the req suffix */                                           \
@@ -25,25 +25,157 @@
 # include "unix/internal.h"
 #endif
 
+#include <stdio.h>
 #include <stdlib.h>
 
-#define MAX_THREADPOOL_SIZE 128
+#define MAX_THREADPOOL_SIZE 1024
+#define HISTOGRAM_BUCKETS UV_THREADPOOL_HISTOGRAM_BUCKETS
+
+/* Queued requests are kept in singly linked lists: wq[0] links to the next
+ * request and wq[1] holds the time of submission, in microseconds truncated
+ * to the size of a pointer. The QUEUE is only used again once the request
+ * is handed back to its loop.
+ */
+#define WORK_NEXT(w) (*(struct uv__work**) &(w)->wq[0])
+#define WORK_STAMP(w) ((w)->wq[1])
+
+struct uv__work_list {
+  struct uv__work* head;
+  struct uv__work* tail;
+  unsigned int count;
+};
+
+/* Every class of work has its own queue. A class may not occupy more than
+ * `share` threads at a time (0 means its default), and among the classes
+ * that have runnable work the one with the highest `priority` is served
+ * first. Classes with equal priority take turns.
+ */
+struct uv__work_class {
+  struct uv__work_list wq;  /* Shared queue mode only. */
+  unsigned int queued;
+  unsigned int running;
+  unsigned int share;
+  int priority;
+  const char* name;
+};
+
+/* Only ever written by the thread that owns them, summed up on request. */
+struct uv__thread_stats {
+  uint64_t completed[UV_WORK_CLASS_MAX];
+  uint64_t wait_time[UV_WORK_CLASS_MAX][HISTOGRAM_BUCKETS];
+  uint64_t run_time[UV_WORK_CLASS_MAX][HISTOGRAM_BUCKETS];
+};
+
+enum {
+  SLOT_UNUSED,
+  SLOT_RUNNING,
+  SLOT_EXITED  /* Retired, but not joined yet. */
+};
+
+struct uv__thread_slot {
+  uv_thread_t thread;
+  int state;
+  struct uv__thread_stats* stats;
+};
+
+struct uv__worker_arg {
+  uv_sem_t* sem;
+  unsigned int index;
+};
 
 static uv_once_t once = UV_ONCE_INIT;
 static uv_cond_t cond;
 static uv_mutex_t mutex;
 static unsigned int idle_threads;
-static unsigned int slow_io_work_running;
+/* The target size of the pool. Threads with a higher index retire as soon
+ * as they are done with their current request.
+ */
 static unsigned int nthreads;
-static uv_thread_t* threads;
-static uv_thread_t default_threads[4];
-static QUEUE exit_message;
-static QUEUE wq;
-static QUEUE run_slow_work_message;
-static QUEUE slow_io_pending_wq;
+/* Number of slots that have ever been used. */
+static unsigned int nslots;
+static struct uv__thread_slot slots[MAX_THREADPOOL_SIZE];
+static int exiting;
+static unsigned int next_class;
+static struct uv__work_class classes[UV_WORK_CLASS_MAX] = {
+  { { NULL, NULL, 0 }, 0, 0, 0, 1, "FS" },
+  { { NULL, NULL, 0 }, 0, 0, 0, 1, "DNS" },
+  { { NULL, NULL, 0 }, 0, 0, 0, 0, "CPU" },
+  { { NULL, NULL, 0 }, 0, 0, 0, 0, "USER" }
+};
+
+/* Work-stealing mode. Every worker owns a set of per-class queues. Work is
+ * submitted to lock-free per-class injection stacks, which a worker moves in
+ * bulk into its own queues; idle workers steal half of another worker's
+ * queue. Threads only touch the global mutex to go to sleep and wake up.
+ */
+struct uv__ws_worker {
+  uv_mutex_t mutex;
+  struct uv__work_list wq[UV_WORK_CLASS_MAX];
+  unsigned int total;  /* Read without the lock by thieves, as a hint. */
+  unsigned int next_class;
+  unsigned int index;
+};
+
+static int work_stealing;
+/* Allocated as threads are started and published with a CAS, never freed
+ * while the pool is running.
+ */
+static struct uv__ws_worker* volatile ws_workers[MAX_THREADPOOL_SIZE];
+static struct uv__work* volatile ws_inject[UV_WORK_CLASS_MAX];
+
+#if defined(_WIN32)
+static void* ws_cas_ptr(void* volatile* p, void* oldval, void* newval) {
+  return InterlockedCompareExchangePointer(p, newval, oldval);
+}
+
+static unsigned int ws_cas_uint(unsigned int* p,
+                                unsigned int oldval,
+                                unsigned int newval) {
+  return (unsigned int) InterlockedCompareExchange((volatile LONG*) p,
+                                                   (LONG) newval,
+                                                   (LONG) oldval);
+}
+#else
+static void* ws_cas_ptr(void* volatile* p, void* oldval, void* newval) {
+  return __sync_val_compare_and_swap(p, oldval, newval);
+}
+
+static unsigned int ws_cas_uint(unsigned int* p,
+                                unsigned int oldval,
+                                unsigned int newval) {
+  return __sync_val_compare_and_swap(p, oldval, newval);
+}
+#endif
+
+/* Returns the previous value. */
+static unsigned int ws_add_uint(unsigned int* p, int delta) {
+  unsigned int n;
+
+  do
+    n = *(volatile unsigned int*) p;
+  while (ws_cas_uint(p, n, n + delta) != n);
+
+  return n;
+}
+
+static unsigned int load_uint(const unsigned int* p) {
+  return *(const volatile unsigned int*) p;
+}
 
-static unsigned int slow_work_thread_threshold(void) {
-  return (nthreads + 1) / 2;
+static unsigned int class_thread_limit(const struct uv__work_class* c) {
+  unsigned int n;
+
+  n = load_uint(&nthreads);
+  if (c->share != 0)
+    return c->share < n ? c->share : n;
+
+  /* DNS lookups can block for a long time, don't let them take up more than
+   * half of the threads unless told otherwise.
+   */
+  if (c == &classes[UV_WORK_CLASS_DNS])
+    return (n + 1) / 2;
+
+  return n;
 }
 
 static void uv__cancelled(struct uv__work* w) {
@@ -51,106 +183,557 @@ static void uv__cancelled(struct uv__work* w) {
 }
 
 
+static void list_push(struct uv__work_list* l, struct uv__work* w) {
+  WORK_NEXT(w) = NULL;
+  if (l->tail == NULL)
+    l->head = w;
+  else
+    WORK_NEXT(l->tail) = w;
+  l->tail = w;
+  l->count++;
+}
+
+
+static struct uv__work* list_shift(struct uv__work_list* l) {
+  struct uv__work* w;
+
+  w = l->head;
+  l->head = WORK_NEXT(w);
+  if (l->head == NULL)
+    l->tail = NULL;
+  l->count--;
+
+  return w;
+}
+
+
+/* Moves all of `from` to the end of `to`. */
+static void list_concat(struct uv__work_list* to, struct uv__work_list* from) {
+  if (from->head == NULL)
+    return;
+
+  if (to->tail == NULL)
+    to->head = from->head;
+  else
+    WORK_NEXT(to->tail) = from->head;
+  to->tail = from->tail;
+  to->count += from->count;
+
+  from->head = NULL;
+  from->tail = NULL;
+  from->count = 0;
+}
+
+
+static int list_remove(struct uv__work_list* l, struct uv__work* w) {
+  struct uv__work* prev;
+  struct uv__work* cur;
+
+  for (prev = NULL, cur = l->head; cur != NULL; prev = cur, cur = WORK_NEXT(cur))
+    if (cur == w)
+      break;
+
+  if (cur == NULL)
+    return 0;
+
+  if (prev == NULL)
+    l->head = WORK_NEXT(cur);
+  else
+    WORK_NEXT(prev) = WORK_NEXT(cur);
+  if (l->tail == cur)
+    l->tail = prev;
+  l->count--;
+
+  return 1;
+}
+
+
+static void* now_stamp(void) {
+  return (void*) (uintptr_t) (uv_hrtime() / 1000);
+}
+
+
+static unsigned int histogram_bucket(uintptr_t usec) {
+  unsigned int i;
+
+  for (i = 0; usec > 1 && i < HISTOGRAM_BUCKETS - 1; i++)
+    usec >>= 1;
+
+  return i;
+}
+
+
+/* Runs `w` and hands it back to its loop. */
+static void run_work(struct uv__thread_stats* stats,
+                     struct uv__work_class* c,
+                     struct uv__work* w) {
+  uintptr_t started;
+  uintptr_t finished;
+  unsigned int i;
+
+  i = c - classes;
+  started = (uintptr_t) now_stamp();
+  stats->wait_time[i][histogram_bucket(started -
+                                       (uintptr_t) WORK_STAMP(w))]++;
+
+  w->work(w);
+
+  finished = (uintptr_t) now_stamp();
+  stats->run_time[i][histogram_bucket(finished - started)]++;
+  stats->completed[i]++;
+
+  uv_mutex_lock(&w->loop->wq_mutex);
+  w->work = NULL;  /* Signal uv_cancel() that the work req is done
+                      executing. */
+  QUEUE_INSERT_TAIL(&w->loop->wq, &w->wq);
+  uv_async_send(&w->loop->wq_async);
+  uv_mutex_unlock(&w->loop->wq_mutex);
+}
+
+
+/* Pick the next runnable class. Must be called with the global mutex held. */
+static struct uv__work_class* next_work_class(int advance) {
+  struct uv__work_class* best;
+  struct uv__work_class* c;
+  unsigned int i;
+
+  best = NULL;
+  for (i = 0; i < UV_WORK_CLASS_MAX; i++) {
+    c = &classes[(next_class + i) % UV_WORK_CLASS_MAX];
+    if (c->wq.head == NULL || c->running >= class_thread_limit(c))
+      continue;
+    if (best == NULL || c->priority > best->priority)
+      best = c;
+  }
+
+  if (best != NULL && advance)
+    next_class = (best - classes + 1) % UV_WORK_CLASS_MAX;
+
+  return best;
+}
+
+
 /* To avoid deadlock with uv_cancel() it's crucial that the worker
  * never holds the global mutex and the loop-local mutex at the same time.
  */
 static void worker(void* arg) {
+  struct uv__thread_stats* stats;
+  struct uv__work_class* c;
   struct uv__work* w;
-  QUEUE* q;
-  int is_slow_work;
+  unsigned int index;
 
-  uv_sem_post((uv_sem_t*) arg);
+  index = ((struct uv__worker_arg*) arg)->index;
+  stats = slots[index].stats;
+  uv_sem_post(((struct uv__worker_arg*) arg)->sem);
   arg = NULL;
+  c = NULL;
 
   for (;;) {
     uv_mutex_lock(&mutex);
 
-  wait_for_work:
-    /* Keep waiting while either no work is present or only slow I/O
-       and we're at the threshold for that. */
-    while (QUEUE_EMPTY(&wq) ||
-           (QUEUE_HEAD(&wq) == &run_slow_work_message &&
-            QUEUE_NEXT(&run_slow_work_message) == &wq &&
-            slow_io_work_running >= slow_work_thread_threshold())) {
+    if (c != NULL)
+      c->running--;
+
+    /* Keep waiting while there is no work that this thread is allowed to
+     * run, either because all queues are empty or because the classes that
+     * have pending work are at their thread limit.
+     */
+    c = NULL;
+    while (index < nthreads &&
+           (c = next_work_class(1)) == NULL &&
+           !exiting) {
       idle_threads += 1;
       uv_cond_wait(&cond, &mutex);
       idle_threads -= 1;
     }
 
-    q = QUEUE_HEAD(&wq);
-    if (q == &exit_message) {
-      uv_cond_signal(&cond);
+    if (c == NULL) {
+      /* Give the slot in the class limit that this thread held to a thread
+       * that stays.
+       */
+      if (idle_threads > 0 && next_work_class(0) != NULL)
+        uv_cond_signal(&cond);
+      slots[index].state = SLOT_EXITED;
       uv_mutex_unlock(&mutex);
       break;
     }
 
-    QUEUE_REMOVE(q);
-    QUEUE_INIT(q);  /* Signal uv_cancel() that the work req is executing. */
-
-    is_slow_work = 0;
-    if (q == &run_slow_work_message) {
-      /* If we're at the slow I/O threshold, re-schedule until after all
-         other work in the queue is done. */
-      if (slow_io_work_running >= slow_work_thread_threshold()) {
-        QUEUE_INSERT_TAIL(&wq, q);
-        goto wait_for_work;
-      }
+    w = list_shift(&c->wq);
+    c->queued--;
+    c->running++;
 
-      /* If we encountered a request to run slow I/O work but there is none
-         to run, that means it's cancelled => Start over. */
-      if (QUEUE_EMPTY(&slow_io_pending_wq))
-        goto wait_for_work;
+    /* The slot that this thread just gave up may have made work runnable
+     * that this thread didn't pick.
+     */
+    if (idle_threads > 0 && next_work_class(0) != NULL)
+      uv_cond_signal(&cond);
 
-      is_slow_work = 1;
-      slow_io_work_running++;
+    uv_mutex_unlock(&mutex);
 
-      q = QUEUE_HEAD(&slow_io_pending_wq);
-      QUEUE_REMOVE(q);
-      QUEUE_INIT(q);
+    run_work(stats, c, w);
+  }
+}
 
-      /* If there is more slow I/O work, schedule it to be run as well. */
-      if (!QUEUE_EMPTY(&slow_io_pending_wq)) {
-        QUEUE_INSERT_TAIL(&wq, &run_slow_work_message);
-        if (idle_threads > 0)
-          uv_cond_signal(&cond);
-      }
+
+static void post(struct uv__work* w, uv_work_class_t work_class) {
+  uv_mutex_lock(&mutex);
+  list_push(&classes[work_class].wq, w);
+  classes[work_class].queued++;
+  if (idle_threads > 0)
+    uv_cond_signal(&cond);
+  uv_mutex_unlock(&mutex);
+}
+
+
+/* Claims a thread slot of `c`, fails if the class is at its limit. */
+static int ws_class_acquire(struct uv__work_class* c) {
+  unsigned int n;
+
+  do {
+    n = load_uint(&c->running);
+    if (n >= class_thread_limit(c))
+      return 0;
+  } while (ws_cas_uint(&c->running, n, n + 1) != n);
+
+  return 1;
+}
+
+
+/* Moves everything from the injection stacks into the queues of `ws`, oldest
+ * request first. Must be called with `ws->mutex` held.
+ */
+static void ws_drain_injection(struct uv__ws_worker* ws) {
+  struct uv__work* top;
+  struct uv__work* rev;
+  struct uv__work* next;
+  unsigned int i;
+
+  for (i = 0; i < UV_WORK_CLASS_MAX; i++) {
+    do
+      top = ws_inject[i];
+    while (top != NULL &&
+           ws_cas_ptr((void* volatile*) &ws_inject[i], top, NULL) != top);
+
+    for (rev = NULL; top != NULL; top = next) {
+      next = WORK_NEXT(top);
+      WORK_NEXT(top) = rev;
+      rev = top;
     }
 
-    uv_mutex_unlock(&mutex);
+    for (; rev != NULL; rev = next) {
+      next = WORK_NEXT(rev);
+      list_push(&ws->wq[i], rev);
+      ws->total++;
+    }
+  }
+}
+
+
+/* Picks the class to run from the queues of `ws` and claims a thread slot
+ * for it. Must be called with `ws->mutex` held. Returns -1 if there is
+ * nothing that may run.
+ */
+static int ws_reserve(struct uv__ws_worker* ws) {
+  unsigned int skip;
+  unsigned int i;
+  int best;
+  int c;
 
-    w = QUEUE_DATA(q, struct uv__work, wq);
-    w->work(w);
-
-    uv_mutex_lock(&w->loop->wq_mutex);
-    if (is_slow_work)
-      slow_io_work_running--;
-    w->work = NULL;  /* Signal uv_cancel() that the work req is done
-                        executing. */
-    QUEUE_INSERT_TAIL(&w->loop->wq, &w->wq);
-    uv_async_send(&w->loop->wq_async);
-    uv_mutex_unlock(&w->loop->wq_mutex);
+  skip = 0;
+  for (;;) {
+    best = -1;
+    for (i = 0; i < UV_WORK_CLASS_MAX; i++) {
+      c = (ws->next_class + i) % UV_WORK_CLASS_MAX;
+      if (ws->wq[c].head == NULL || (skip & (1 << c)))
+        continue;
+      if (best == -1 || classes[c].priority > classes[best].priority)
+        best = c;
+    }
+
+    if (best == -1)
+      return -1;
+
+    if (ws_class_acquire(&classes[best])) {
+      ws->next_class = (best + 1) % UV_WORK_CLASS_MAX;
+      return best;
+    }
+
+    skip |= 1 << best;
   }
 }
 
 
-static void post(QUEUE* q, enum uv__work_kind kind) {
-  uv_mutex_lock(&mutex);
-  if (kind == UV__WORK_SLOW_IO) {
-    /* Insert into a separate queue. */
-    QUEUE_INSERT_TAIL(&slow_io_pending_wq, q);
-    if (!QUEUE_EMPTY(&run_slow_work_message)) {
-      /* Running slow I/O tasks is already scheduled => Nothing to do here.
-         The worker that runs said other task will schedule this one as well. */
+static struct uv__work* ws_pop(struct uv__ws_worker* ws, int c) {
+  ws->total--;
+  ws_add_uint(&classes[c].queued, -1);
+  return list_shift(&ws->wq[c]);
+}
+
+
+static void ws_lock_pair(struct uv__ws_worker* a, struct uv__ws_worker* b) {
+  if (a->index < b->index) {
+    uv_mutex_lock(&a->mutex);
+    uv_mutex_lock(&b->mutex);
+  } else {
+    uv_mutex_lock(&b->mutex);
+    uv_mutex_lock(&a->mutex);
+  }
+}
+
+
+/* Moves all requests queued on `from` to `to`. */
+static void ws_rehome(struct uv__ws_worker* to, struct uv__ws_worker* from) {
+  unsigned int c;
+
+  ws_lock_pair(to, from);
+  for (c = 0; c < UV_WORK_CLASS_MAX; c++)
+    list_concat(&to->wq[c], &from->wq[c]);
+  to->total += from->total;
+  from->total = 0;
+  uv_mutex_unlock(&from->mutex);
+  uv_mutex_unlock(&to->mutex);
+}
+
+
+/* Takes half of the runnable work of one class from another worker. */
+static struct uv__work* ws_steal(struct uv__ws_worker* self,
+                                 struct uv__work_class** cls) {
+  struct uv__ws_worker* victim;
+  struct uv__work* w;
+  unsigned int n;
+  unsigned int i;
+  int c;
+
+  n = load_uint(&nthreads);
+  for (i = 1; i < n; i++) {
+    victim = ws_workers[(self->index + i) % n];
+    if (victim == NULL || load_uint(&victim->total) == 0)
+      continue;
+
+    ws_lock_pair(self, victim);
+    c = ws_reserve(victim);
+    if (c == -1) {
+      uv_mutex_unlock(&victim->mutex);
+      uv_mutex_unlock(&self->mutex);
+      continue;
+    }
+
+    /* Run the oldest request and take half of the ones behind it along. */
+    w = ws_pop(victim, c);
+    for (n = (victim->wq[c].count + 1) / 2; n > 0; n--) {
+      list_push(&self->wq[c], list_shift(&victim->wq[c]));
+      victim->total--;
+      self->total++;
+    }
+
+    uv_mutex_unlock(&victim->mutex);
+    uv_mutex_unlock(&self->mutex);
+    *cls = &classes[c];
+    return w;
+  }
+
+  return NULL;
+}
+
+
+static struct uv__work* ws_next_work(struct uv__ws_worker* self,
+                                     struct uv__work_class** cls) {
+  struct uv__work* w;
+  int c;
+
+  w = NULL;
+  uv_mutex_lock(&self->mutex);
+  ws_drain_injection(self);
+  c = ws_reserve(self);
+  if (c != -1) {
+    w = ws_pop(self, c);
+    *cls = &classes[c];
+  }
+  uv_mutex_unlock(&self->mutex);
+
+  if (w == NULL)
+    w = ws_steal(self, cls);
+
+  return w;
+}
+
+
+static void ws_worker(void* arg) {
+  struct uv__thread_stats* stats;
+  struct uv__ws_worker* self;
+  struct uv__work_class* c;
+  struct uv__work* w;
+
+  self = ws_workers[((struct uv__worker_arg*) arg)->index];
+  stats = slots[self->index].stats;
+  uv_sem_post(((struct uv__worker_arg*) arg)->sem);
+  arg = NULL;
+  c = NULL;
+
+  for (;;) {
+    /* If the class was at its limit a sleeping thread may be able to run its
+     * queued work now.
+     */
+    if (c != NULL &&
+        ws_add_uint(&c->running, -1) >= class_thread_limit(c) &&
+        load_uint(&idle_threads) > 0) {
+      uv_mutex_lock(&mutex);
+      uv_cond_signal(&cond);
       uv_mutex_unlock(&mutex);
-      return;
     }
-    q = &run_slow_work_message;
+
+    w = NULL;
+    if (self->index < load_uint(&nthreads))
+      w = ws_next_work(self, &c);
+
+    if (w == NULL) {
+      /* ws_post() checks idle_threads after publishing its request, so after
+       * incrementing it the request is either seen here or a wakeup follows.
+       */
+      uv_mutex_lock(&mutex);
+      ws_add_uint(&idle_threads, 1);
+      while (self->index < nthreads &&
+             (w = ws_next_work(self, &c)) == NULL &&
+             !exiting) {
+        uv_cond_wait(&cond, &mutex);
+      }
+      ws_add_uint(&idle_threads, -1);
+
+      if (w == NULL) {
+        /* Leave the requests that are still queued here to the first
+         * worker, which never retires.
+         */
+        if (self->index != 0 && !exiting) {
+          ws_rehome(ws_workers[0], self);
+          uv_cond_broadcast(&cond);
+        }
+        slots[self->index].state = SLOT_EXITED;
+        uv_mutex_unlock(&mutex);
+        break;
+      }
+
+      uv_mutex_unlock(&mutex);
+    }
+
+    run_work(stats, c, w);
   }
+}
 
-  QUEUE_INSERT_TAIL(&wq, q);
-  if (idle_threads > 0)
+
+static void ws_post(struct uv__work* w, uv_work_class_t work_class) {
+  struct uv__work* top;
+
+  ws_add_uint(&classes[work_class].queued, 1);
+
+  do {
+    top = ws_inject[work_class];
+    WORK_NEXT(w) = top;
+  } while (ws_cas_ptr((void* volatile*) &ws_inject[work_class], top, w) != top);
+
+  if (load_uint(&idle_threads) > 0) {
+    uv_mutex_lock(&mutex);
     uv_cond_signal(&cond);
+    uv_mutex_unlock(&mutex);
+  }
+}
+
+
+/* Removes `w` if no worker has picked it up yet. Requests can move between
+ * the injection stacks and any of the worker queues, so hold every queue
+ * still while looking for it.
+ */
+static int ws_cancel(struct uv__work* w) {
+  struct uv__ws_worker* ws;
+  unsigned int i;
+  unsigned int c;
+  int cancelled;
+
+  uv_mutex_lock(&mutex);
+  for (i = 0; i < nslots; i++)
+    uv_mutex_lock(&ws_workers[i]->mutex);
+
+  ws_drain_injection(ws_workers[0]);
+
+  cancelled = 0;
+  for (i = 0; i < nslots && !cancelled; i++) {
+    ws = ws_workers[i];
+    for (c = 0; c < UV_WORK_CLASS_MAX && !cancelled; c++) {
+      if (list_remove(&ws->wq[c], w)) {
+        ws->total--;
+        ws_add_uint(&classes[c].queued, -1);
+        cancelled = 1;
+      }
+    }
+  }
+
+  for (i = nslots; i > 0; i--)
+    uv_mutex_unlock(&ws_workers[i - 1]->mutex);
   uv_mutex_unlock(&mutex);
+
+  return cancelled;
+}
+
+
+/* Starts the thread for slot `index`, unless the one that is already there
+ * has not retired yet. Must be called with the global mutex held.
+ */
+static int start_thread(unsigned int index) {
+  struct uv__worker_arg arg;
+  struct uv__thread_slot* slot;
+  struct uv__ws_worker* ws;
+  uv_sem_t sem;
+  unsigned int c;
+  int err;
+
+  slot = &slots[index];
+  if (slot->state == SLOT_RUNNING)
+    return 0;
+
+  if (slot->state == SLOT_EXITED) {
+    /* It has released the mutex for the last time, this won't block. */
+    if (uv_thread_join(&slot->thread))
+      abort();
+    slot->state = SLOT_UNUSED;
+  }
+
+  if (slot->stats == NULL) {
+    slot->stats = uv__calloc(1, sizeof(*slot->stats));
+    if (slot->stats == NULL)
+      return UV_ENOMEM;
+  }
+
+  if (work_stealing && ws_workers[index] == NULL) {
+    ws = uv__calloc(1, sizeof(*ws));
+    if (ws == NULL)
+      return UV_ENOMEM;
+    if (uv_mutex_init(&ws->mutex))
+      abort();
+    ws->index = index;
+    for (c = 0; c < UV_WORK_CLASS_MAX; c++)
+      ws->wq[c].head = ws->wq[c].tail = NULL;
+    /* Publish with a full barrier, thieves don't take the global mutex. */
+    ws_cas_ptr((void* volatile*) &ws_workers[index], NULL, ws);
+  }
+
+  if (uv_sem_init(&sem, 0))
+    abort();
+
+  arg.sem = &sem;
+  arg.index = index;
+  err = uv_thread_create(&slot->thread, work_stealing ? ws_worker : worker, &arg);
+  if (err == 0)
+    uv_sem_wait(&sem);
+
+  uv_sem_destroy(&sem);
+
+  if (err != 0)
+    return err;
+
+  slot->state = SLOT_RUNNING;
+  if (index >= nslots)
+    nslots = index + 1;
+
+  return 0;
 }
 
 
@@ -158,49 +741,74 @@ static void post(QUEUE* q, enum uv__work_kind kind) {
 UV_DESTRUCTOR(static void cleanup(void)) {
   unsigned int i;
 
-  if (nthreads == 0)
+  if (nslots == 0)
     return;
 
-  post(&exit_message, UV__WORK_CPU);
+  uv_mutex_lock(&mutex);
+  exiting = 1;
+  uv_cond_broadcast(&cond);
+  uv_mutex_unlock(&mutex);
+
+  for (i = 0; i < nslots; i++)
+    if (slots[i].state != SLOT_UNUSED)
+      if (uv_thread_join(&slots[i].thread))
+        abort();
 
-  for (i = 0; i < nthreads; i++)
-    if (uv_thread_join(threads + i))
-      abort();
+  for (i = 0; i < nslots; i++) {
+    slots[i].state = SLOT_UNUSED;
+    uv__free(slots[i].stats);
+    slots[i].stats = NULL;
 
-  if (threads != default_threads)
-    uv__free(threads);
+    if (ws_workers[i] != NULL) {
+      uv_mutex_destroy(&ws_workers[i]->mutex);
+      uv__free(ws_workers[i]);
+      ws_workers[i] = NULL;
+    }
+  }
 
   uv_mutex_destroy(&mutex);
   uv_cond_destroy(&cond);
 
-  threads = NULL;
   nthreads = 0;
+  nslots = 0;
 }
 #endif
 
 
+static void init_class(struct uv__work_class* c) {
+  char name[64];
+  const char* val;
+
+  c->wq.head = c->wq.tail = NULL;
+  c->wq.count = 0;
+  c->queued = 0;
+  c->running = 0;
+
+  snprintf(name, sizeof(name), "UV_THREADPOOL_%s_SHARE", c->name);
+  val = getenv(name);
+  if (val != NULL)
+    c->share = atoi(val);
+
+  snprintf(name, sizeof(name), "UV_THREADPOOL_%s_PRIORITY", c->name);
+  val = getenv(name);
+  if (val != NULL)
+    c->priority = atoi(val);
+}
+
+
 static void init_threads(void) {
+  unsigned int n;
   unsigned int i;
   const char* val;
-  uv_sem_t sem;
 
-  nthreads = ARRAY_SIZE(default_threads);
+  n = 4;
   val = getenv("UV_THREADPOOL_SIZE");
   if (val != NULL)
-    nthreads = atoi(val);
-  if (nthreads == 0)
-    nthreads = 1;
-  if (nthreads > MAX_THREADPOOL_SIZE)
-    nthreads = MAX_THREADPOOL_SIZE;
-
-  threads = default_threads;
-  if (nthreads > ARRAY_SIZE(default_threads)) {
-    threads = uv__malloc(nthreads * sizeof(threads[0]));
-    if (threads == NULL) {
-      nthreads = ARRAY_SIZE(default_threads);
-      threads = default_threads;
-    }
-  }
+    n = atoi(val);
+  if (n == 0)
+    n = 1;
+  if (n > MAX_THREADPOOL_SIZE)
+    n = MAX_THREADPOOL_SIZE;
 
   if (uv_cond_init(&cond))
     abort();
@@ -208,21 +816,41 @@ static void init_threads(void) {
   if (uv_mutex_init(&mutex))
     abort();
 
-  QUEUE_INIT(&wq);
-  QUEUE_INIT(&slow_io_pending_wq);
-  QUEUE_INIT(&run_slow_work_message);
+  exiting = 0;
+  next_class = 0;
+  idle_threads = 0;
+  for (i = 0; i < UV_WORK_CLASS_MAX; i++)
+    init_class(&classes[i]);
 
-  if (uv_sem_init(&sem, 0))
-    abort();
-
-  for (i = 0; i < nthreads; i++)
-    if (uv_thread_create(threads + i, worker, &sem))
-      abort();
+#if defined(UV_THREADPOOL_WORK_STEALING)
+  work_stealing = 1;
+#else
+  work_stealing = 0;
+#endif
+  val = getenv("UV_THREADPOOL_WORK_STEALING");
+  if (val != NULL)
+    work_stealing = atoi(val) != 0;
 
-  for (i = 0; i < nthreads; i++)
-    uv_sem_wait(&sem);
+  /* After a fork the threads are gone, and so is whatever they were doing.
+   * Their queues and statistics are simply dropped.
+   */
+  for (i = 0; i < nslots; i++) {
+    slots[i].state = SLOT_UNUSED;
+    if (slots[i].stats != NULL)
+      memset(slots[i].stats, 0, sizeof(*slots[i].stats));
+    uv__free(ws_workers[i]);
+    ws_workers[i] = NULL;
+  }
+  nslots = 0;
+  for (i = 0; i < UV_WORK_CLASS_MAX; i++)
+    ws_inject[i] = NULL;
 
-  uv_sem_destroy(&sem);
+  uv_mutex_lock(&mutex);
+  nthreads = n;
+  for (i = 0; i < n; i++)
+    if (start_thread(i))
+      abort();
+  uv_mutex_unlock(&mutex);
 }
 
 
@@ -249,29 +877,37 @@ static void init_once(void) {
 
 void uv__work_submit(uv_loop_t* loop,
                      struct uv__work* w,
-                     enum uv__work_kind kind,
+                     uv_work_class_t work_class,
                      void (*work)(struct uv__work* w),
                      void (*done)(struct uv__work* w, int status)) {
   uv_once(&once, init_once);
   w->loop = loop;
   w->work = work;
   w->done = done;
-  post(&w->wq, kind);
+  WORK_STAMP(w) = now_stamp();
+  if (work_stealing)
+    ws_post(w, work_class);
+  else
+    post(w, work_class);
 }
 
 
 static int uv__work_cancel(uv_loop_t* loop, uv_req_t* req, struct uv__work* w) {
+  unsigned int i;
   int cancelled;
 
-  uv_mutex_lock(&mutex);
-  uv_mutex_lock(&w->loop->wq_mutex);
-
-  cancelled = !QUEUE_EMPTY(&w->wq) && w->work != NULL;
-  if (cancelled)
-    QUEUE_REMOVE(&w->wq);
-
-  uv_mutex_unlock(&w->loop->wq_mutex);
-  uv_mutex_unlock(&mutex);
+  if (work_stealing) {
+    cancelled = ws_cancel(w);
+  } else {
+    cancelled = 0;
+    uv_mutex_lock(&mutex);
+    for (i = 0; i < UV_WORK_CLASS_MAX && !cancelled; i++) {
+      cancelled = list_remove(&classes[i].wq, w);
+      if (cancelled)
+        classes[i].queued--;
+    }
+    uv_mutex_unlock(&mutex);
+  }
 
   if (!cancelled)
     return UV_EBUSY;
@@ -333,22 +969,155 @@ int uv_queue_work(uv_loop_t* loop,
                   uv_work_t* req,
                   uv_work_cb work_cb,
                   uv_after_work_cb after_work_cb) {
+  return uv_queue_work_ex(loop,
+                          req,
+                          UV_WORK_CLASS_USER,
+                          work_cb,
+                          after_work_cb);
+}
+
+
+int uv_queue_work_ex(uv_loop_t* loop,
+                     uv_work_t* req,
+                     uv_work_class_t work_class,
+                     uv_work_cb work_cb,
+                     uv_after_work_cb after_work_cb) {
   if (work_cb == NULL)
     return UV_EINVAL;
 
+  if ((unsigned int) work_class >= UV_WORK_CLASS_MAX)
+    return UV_EINVAL;
+
   uv__req_init(loop, req, UV_WORK);
   req->loop = loop;
   req->work_cb = work_cb;
   req->after_work_cb = after_work_cb;
   uv__work_submit(loop,
                   &req->work_req,
-                  UV__WORK_CPU,
+                  work_class,
                   uv__queue_work,
                   uv__queue_done);
   return 0;
 }
 
 
+int uv_threadpool_set_class(uv_work_class_t work_class,
+                            unsigned int share,
+                            int priority) {
+  if ((unsigned int) work_class >= UV_WORK_CLASS_MAX)
+    return UV_EINVAL;
+
+  if (share > MAX_THREADPOOL_SIZE)
+    return UV_EINVAL;
+
+  uv_once(&once, init_once);
+  uv_mutex_lock(&mutex);
+  classes[work_class].share = share;
+  classes[work_class].priority = priority;
+  /* A larger share can make queued work runnable. */
+  if (idle_threads > 0)
+    uv_cond_broadcast(&cond);
+  uv_mutex_unlock(&mutex);
+
+  return 0;
+}
+
+
+int uv_threadpool_get_class(uv_work_class_t work_class,
+                            unsigned int* share,
+                            int* priority) {
+  if ((unsigned int) work_class >= UV_WORK_CLASS_MAX)
+    return UV_EINVAL;
+
+  uv_once(&once, init_once);
+  uv_mutex_lock(&mutex);
+  if (share != NULL)
+    *share = class_thread_limit(&classes[work_class]);
+  if (priority != NULL)
+    *priority = classes[work_class].priority;
+  uv_mutex_unlock(&mutex);
+
+  return 0;
+}
+
+
+int uv_threadpool_set_size(unsigned int size) {
+  unsigned int i;
+  int err;
+
+  if (size == 0 || size > MAX_THREADPOOL_SIZE)
+    return UV_EINVAL;
+
+  uv_once(&once, init_once);
+  uv_mutex_lock(&mutex);
+
+  /* Threads above the new size retire once they are done with their current
+   * request; threads that were asked to retire but haven't yet are simply
+   * kept.
+   */
+  err = 0;
+  for (i = nthreads; i < size; i++) {
+    err = start_thread(i);
+    if (err != 0) {
+      size = i;
+      break;
+    }
+  }
+
+  nthreads = size;
+  uv_cond_broadcast(&cond);
+  uv_mutex_unlock(&mutex);
+
+  return err;
+}
+
+
+unsigned int uv_threadpool_get_size(void) {
+  uv_once(&once, init_once);
+  return load_uint(&nthreads);
+}
+
+
+int uv_threadpool_get_stats(uv_threadpool_stats_t* stats) {
+  uv_threadpool_class_stats_t* cs;
+  struct uv__thread_stats* ts;
+  unsigned int i;
+  unsigned int c;
+  unsigned int b;
+
+  if (stats == NULL)
+    return UV_EINVAL;
+
+  uv_once(&once, init_once);
+  memset(stats, 0, sizeof(*stats));
+
+  /* The per-thread counters are updated without a lock, the numbers are a
+   * snapshot that can be off by the requests completing right now.
+   */
+  uv_mutex_lock(&mutex);
+  stats->size = nthreads;
+  stats->idle = load_uint(&idle_threads);
+  for (c = 0; c < UV_WORK_CLASS_MAX; c++) {
+    cs = &stats->classes[c];
+    cs->queued = load_uint(&classes[c].queued);
+    cs->running = load_uint(&classes[c].running);
+    for (i = 0; i < nslots; i++) {
+      ts = slots[i].stats;
+      if (ts == NULL)
+        continue;
+      cs->completed += ts->completed[c];
+      for (b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        cs->wait_time[b] += ts->wait_time[c][b];
+        cs->run_time[b] += ts->run_time[c][b];
+      }
+    }
+  }
+  uv_mutex_unlock(&mutex);
+
+  return 0;
+}
+
+
 int uv_cancel(uv_req_t* req) {
   struct uv__work* wreq;
   uv_loop_t* loop;
@@ -357,6 +1126,11 @@ int uv_cancel(uv_req_t* req) {
   case UV_FS:
     loop =  ((uv_fs_t*) req)->loop;
     wreq = &((uv_fs_t*) req)->work_req;
+#if defined(__linux__)
+    /* Requests that went through io_uring never entered the queues. */
+    if (wreq->work == NULL)
+      return uv__io_uring_fs_cancel(loop, (uv_fs_t*) req);
+#endif
     break;
   case UV_GETADDRINFO:
     loop =  ((uv_getaddrinfo_t*) req)->loop;
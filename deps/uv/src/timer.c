@@ -25,6 +25,29 @@
 #include <assert.h>
 #include <limits.h>
 
+/* The timing wheel that replaces the heap when a loop is configured with
+ * UV_LOOP_TIMER_WHEEL. Level n has WHEEL_SLOTS slots that each cover
+ * WHEEL_SLOTS^n milliseconds. A timer goes in the lowest level in which its
+ * due time and the wheel's current time fall in the same window of
+ * WHEEL_SLOTS slots, so level 0 holds the timers that are due in the current
+ * window, one slot per millisecond, and timers further out move down a level
+ * ("cascade") once the wheel reaches the start of their slot. Starting and
+ * stopping a timer is O(1); finding the next slot that is due is O(levels)
+ * thanks to a bitmap of occupied slots per level.
+ *
+ * A timer lives on the doubly linked list of its slot; heap_node[0..1] is the
+ * list link and heap_node[2] points to the slot it is on.
+ */
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_LEVELS 8  /* 2^48 milliseconds, almost 9,000 years. */
+
+struct uv__timer_wheel {
+  uint64_t elapsed;  /* The time up to which the wheel has been processed. */
+  uint64_t occupied[WHEEL_LEVELS];
+  QUEUE slots[WHEEL_LEVELS][WHEEL_SLOTS];
+};
+
 
 static struct heap *timer_heap(const uv_loop_t* loop) {
 #ifdef _WIN32
@@ -60,6 +83,145 @@ static int timer_less_than(const struct heap_node* ha,
 }
 
 
+static struct uv__timer_wheel* timer_wheel(const uv_loop_t* loop) {
+  return (struct uv__timer_wheel*) loop->timer_wheel;
+}
+
+
+static QUEUE* timer_link(uv_timer_t* handle) {
+  return (QUEUE*) &handle->heap_node[0];
+}
+
+
+static void wheel_insert(struct uv__timer_wheel* wheel, uv_timer_t* handle) {
+  uint64_t diff;
+  unsigned int level;
+  unsigned int slot;
+  QUEUE* head;
+
+  level = 0;
+  diff = (wheel->elapsed ^ handle->timeout) >> WHEEL_BITS;
+  while (diff != 0 && level < WHEEL_LEVELS - 1) {
+    diff >>= WHEEL_BITS;
+    level++;
+  }
+
+  if (diff != 0) {
+    /* Too far out for the wheel. Park it in the top level slot that comes up
+     * last; it is inserted again from there, closer to its due time.
+     */
+    slot = (wheel->elapsed >> (level * WHEEL_BITS)) - 1;
+  } else {
+    slot = handle->timeout >> (level * WHEEL_BITS);
+  }
+  slot &= WHEEL_SLOTS - 1;
+
+  head = &wheel->slots[level][slot];
+  QUEUE_INSERT_TAIL(head, timer_link(handle));
+  handle->heap_node[2] = head;
+  wheel->occupied[level] |= (uint64_t) 1 << slot;
+}
+
+
+static void wheel_remove(struct uv__timer_wheel* wheel, uv_timer_t* handle) {
+  unsigned int index;
+  QUEUE* head;
+
+  head = handle->heap_node[2];
+  QUEUE_REMOVE(timer_link(handle));
+
+  if (QUEUE_EMPTY(head)) {
+    index = head - &wheel->slots[0][0];
+    wheel->occupied[index / WHEEL_SLOTS] &=
+        ~((uint64_t) 1 << (index % WHEEL_SLOTS));
+  }
+}
+
+
+/* Finds the first occupied slot at or after the wheel's current position, in
+ * the lowest level that has any. Timers in lower levels are always due before
+ * those in higher ones. For level 0 the deadline is when the timers in the
+ * slot are due, for higher levels it is when they have to cascade.
+ */
+static int wheel_next(const struct uv__timer_wheel* wheel,
+                      unsigned int* plevel,
+                      unsigned int* pslot,
+                      uint64_t* pdeadline) {
+  uint64_t occupied;
+  uint64_t deadline;
+  unsigned int level;
+  unsigned int shift;
+  unsigned int now;
+  unsigned int slot;
+
+  for (level = 0; level < WHEEL_LEVELS; level++) {
+    occupied = wheel->occupied[level];
+    if (occupied == 0)
+      continue;
+
+    shift = level * WHEEL_BITS;
+    now = (wheel->elapsed >> shift) & (WHEEL_SLOTS - 1);
+
+    /* Rotate the bitmap so that the current slot is bit 0. */
+    if (now != 0)
+      occupied = (occupied >> now) | (occupied << (WHEEL_SLOTS - now));
+    for (slot = 0; (occupied & 1) == 0; slot++)
+      occupied >>= 1;
+    slot = (slot + now) & (WHEEL_SLOTS - 1);
+
+    deadline = wheel->elapsed >> (shift + WHEEL_BITS) << (shift + WHEEL_BITS);
+    deadline += (uint64_t) slot << shift;
+    if (slot < now)
+      deadline += (uint64_t) 1 << (shift + WHEEL_BITS);  /* Wrapped around. */
+
+    *plevel = level;
+    *pslot = slot;
+    *pdeadline = deadline;
+    return 1;
+  }
+
+  return 0;
+}
+
+
+int uv__timer_wheel_init(uv_loop_t* loop) {
+  struct uv__timer_wheel* wheel;
+  struct heap_node* heap_node;
+  uv_timer_t* handle;
+  unsigned int level;
+  unsigned int slot;
+
+  if (loop->timer_wheel != NULL)
+    return 0;
+
+  wheel = uv__malloc(sizeof(*wheel));
+  if (wheel == NULL)
+    return UV_ENOMEM;
+
+  wheel->elapsed = loop->time;
+  for (level = 0; level < WHEEL_LEVELS; level++) {
+    wheel->occupied[level] = 0;
+    for (slot = 0; slot < WHEEL_SLOTS; slot++)
+      QUEUE_INIT(&wheel->slots[level][slot]);
+  }
+
+  /* Move over the timers that are already running. They come off the heap in
+   * the order in which they are due, so timers with the same due time stay
+   * in the order in which they were started.
+   */
+  while ((heap_node = heap_min(timer_heap(loop))) != NULL) {
+    handle = container_of(heap_node, uv_timer_t, heap_node);
+    heap_remove(timer_heap(loop), heap_node, timer_less_than);
+    if (handle->timeout < wheel->elapsed)
+      handle->timeout = wheel->elapsed;
+    wheel_insert(wheel, handle);
+  }
+
+  loop->timer_wheel = wheel;
+  return 0;
+}
+
+
 int uv_timer_init(uv_loop_t* loop, uv_timer_t* handle) {
   uv__handle_init(loop, (uv_handle_t*)handle, UV_TIMER);
   handle->timer_cb = NULL;
@@ -90,9 +252,12 @@ int uv_timer_start(uv_timer_t* handle,
   /* start_id is the second index to be compared in uv__timer_cmp() */
   handle->start_id = handle->loop->timer_counter++;
 
-  heap_insert(timer_heap(handle->loop),
-              (struct heap_node*) &handle->heap_node,
-              timer_less_than);
+  if (timer_wheel(handle->loop) != NULL)
+    wheel_insert(timer_wheel(handle->loop), handle);
+  else
+    heap_insert(timer_heap(handle->loop),
+                (struct heap_node*) &handle->heap_node,
+                timer_less_than);
   uv__handle_start(handle);
 
   return 0;
@@ -103,9 +268,12 @@ int uv_timer_stop(uv_timer_t* handle) {
   if (!uv__is_active(handle))
     return 0;
 
-  heap_remove(timer_heap(handle->loop),
-              (struct heap_node*) &handle->heap_node,
-              timer_less_than);
+  if (timer_wheel(handle->loop) != NULL)
+    wheel_remove(timer_wheel(handle->loop), handle);
+  else
+    heap_remove(timer_heap(handle->loop),
+                (struct heap_node*) &handle->heap_node,
+                timer_less_than);
   uv__handle_stop(handle);
 
   return 0;
@@ -135,11 +303,37 @@ uint64_t uv_timer_get_repeat(const uv_timer_t* handle) {
 }
 
 
+static int uv__next_timeout_wheel(const uv_loop_t* loop) {
+  unsigned int level;
+  unsigned int slot;
+  uint64_t deadline;
+  uint64_t diff;
+
+  /* This can wake up the loop before a timer is due, when timers have to
+   * cascade down a level. That happens at most once per level per timer.
+   */
+  if (!wheel_next(timer_wheel(loop), &level, &slot, &deadline))
+    return -1; /* block indefinitely */
+
+  if (deadline <= loop->time)
+    return 0;
+
+  diff = deadline - loop->time;
+  if (diff > INT_MAX)
+    diff = INT_MAX;
+
+  return diff;
+}
+
+
 int uv__next_timeout(const uv_loop_t* loop) {
   const struct heap_node* heap_node;
   const uv_timer_t* handle;
   uint64_t diff;
 
+  if (timer_wheel(loop) != NULL)
+    return uv__next_timeout_wheel(loop);
+
   heap_node = heap_min(timer_heap(loop));
   if (heap_node == NULL)
     return -1; /* block indefinitely */
@@ -156,10 +350,58 @@ int uv__next_timeout(const uv_loop_t* loop) {
 }
 
 
+static void uv__run_timers_wheel(uv_loop_t* loop) {
+  struct uv__timer_wheel* wheel;
+  unsigned int level;
+  unsigned int slot;
+  uint64_t deadline;
+  uv_timer_t* handle;
+  QUEUE* head;
+  QUEUE* q;
+  QUEUE queue;
+
+  wheel = timer_wheel(loop);
+
+  while (wheel_next(wheel, &level, &slot, &deadline) &&
+         deadline <= loop->time) {
+    wheel->elapsed = deadline;
+    head = &wheel->slots[level][slot];
+
+    if (level > 0) {
+      /* Cascade. Everything in the slot now goes in a lower level. */
+      QUEUE_MOVE(head, &queue);
+      wheel->occupied[level] &= ~((uint64_t) 1 << slot);
+      while (!QUEUE_EMPTY(&queue)) {
+        q = QUEUE_HEAD(&queue);
+        QUEUE_REMOVE(q);
+        wheel_insert(wheel, container_of(q, uv_timer_t, heap_node[0]));
+      }
+      continue;
+    }
+
+    /* Take the timers one at a time, a callback can stop the others. */
+    while (!QUEUE_EMPTY(head)) {
+      q = QUEUE_HEAD(head);
+      handle = container_of(q, uv_timer_t, heap_node[0]);
+      uv_timer_stop(handle);
+      uv_timer_again(handle);
+      handle->timer_cb(handle);
+    }
+  }
+
+  wheel->elapsed = loop->time;
+}
+
+
 void uv__run_timers(uv_loop_t* loop) {
   struct heap_node* heap_node;
   uv_timer_t* handle;
 
+  if (timer_wheel(loop) != NULL) {
+    uv__run_timers_wheel(loop);
+    return;
+  }
+
   for (;;) {
     heap_node = heap_min(timer_heap(loop));
     if (heap_node == NULL)
@@ -119,13 +119,24 @@
   }                                                                           \
   while (0)
 
+static int uv__fs_io_uring_submit(uv_loop_t* loop, uv_fs_t* req) {
+#if defined(__linux__)
+  return uv__io_uring_fs_submit(loop, req);
+#else
+  return 0;
+#endif
+}
+
+
 #define POST                                                                  \
   do {                                                                        \
     if (cb != NULL) {                                                         \
       uv__req_register(loop, req);                                            \
+      if (uv__fs_io_uring_submit(loop, req))                                  \
+        return 0;                                                             \
       uv__work_submit(loop,                                                   \
                       &req->work_req,                                         \
-                      UV__WORK_FAST_IO,                                       \
+                      UV_WORK_CLASS_FS,                                       \
                       uv__fs_work,                                            \
                       uv__fs_done);                                           \
       return 0;                                                               \
@@ -802,7 +813,11 @@ static ssize_t uv__fs_copyfile(uv_fs_t* req) {
 #endif
   }
 
-  return copyfile(req->path, req->new_path, NULL, flags);
+  if (copyfile(req->path, req->new_path, NULL, flags))
+    return -1;
+
+  req->mode = UV_FS_COPYFILE_METHOD_SYSTEM;
+  return 0;
 #else
   uv_fs_t fs_req;
   uv_file srcfd;
@@ -813,6 +828,9 @@ static ssize_t uv__fs_copyfile(uv_fs_t* req) {
   int err;
   size_t bytes_to_send;
   int64_t in_offset;
+#if defined(__linux__)
+  ssize_t bytes_copied;
+#endif
 
   dstfd = -1;
   err = 0;
@@ -869,6 +887,7 @@ static ssize_t uv__fs_copyfile(uv_fs_t* req) {
         goto out;
       }
     } else {
+      req->mode = UV_FS_COPYFILE_METHOD_CLONE;
       goto out;
     }
   }
@@ -881,6 +900,61 @@ static ssize_t uv__fs_copyfile(uv_fs_t* req) {
 
   bytes_to_send = statsbuf.st_size;
   in_offset = 0;
+
+  if (bytes_to_send == 0) {
+    req->mode = UV_FS_COPYFILE_METHOD_NONE;
+    goto out;
+  }
+
+#if defined(__linux__)
+  /* copy_file_range() never moves the data through user space and lets the
+   * filesystem share extents or do a server-side copy where it can. Anything
+   * it can't handle is left to the sendfile() loop below.
+   */
+  req->mode = UV_FS_COPYFILE_METHOD_COPY_FILE_RANGE;
+  while (bytes_to_send != 0) {
+    bytes_copied = uv__copy_file_range(srcfd,
+                                       &in_offset,
+                                       dstfd,
+                                       NULL,
+                                       bytes_to_send,
+                                       0);
+    if (bytes_copied == -1) {
+      if (errno == EINTR)
+        continue;
+
+      /* ENOSYS: kernel < 4.5. EXDEV: cross-filesystem copy on kernel < 5.3.
+       * EINVAL/EOPNOTSUPP: the filesystem doesn't support it. EPERM: blocked
+       * by a seccomp filter. Anything else is a real error.
+       */
+      if (errno != ENOSYS &&
+          errno != EXDEV &&
+          errno != EINVAL &&
+          errno != EOPNOTSUPP &&
+          errno != EPERM) {
+        err = UV__ERR(errno);
+        goto out;
+      }
+
+      break;
+    }
+
+    /* Some pseudo filesystems report EOF early, let sendfile() have a go. */
+    if (bytes_copied == 0)
+      break;
+
+    bytes_to_send -= bytes_copied;
+  }
+
+  if (bytes_to_send == 0)
+    goto out;
+#endif
+
+  /* in_offset is only non-zero if copy_file_range() stopped part way. */
+  if (in_offset == 0)
+    req->mode = UV_FS_COPYFILE_METHOD_SENDFILE;
+  else
+    req->mode = UV_FS_COPYFILE_METHOD_COPY_FILE_RANGE_SENDFILE;
   while (bytes_to_send != 0) {
     err = uv_fs_sendfile(NULL,
                          &fs_req,
@@ -1474,6 +1548,14 @@ int uv_fs_symlink(uv_loop_t* loop,
 }
 
 
+uv_fs_copyfile_method uv_fs_get_copyfile_method(const uv_fs_t* req) {
+  if (req->fs_type != UV_FS_COPYFILE || req->result != 0)
+    return UV_FS_COPYFILE_METHOD_UNKNOWN;
+
+  return (uv_fs_copyfile_method) req->mode;
+}
+
+
 int uv_fs_unlink(uv_loop_t* loop, uv_fs_t* req, const char* path, uv_fs_cb cb) {
   INIT(UNLINK);
   PATH;
@@ -1568,5 +1650,6 @@ int uv_fs_copyfile(uv_loop_t* loop,
 
   PATH2;
   req->flags = flags;
+  req->mode = UV_FS_COPYFILE_METHOD_UNKNOWN;
   POST;
 }
@@ -186,7 +186,7 @@ int uv_getaddrinfo(uv_loop_t* loop,
   if (cb) {
     uv__work_submit(loop,
                     &req->work_req,
-                    UV__WORK_SLOW_IO,
+                    UV_WORK_CLASS_DNS,
                     uv__getaddrinfo_work,
                     uv__getaddrinfo_done);
     return 0;
@@ -249,6 +249,16 @@ int uv__platform_loop_init(uv_loop_t* loop);
 void uv__platform_loop_delete(uv_loop_t* loop);
 void uv__platform_invalidate_fd(uv_loop_t* loop, int fd);
 
+#if defined(__linux__)
+void uv__io_uring_init(uv_loop_t* loop);
+void uv__io_uring_delete(uv_loop_t* loop);
+void uv__io_uring_fork(uv_loop_t* loop, void* ring);
+void uv__io_uring_flush(uv_loop_t* loop);
+int uv__io_uring_fs_submit(uv_loop_t* loop, uv_fs_t* req);
+int uv__io_uring_fs_cancel(uv_loop_t* loop, uv_fs_t* req);
+void uv__busy_poll_socket(uv_loop_t* loop, int fd);
+#endif
+
 /* various */
 void uv__async_close(uv_async_t* handle);
 void uv__check_close(uv_check_t* handle);
@@ -211,12 +211,14 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
     if (pset != NULL)
       pthread_sigmask(SIG_BLOCK, pset, NULL);
 
+    uv__metrics_poll_enter(loop);
     nfds = kevent(loop->backend_fd,
                   events,
                   nevents,
                   events,
                   ARRAY_SIZE(events),
                   timeout == -1 ? NULL : &spec);
+    SAVE_ERRNO(uv__metrics_poll_exit(loop));
 
     if (pset != NULL)
       pthread_sigmask(SIG_UNBLOCK, pset, NULL);
@@ -26,6 +26,7 @@
 #include "uv.h"
 #include "internal.h"
 
+#include <limits.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -109,6 +110,10 @@ int uv__platform_loop_init(uv_loop_t* loop) {
   if (fd == -1)
     return UV__ERR(errno);
 
+#if defined(__linux__)
+  uv__io_uring_init(loop);
+#endif
+
   return 0;
 }
 
@@ -116,6 +121,13 @@ int uv__platform_loop_init(uv_loop_t* loop) {
 int uv__io_fork(uv_loop_t* loop) {
   int err;
   void* old_watchers;
+#if defined(__linux__)
+  void* old_ring;
+
+  /* Handed to uv__io_uring_fork() below, it has requests to cancel. */
+  old_ring = loop->io_uring;
+  loop->io_uring = NULL;
+#endif
 
   old_watchers = loop->inotify_watchers;
 
@@ -124,6 +136,9 @@ int uv__io_fork(uv_loop_t* loop) {
   uv__platform_loop_delete(loop);
 
   err = uv__platform_loop_init(loop);
+#if defined(__linux__)
+  uv__io_uring_fork(loop, old_ring);
+#endif
   if (err)
     return err;
 
@@ -132,6 +147,9 @@ int uv__io_fork(uv_loop_t* loop) {
 
 
 void uv__platform_loop_delete(uv_loop_t* loop) {
+#if defined(__linux__)
+  uv__io_uring_delete(loop);
+#endif
   if (loop->inotify_fd == -1) return;
   uv__io_stop(loop, &loop->inotify_read_watcher, POLLIN);
   uv__close(loop->inotify_fd);
@@ -190,6 +208,71 @@ int uv__io_check_fd(uv_loop_t* loop, int fd) {
 }
 
 
+#if defined(__linux__)
+/* Spins on non-blocking epoll_pwait() calls until events arrive or the busy
+ * poll budget of the loop runs out, whichever comes first. Returns the result
+ * of the last call, i.e. 0 if the budget ran out.
+ */
+static int uv__busy_poll(uv_loop_t* loop,
+                         struct epoll_event* events,
+                         int maxevents,
+                         int timeout,
+                         sigset_t* psigset) {
+  uint64_t deadline;
+  uint64_t budget;
+  int nfds;
+
+  budget = (uint64_t) loop->busy_poll.budget * 1000;
+  if (timeout > 0 && budget > (uint64_t) timeout * 1000000)
+    budget = (uint64_t) timeout * 1000000;
+
+  /* UV_CLOCK_FAST may be a coarse clock with a millisecond resolution, too
+   * coarse for budgets that are measured in microseconds.
+   */
+  deadline = uv__hrtime(UV_CLOCK_PRECISE) + budget;
+
+  do {
+    nfds = epoll_pwait(loop->backend_fd, events, maxevents, 0, psigset);
+    loop->busy_poll.polls++;
+    if (nfds != 0)
+      break;
+  } while (uv__hrtime(UV_CLOCK_PRECISE) < deadline);
+
+  if (nfds == 0)
+    loop->busy_poll.blocks++;
+  else if (nfds > 0)
+    loop->busy_poll.hits++;
+
+  return nfds;
+}
+
+
+int uv_loop_busy_poll_stats(const uv_loop_t* loop,
+                            uv_busy_poll_stats_t* stats) {
+  stats->budget = loop->busy_poll.budget;
+  stats->polls = loop->busy_poll.polls;
+  stats->hits = loop->busy_poll.hits;
+  stats->blocks = loop->busy_poll.blocks;
+  return 0;
+}
+
+
+void uv__busy_poll_socket(uv_loop_t* loop, int fd) {
+#if defined(SO_BUSY_POLL)
+  int usec;
+
+  if (loop->busy_poll.budget == 0)
+    return;
+
+  usec = loop->busy_poll.budget > INT_MAX ? INT_MAX : loop->busy_poll.budget;
+
+  /* Best effort. Going above net.core.busy_read requires CAP_NET_ADMIN. */
+  setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec));
+#endif
+}
+#endif
+
+
 void uv__io_poll(uv_loop_t* loop, int timeout) {
   /* A bug in kernels < 2.6.37 makes timeouts larger than ~30 minutes
    * effectively infinite on 32 bits architectures.  To avoid blocking
@@ -212,11 +295,25 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
   int have_signals;
   int nevents;
   int count;
+#if defined(__linux__)
+  int spin;
+#endif
   int nfds;
   int fd;
   int op;
   int i;
 
+#if defined(__linux__)
+  /* Hand the file system requests queued since the last iteration to the
+   * kernel before we go to sleep.
+   */
+  uv__io_uring_flush(loop);
+
+  /* Requests that failed to submit complete from the pending queue. */
+  if (!QUEUE_EMPTY(&loop->pending_queue))
+    timeout = 0;
+#endif
+
   if (loop->nfds == 0) {
     assert(QUEUE_EMPTY(&loop->watcher_queue));
     return;
@@ -268,6 +365,9 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
   base = loop->time;
   count = 48; /* Benchmarks suggest this gives the best throughput. */
   real_timeout = timeout;
+#if defined(__linux__)
+  spin = loop->busy_poll.budget != 0;
+#endif
 
   for (;;) {
     /* See the comment for max_safe_timeout for an explanation of why
@@ -276,11 +376,34 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
     if (sizeof(int32_t) == sizeof(long) && timeout >= max_safe_timeout)
       timeout = max_safe_timeout;
 
-    nfds = epoll_pwait(loop->backend_fd,
-                       events,
-                       ARRAY_SIZE(events),
-                       timeout,
-                       psigset);
+    uv__metrics_poll_enter(loop);
+
+    /* Busy poll first, so that events which arrive shortly don't have to pay
+     * for putting the thread to sleep and waking it up again. Only once per
+     * call, a loop that had to block once is likely to have to block again.
+     */
+    nfds = 0;
+#if defined(__linux__)
+    if (spin && timeout != 0) {
+      spin = 0;
+      nfds = uv__busy_poll(loop, events, ARRAY_SIZE(events), timeout, psigset);
+
+      if (nfds == 0 && timeout > 0) {
+        uv__update_time(loop);
+        timeout = real_timeout - (int) (loop->time - base);
+        if (timeout < 0)
+          timeout = 0;
+      }
+    }
+#endif
+
+    if (nfds == 0)
+      nfds = epoll_pwait(loop->backend_fd,
+                         events,
+                         ARRAY_SIZE(events),
+                         timeout,
+                         psigset);
+    SAVE_ERRNO(uv__metrics_poll_exit(loop));
 
     /* Update loop->time unconditionally. It's tempting to skip the update when
      * timeout == 0 (i.e. non-blocking poll) but there is no guarantee that the
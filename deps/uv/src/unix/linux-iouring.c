@@ -0,0 +1,690 @@
+/* Copyright libuv project contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/* io_uring submission path for file system requests.
+ *
+ * When enabled with UV_USE_IO_URING=1, every loop owns a ring.  Supported
+ * uv_fs_*() requests are queued in the submission ring instead of being
+ * handed to the threadpool, the pending entries are submitted in one go
+ * right before the loop polls for I/O and the completions are reaped from
+ * uv__io_poll() through a watcher on the ring's file descriptor.
+ *
+ * Everything that can't go through the ring (unsupported kernel or opcode,
+ * full ring, too many iovecs) silently takes the threadpool path.
+ *
+ * Requests that the kernel never gets to see (the submission failed, the
+ * process forked while they were in flight) are completed from the loop's
+ * pending queue instead, so that their callbacks still run from uv_run().
+ */
+
+#include "uv.h"
+#include "internal.h"
+
+/* Haiku builds the Linux sources too, but has neither io_uring nor its
+ * callers in fs.c, threadpool.c and linux-core.c.
+ */
+#if defined(__linux__)
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/mman.h>
+#include <sys/sysmacros.h>
+
+#define UV__IO_URING_ENTRIES 128
+
+struct uv__io_uring {
+  uv__io_t watcher;
+  uv__io_t done_watcher;
+  QUEUE reqs;  /* Requests in the ring, linked through work_req.wq. */
+  QUEUE done;  /* Requests waiting for done_watcher, result in req->result. */
+  int ringfd;  /* -1 after a fork left the child without a ring. */
+  uint32_t features;
+  uint32_t in_flight;
+  uint32_t* sqhead;
+  uint32_t* sqtail;
+  uint32_t sqmask;
+  uint32_t sqentries;
+  uint32_t* cqhead;
+  uint32_t* cqtail;
+  uint32_t cqmask;
+  uint32_t cqentries;
+  struct uv__io_uring_sqe* sqe;
+  struct uv__io_uring_cqe* cqe;
+  void* ring;
+  size_t ringlen;
+  size_t sqelen;
+  unsigned char ops[UV__IORING_OP_LAST];
+};
+
+
+/* uv_cancel() turns an entry that hasn't been submitted yet into a no-op and
+ * sets the low bit of its user_data, requests are at least 2-byte aligned.
+ */
+#define UV__IO_URING_CANCELED ((uintptr_t) 1)
+
+
+static uint32_t uv__io_uring_load(const uint32_t* p) {
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+
+static void uv__io_uring_store(uint32_t* p, uint32_t val) {
+  __atomic_store_n(p, val, __ATOMIC_RELEASE);
+}
+
+
+static void uv__io_uring_statx_to_stat(const struct uv__statx* src,
+                                       uv_stat_t* dst) {
+  dst->st_dev = makedev(src->stx_dev_major, src->stx_dev_minor);
+  dst->st_mode = src->stx_mode;
+  dst->st_nlink = src->stx_nlink;
+  dst->st_uid = src->stx_uid;
+  dst->st_gid = src->stx_gid;
+  dst->st_rdev = makedev(src->stx_rdev_major, src->stx_rdev_minor);
+  dst->st_ino = src->stx_ino;
+  dst->st_size = src->stx_size;
+  dst->st_blksize = src->stx_blksize;
+  dst->st_blocks = src->stx_blocks;
+  dst->st_atim.tv_sec = src->stx_atime.tv_sec;
+  dst->st_atim.tv_nsec = src->stx_atime.tv_nsec;
+  dst->st_mtim.tv_sec = src->stx_mtime.tv_sec;
+  dst->st_mtim.tv_nsec = src->stx_mtime.tv_nsec;
+  dst->st_ctim.tv_sec = src->stx_ctime.tv_sec;
+  dst->st_ctim.tv_nsec = src->stx_ctime.tv_nsec;
+  /* Report the change time as the birth time, like the threadpool path does
+   * on Linux, so that results don't depend on which path served them.
+   */
+  dst->st_birthtim.tv_sec = src->stx_ctime.tv_sec;
+  dst->st_birthtim.tv_nsec = src->stx_ctime.tv_nsec;
+  dst->st_flags = 0;
+  dst->st_gen = 0;
+}
+
+
+static void uv__io_uring_fs_done(uv_fs_t* req, int result) {
+  struct uv__statx* statxbuf;
+
+  switch (req->fs_type) {
+  case UV_FS_READ:
+  case UV_FS_WRITE:
+    if (req->bufs != req->bufsml)
+      uv__free(req->bufs);
+    req->bufs = NULL;
+    req->nbufs = 0;
+    break;
+
+  case UV_FS_STAT:
+  case UV_FS_LSTAT:
+  case UV_FS_FSTAT:
+    statxbuf = req->ptr;
+    req->ptr = NULL;
+    if (result == 0) {
+      uv__io_uring_statx_to_stat(statxbuf, &req->statbuf);
+      req->ptr = &req->statbuf;
+    }
+    uv__free(statxbuf);
+    break;
+
+  default:
+    break;
+  }
+
+  /* The kernel reports errors as negated errno codes, which is exactly what
+   * UV__ERR() produces on Linux.
+   */
+  req->result = result;
+  uv__req_unregister(req->loop, req);
+  req->cb(req);
+}
+
+
+static void uv__io_uring_io(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
+  struct uv__io_uring* iou;
+  struct uv__io_uring_cqe* cqe;
+  uv_fs_t* req;
+  uintptr_t data;
+  uint32_t head;
+  uint32_t tail;
+  int result;
+
+  iou = container_of(w, struct uv__io_uring, watcher);
+
+  for (;;) {
+    head = *iou->cqhead;
+    tail = uv__io_uring_load(iou->cqtail);
+    if (head == tail)
+      break;
+
+    cqe = &iou->cqe[head & iou->cqmask];
+    data = cqe->user_data;
+    req = (uv_fs_t*) (data & ~UV__IO_URING_CANCELED);
+    if (data & UV__IO_URING_CANCELED)
+      result = UV_ECANCELED;
+    else
+      result = cqe->res;
+
+    /* Give the slot back before running the callback, it may queue new
+     * requests.
+     */
+    uv__io_uring_store(iou->cqhead, head + 1);
+    assert(iou->in_flight > 0);
+    iou->in_flight--;
+    QUEUE_REMOVE(&req->work_req.wq);
+
+    uv__io_uring_fs_done(req, result);
+  }
+}
+
+
+static void uv__io_uring_done_io(uv_loop_t* loop,
+                                 uv__io_t* w,
+                                 unsigned int events) {
+  struct uv__io_uring* iou;
+  uv_fs_t* req;
+  QUEUE queue;
+  QUEUE* q;
+
+  iou = container_of(w, struct uv__io_uring, done_watcher);
+
+  QUEUE_MOVE(&iou->done, &queue);
+  while (!QUEUE_EMPTY(&queue)) {
+    q = QUEUE_HEAD(&queue);
+    QUEUE_REMOVE(q);
+    req = QUEUE_DATA(q, uv_fs_t, work_req.wq);
+    uv__io_uring_fs_done(req, req->result);
+  }
+}
+
+
+/* Runs the callback of |req| with |result| on the next loop iteration. */
+static void uv__io_uring_complete_later(uv_loop_t* loop,
+                                        struct uv__io_uring* iou,
+                                        uv_fs_t* req,
+                                        int result) {
+  req->result = result;
+  QUEUE_INSERT_TAIL(&iou->done, &req->work_req.wq);
+  uv__io_feed(loop, &iou->done_watcher);
+}
+
+
+static int uv__io_uring_map(uv_loop_t* loop, struct uv__io_uring* iou) {
+  struct uv__io_uring_params params;
+  struct uv__io_uring_probe probe;
+  uint32_t* sqarray;
+  size_t sqlen;
+  size_t cqlen;
+  size_t ringlen;
+  size_t sqelen;
+  void* ring;
+  void* sqe;
+  uint32_t i;
+  int ringfd;
+
+  memset(&params, 0, sizeof(params));
+  ringfd = uv__io_uring_setup(UV__IO_URING_ENTRIES, &params);
+  if (ringfd == -1)
+    return UV__ERR(errno);
+
+  /* Both rings share a single mapping (5.4) and the kernel never drops
+   * completions (5.5), which keeps the bookkeeping here simple.
+   */
+  ring = MAP_FAILED;
+  sqe = MAP_FAILED;
+  if (!(params.features & UV__IORING_FEAT_SINGLE_MMAP) ||
+      !(params.features & UV__IORING_FEAT_NODROP)) {
+    goto fail;
+  }
+
+  /* Which opcodes the kernel supports (5.6); older kernels lack most of the
+   * ones we use anyway.
+   */
+  memset(&probe, 0, sizeof(probe));
+  if (uv__io_uring_register(ringfd,
+                            UV__IORING_REGISTER_PROBE,
+                            &probe,
+                            ARRAY_SIZE(probe.ops))) {
+    goto fail;
+  }
+
+  sqlen = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cqlen = params.cq_off.cqes +
+          params.cq_entries * sizeof(struct uv__io_uring_cqe);
+  ringlen = sqlen > cqlen ? sqlen : cqlen;
+  sqelen = params.sq_entries * sizeof(struct uv__io_uring_sqe);
+
+  ring = mmap(NULL,
+              ringlen,
+              PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_POPULATE,
+              ringfd,
+              UV__IORING_OFF_SQ_RING);
+  sqe = mmap(NULL,
+             sqelen,
+             PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE,
+             ringfd,
+             UV__IORING_OFF_SQES);
+  if (ring == MAP_FAILED || sqe == MAP_FAILED)
+    goto fail;
+
+  iou->ringfd = ringfd;
+  iou->features = params.features;
+  iou->in_flight = 0;
+  iou->ring = ring;
+  iou->ringlen = ringlen;
+  iou->sqe = sqe;
+  iou->sqelen = sqelen;
+  iou->sqhead = (uint32_t*) ((char*) ring + params.sq_off.head);
+  iou->sqtail = (uint32_t*) ((char*) ring + params.sq_off.tail);
+  iou->sqmask = *(uint32_t*) ((char*) ring + params.sq_off.ring_mask);
+  iou->sqentries = params.sq_entries;
+  iou->cqhead = (uint32_t*) ((char*) ring + params.cq_off.head);
+  iou->cqtail = (uint32_t*) ((char*) ring + params.cq_off.tail);
+  iou->cqmask = *(uint32_t*) ((char*) ring + params.cq_off.ring_mask);
+  iou->cqentries = params.cq_entries;
+  iou->cqe = (struct uv__io_uring_cqe*) ((char*) ring + params.cq_off.cqes);
+
+  memset(iou->ops, 0, sizeof(iou->ops));
+  for (i = 0; i < ARRAY_SIZE(iou->ops); i++)
+    if (i <= probe.last_op)
+      iou->ops[i] = !!(probe.ops[i].flags & UV__IO_URING_OP_SUPPORTED);
+
+  /* Submission queue entries are always used in order, map them 1:1. */
+  sqarray = (uint32_t*) ((char*) ring + params.sq_off.array);
+  for (i = 0; i <= iou->sqmask; i++)
+    sqarray[i] = i;
+
+  uv__io_init(&iou->watcher, uv__io_uring_io, ringfd);
+  uv__io_start(loop, &iou->watcher, POLLIN);
+
+  return 0;
+
+fail:
+  if (sqe != MAP_FAILED)
+    munmap(sqe, sqelen);
+  if (ring != MAP_FAILED)
+    munmap(ring, ringlen);
+  uv__close(ringfd);
+  return UV_ENOSYS;
+}
+
+
+static void uv__io_uring_unmap(uv_loop_t* loop, struct uv__io_uring* iou) {
+  if (iou->ringfd == -1)
+    return;
+
+  uv__io_stop(loop, &iou->watcher, POLLIN);
+  munmap(iou->sqe, iou->sqelen);
+  munmap(iou->ring, iou->ringlen);
+  uv__close(iou->ringfd);
+  iou->ringfd = -1;
+  iou->in_flight = 0;
+}
+
+
+void uv__io_uring_init(uv_loop_t* loop) {
+  struct uv__io_uring* iou;
+  const char* val;
+
+  loop->io_uring = NULL;
+
+  val = getenv("UV_USE_IO_URING");
+  if (val == NULL || atoi(val) == 0)
+    return;
+
+  iou = uv__malloc(sizeof(*iou));
+  if (iou == NULL)
+    return;
+
+  memset(iou, 0, sizeof(*iou));
+  QUEUE_INIT(&iou->reqs);
+  QUEUE_INIT(&iou->done);
+  uv__io_init(&iou->done_watcher, uv__io_uring_done_io, -1);
+
+  if (uv__io_uring_map(loop, iou)) {
+    uv__free(iou);
+    return;
+  }
+
+  loop->io_uring = iou;
+}
+
+
+void uv__io_uring_delete(uv_loop_t* loop) {
+  struct uv__io_uring* iou;
+
+  iou = loop->io_uring;
+  if (iou == NULL)
+    return;
+
+  /* Every request holds a reference on the loop, none can be left. */
+  assert(QUEUE_EMPTY(&iou->reqs));
+  assert(QUEUE_EMPTY(&iou->done));
+
+  uv__io_uring_unmap(loop, iou);
+  QUEUE_REMOVE(&iou->done_watcher.pending_queue);
+  uv__free(iou);
+  loop->io_uring = NULL;
+}
+
+
+/* The child shares the parent's ring, anything it reaps or submits there
+ * would be taken from the parent.  Let go of it and cancel the requests that
+ * were in flight: the parent completes them, the child never will.  |ring| is
+ * the state from before the fork, loop->io_uring the ring that was set up for
+ * the child, if any.
+ */
+void uv__io_uring_fork(uv_loop_t* loop, void* ring) {
+  struct uv__io_uring* old;
+  struct uv__io_uring* iou;
+  uv_fs_t* req;
+  QUEUE* q;
+
+  old = ring;
+  if (old == NULL)
+    return;
+
+  uv__io_uring_unmap(loop, old);
+
+  iou = loop->io_uring;
+  if (iou == NULL) {
+    if (QUEUE_EMPTY(&old->reqs) && QUEUE_EMPTY(&old->done)) {
+      QUEUE_REMOVE(&old->done_watcher.pending_queue);
+      uv__free(old);
+      return;
+    }
+    /* Keep the ring-less state around until the callbacks have run. */
+    loop->io_uring = iou = old;
+  }
+
+  while (!QUEUE_EMPTY(&old->reqs)) {
+    q = QUEUE_HEAD(&old->reqs);
+    QUEUE_REMOVE(q);
+    req = QUEUE_DATA(q, uv_fs_t, work_req.wq);
+    uv__io_uring_complete_later(loop, iou, req, UV_ECANCELED);
+  }
+
+  if (iou != old) {
+    while (!QUEUE_EMPTY(&old->done)) {
+      q = QUEUE_HEAD(&old->done);
+      QUEUE_REMOVE(q);
+      req = QUEUE_DATA(q, uv_fs_t, work_req.wq);
+      uv__io_uring_complete_later(loop, iou, req, req->result);
+    }
+    QUEUE_REMOVE(&old->done_watcher.pending_queue);
+    uv__free(old);
+  }
+}
+
+
+/* Fails the entries that haven't been submitted yet with |err|. */
+static void uv__io_uring_fail(uv_loop_t* loop,
+                              struct uv__io_uring* iou,
+                              int err) {
+  struct uv__io_uring_sqe* sqe;
+  uv_fs_t* req;
+  uintptr_t data;
+  uint32_t head;
+  uint32_t tail;
+
+  head = uv__io_uring_load(iou->sqhead);
+  tail = *iou->sqtail;
+
+  for (; head != tail; head++) {
+    sqe = &iou->sqe[head & iou->sqmask];
+    data = sqe->user_data;
+    req = (uv_fs_t*) (data & ~UV__IO_URING_CANCELED);
+    QUEUE_REMOVE(&req->work_req.wq);
+    assert(iou->in_flight > 0);
+    iou->in_flight--;
+    if (data & UV__IO_URING_CANCELED)
+      uv__io_uring_complete_later(loop, iou, req, UV_ECANCELED);
+    else
+      uv__io_uring_complete_later(loop, iou, req, err);
+  }
+
+  uv__io_uring_store(iou->sqtail, uv__io_uring_load(iou->sqhead));
+}
+
+
+void uv__io_uring_flush(uv_loop_t* loop) {
+  struct uv__io_uring* iou;
+  uint32_t pending;
+  int rc;
+
+  iou = loop->io_uring;
+  if (iou == NULL || iou->ringfd == -1)
+    return;
+
+  pending = *iou->sqtail - uv__io_uring_load(iou->sqhead);
+  if (pending == 0)
+    return;
+
+  do
+    rc = uv__io_uring_enter(iou->ringfd, pending, 0, 0);
+  while (rc == -1 && errno == EINTR);
+
+  /* EAGAIN and EBUSY are transient, the entries stay in the ring and are
+   * submitted on the next loop iteration.  Anything else won't go away by
+   * retrying, complete the requests with the error.
+   */
+  if (rc == -1 && errno != EAGAIN && errno != EBUSY)
+    uv__io_uring_fail(loop, iou, UV__ERR(errno));
+}
+
+
+static struct uv__io_uring_sqe* uv__io_uring_get_sqe(uv_loop_t* loop,
+                                                     struct uv__io_uring* iou) {
+  struct uv__io_uring_sqe* sqe;
+  uint32_t tail;
+
+  /* Never have more requests in flight than the completion ring can hold. */
+  if (iou->in_flight >= iou->cqentries)
+    return NULL;
+
+  tail = *iou->sqtail;
+  if (tail - uv__io_uring_load(iou->sqhead) >= iou->sqentries) {
+    uv__io_uring_flush(loop);
+    tail = *iou->sqtail;
+    if (tail - uv__io_uring_load(iou->sqhead) >= iou->sqentries)
+      return NULL;
+  }
+
+  sqe = &iou->sqe[tail & iou->sqmask];
+  memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+
+/* Returns 1 if |req| has been queued in the ring, in which case its callback
+ * runs from uv__io_poll(), or 0 if it must take the threadpool path.
+ */
+int uv__io_uring_fs_submit(uv_loop_t* loop, uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__io_uring* iou;
+  struct uv__statx* statxbuf;
+  uint8_t opcode;
+
+  iou = loop->io_uring;
+  if (iou == NULL || iou->ringfd == -1)
+    return 0;
+
+  switch (req->fs_type) {
+  case UV_FS_READ:
+  case UV_FS_WRITE:
+    if (req->nbufs > (unsigned int) uv__getiovmax())
+      return 0;
+    if (req->off < 0 && !(iou->features & UV__IORING_FEAT_RW_CUR_POS))
+      return 0;
+    if (req->fs_type == UV_FS_READ)
+      opcode = UV__IORING_OP_READV;
+    else
+      opcode = UV__IORING_OP_WRITEV;
+    break;
+  case UV_FS_FSYNC:
+  case UV_FS_FDATASYNC:
+    opcode = UV__IORING_OP_FSYNC;
+    break;
+  case UV_FS_OPEN:
+    opcode = UV__IORING_OP_OPENAT;
+    break;
+  case UV_FS_CLOSE:
+    opcode = UV__IORING_OP_CLOSE;
+    break;
+  case UV_FS_STAT:
+  case UV_FS_LSTAT:
+  case UV_FS_FSTAT:
+    opcode = UV__IORING_OP_STATX;
+    break;
+  default:
+    return 0;
+  }
+
+  if (!iou->ops[opcode])
+    return 0;
+
+  statxbuf = NULL;
+  if (opcode == UV__IORING_OP_STATX) {
+    statxbuf = uv__malloc(sizeof(*statxbuf));
+    if (statxbuf == NULL)
+      return 0;
+  }
+
+  sqe = uv__io_uring_get_sqe(loop, iou);
+  if (sqe == NULL) {
+    uv__free(statxbuf);
+    return 0;
+  }
+
+  sqe->opcode = opcode;
+  sqe->user_data = (uintptr_t) req;
+
+  switch (req->fs_type) {
+  case UV_FS_READ:
+  case UV_FS_WRITE:
+    /* uv_buf_t and struct iovec share the same layout on Unices. */
+    sqe->fd = req->file;
+    sqe->addr = (uintptr_t) req->bufs;
+    sqe->len = req->nbufs;
+    sqe->off = req->off;
+    break;
+  case UV_FS_FSYNC:
+  case UV_FS_FDATASYNC:
+    sqe->fd = req->file;
+    if (req->fs_type == UV_FS_FDATASYNC)
+      sqe->op_flags = UV__IORING_FSYNC_DATASYNC;
+    break;
+  case UV_FS_OPEN:
+    sqe->fd = AT_FDCWD;
+    sqe->addr = (uintptr_t) req->path;
+    sqe->len = req->mode;
+    sqe->op_flags = req->flags | O_CLOEXEC;
+    break;
+  case UV_FS_CLOSE:
+    sqe->fd = req->file;
+    break;
+  case UV_FS_STAT:
+  case UV_FS_LSTAT:
+  case UV_FS_FSTAT:
+    if (req->fs_type == UV_FS_FSTAT) {
+      sqe->fd = req->file;
+      sqe->addr = (uintptr_t) "";
+      sqe->op_flags = UV__AT_EMPTY_PATH;
+    } else {
+      sqe->fd = AT_FDCWD;
+      sqe->addr = (uintptr_t) req->path;
+      if (req->fs_type == UV_FS_LSTAT)
+        sqe->op_flags = UV__AT_SYMLINK_NOFOLLOW;
+    }
+    sqe->len = UV__STATX_BASIC_STATS;
+    sqe->off = (uintptr_t) statxbuf;  /* addr2 */
+    req->ptr = statxbuf;
+    break;
+  default:
+    /* Filtered out by the opcode selection above. */
+    assert(0 && "unexpected fs_type");
+    uv__free(statxbuf);
+    return 0;
+  }
+
+  uv__io_uring_store(iou->sqtail, *iou->sqtail + 1);
+  iou->in_flight++;
+
+  /* A NULL work function tells uv_cancel() that the request is ours. */
+  req->work_req.loop = loop;
+  req->work_req.work = NULL;
+  req->work_req.done = NULL;
+  QUEUE_INSERT_TAIL(&iou->reqs, &req->work_req.wq);
+
+  return 1;
+}
+
+
+/* Cancels |req| if it is still waiting to be submitted, or to have its
+ * callback run.  Once the kernel has it there is no taking it back.
+ */
+int uv__io_uring_fs_cancel(uv_loop_t* loop, uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__io_uring* iou;
+  uint32_t head;
+  uint32_t tail;
+  QUEUE* q;
+
+  iou = loop->io_uring;
+  if (iou == NULL)
+    return UV_EBUSY;
+
+  QUEUE_FOREACH(q, &iou->done) {
+    if (q == &req->work_req.wq) {
+      req->result = UV_ECANCELED;
+      return 0;
+    }
+  }
+
+  if (iou->ringfd == -1)
+    return UV_EBUSY;
+
+  head = uv__io_uring_load(iou->sqhead);
+  tail = *iou->sqtail;
+
+  for (; head != tail; head++) {
+    sqe = &iou->sqe[head & iou->sqmask];
+    if (sqe->user_data != (uintptr_t) req)
+      continue;
+
+    /* Resources are released by uv__io_uring_fs_done() when the no-op
+     * completes.
+     */
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = UV__IORING_OP_NOP;
+    sqe->user_data = (uintptr_t) req | UV__IO_URING_CANCELED;
+    return 0;
+  }
+
+  return UV_EBUSY;
+}
+
+#endif  /* __linux__ */
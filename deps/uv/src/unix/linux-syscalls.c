@@ -190,6 +190,45 @@
 # endif
 #endif /* __NR_pwritev */
 
+#ifndef __NR_copy_file_range
+# if defined(__x86_64__)
+#  define __NR_copy_file_range 326
+# elif defined(__i386__)
+#  define __NR_copy_file_range 377
+# elif defined(__aarch64__)
+#  define __NR_copy_file_range 285
+# elif defined(__arm__)
+#  define __NR_copy_file_range (UV_SYSCALL_BASE + 391)
+# endif
+#endif /* __NR_copy_file_range */
+
+
+/* io_uring arrived after the switch to a unified syscall table, so the
+ * numbers are the same on all architectures we care about.
+ */
+#ifndef __NR_io_uring_setup
+# if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+#  define __NR_io_uring_setup 425
+# elif defined(__arm__)
+#  define __NR_io_uring_setup (UV_SYSCALL_BASE + 425)
+# endif
+#endif /* __NR_io_uring_setup */
+
+#ifndef __NR_io_uring_enter
+# if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+#  define __NR_io_uring_enter 426
+# elif defined(__arm__)
+#  define __NR_io_uring_enter (UV_SYSCALL_BASE + 426)
+# endif
+#endif /* __NR_io_uring_enter */
+
+#ifndef __NR_io_uring_register
+# if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+#  define __NR_io_uring_register 427
+# elif defined(__arm__)
+#  define __NR_io_uring_register (UV_SYSCALL_BASE + 427)
+# endif
+#endif /* __NR_io_uring_register */
 
 int uv__accept4(int fd, struct sockaddr* addr, socklen_t* addrlen, int flags) {
 #if defined(__i386__)
@@ -339,3 +378,65 @@ int uv__dup3(int oldfd, int newfd, int flags) {
   return errno = ENOSYS, -1;
 #endif
 }
+
+
+ssize_t uv__copy_file_range(int fd_in,
+                            int64_t* off_in,
+                            int fd_out,
+                            int64_t* off_out,
+                            size_t len,
+                            unsigned int flags) {
+#if defined(__NR_copy_file_range)
+  return syscall(__NR_copy_file_range,
+                 fd_in,
+                 off_in,
+                 fd_out,
+                 off_out,
+                 len,
+                 flags);
+#else
+  return errno = ENOSYS, -1;
+#endif
+}
+
+
+int uv__io_uring_setup(unsigned int entries, struct uv__io_uring_params* params) {
+#if defined(__NR_io_uring_setup)
+  return syscall(__NR_io_uring_setup, entries, params);
+#else
+  return errno = ENOSYS, -1;
+#endif
+}
+
+
+int uv__io_uring_enter(int fd,
+                       unsigned int to_submit,
+                       unsigned int min_complete,
+                       unsigned int flags) {
+#if defined(__NR_io_uring_enter)
+  /* The last two arguments are the signal mask and its size, we don't use
+   * them.
+   */
+  return syscall(__NR_io_uring_enter,
+                 fd,
+                 to_submit,
+                 min_complete,
+                 flags,
+                 NULL,
+                 0L);
+#else
+  return errno = ENOSYS, -1;
+#endif
+}
+
+
+int uv__io_uring_register(int fd,
+                          unsigned int opcode,
+                          void* arg,
+                          unsigned int nargs) {
+#if defined(__NR_io_uring_register)
+  return syscall(__NR_io_uring_register, fd, opcode, arg, nargs);
+#else
+  return errno = ENOSYS, -1;
+#endif
+}
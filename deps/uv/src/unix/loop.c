@@ -183,6 +183,13 @@ void uv__loop_close(uv_loop_t* loop) {
 
 
 int uv__loop_configure(uv_loop_t* loop, uv_loop_option option, va_list ap) {
+#if defined(__linux__)
+  if (option == UV_LOOP_BUSY_POLL) {
+    loop->busy_poll.budget = va_arg(ap, unsigned int);
+    return 0;
+  }
+#endif
+
   if (option != UV_LOOP_BLOCK_SIGNAL)
     return UV_ENOSYS;
 
@@ -192,3 +199,11 @@ int uv__loop_configure(uv_loop_t* loop, uv_loop_option option, va_list ap) {
   loop->flags |= UV_LOOP_BLOCK_SIGPROF;
   return 0;
 }
+
+
+#if !defined(__linux__)
+int uv_loop_busy_poll_stats(const uv_loop_t* loop,
+                            uv_busy_poll_stats_t* stats) {
+  return UV_ENOSYS;
+}
+#endif
@@ -870,8 +870,10 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
     if (sizeof(int32_t) == sizeof(long) && timeout >= max_safe_timeout)
       timeout = max_safe_timeout;
 
+    uv__metrics_poll_enter(loop);
     nfds = epoll_wait(loop->ep, events,
                       ARRAY_SIZE(events), timeout);
+    SAVE_ERRNO(uv__metrics_poll_exit(loop));
 
     /* Update loop->time unconditionally. It's tempting to skip the update when
      * timeout == 0 (i.e. non-blocking poll) but there is no guarantee that the
@@ -558,6 +558,10 @@ void uv__server_io(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
     }
 
     UV_DEC_BACKLOG(w)
+#if defined(__linux__)
+    if (stream->type == UV_TCP)
+      uv__busy_poll_socket(loop, err);
+#endif
     stream->accepted_fd = err;
     stream->connection_cb(stream, 0);
 
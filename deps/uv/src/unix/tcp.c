@@ -156,6 +156,11 @@ int uv__tcp_bind(uv_tcp_t* tcp,
   if ((flags & UV_TCP_IPV6ONLY) && addr->sa_family != AF_INET6)
     return UV_EINVAL;
 
+#if !defined(SO_REUSEPORT)
+  if (flags & UV_TCP_REUSEPORT)
+    return UV_ENOTSUP;
+#endif
+
   err = maybe_new_socket(tcp, addr->sa_family, 0);
   if (err)
     return err;
@@ -164,6 +169,28 @@ int uv__tcp_bind(uv_tcp_t* tcp,
   if (setsockopt(tcp->io_watcher.fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)))
     return UV__ERR(errno);
 
+#if defined(SO_REUSEPORT)
+  /* FreeBSD only balances incoming connections across the sockets in the
+   * group with SO_REUSEPORT_LB. Linux does so with plain SO_REUSEPORT.
+   */
+  if (flags & UV_TCP_REUSEPORT) {
+#if defined(SO_REUSEPORT_LB)
+    if (setsockopt(tcp->io_watcher.fd,
+                   SOL_SOCKET,
+                   SO_REUSEPORT_LB,
+                   &on,
+                   sizeof(on)))
+#else
+    if (setsockopt(tcp->io_watcher.fd,
+                   SOL_SOCKET,
+                   SO_REUSEPORT,
+                   &on,
+                   sizeof(on)))
+#endif
+      return UV__ERR(errno);
+  }
+#endif
+
 #ifndef __OpenBSD__
 #ifdef IPV6_V6ONLY
   if (addr->sa_family == AF_INET6) {
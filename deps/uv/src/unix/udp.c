@@ -39,6 +39,26 @@
 # define IPV6_DROP_MEMBERSHIP IPV6_LEAVE_GROUP
 #endif
 
+#if defined(__linux__)
+# define HAVE_MMSG 1
+#else
+# define HAVE_MMSG 0
+#endif
+
+#define UV__UDP_DGRAM_MAXSIZE (64 * 1024)
+
+/* Upper bound on the number of datagrams moved by one recvmmsg or sendmmsg
+ * call. Keeps the message headers on the stack and the buffer that
+ * uv__udp_recvmmsg() asks for at a reasonable size.
+ */
+#define UV__MMSG_MAXWIDTH 20
+
+#if HAVE_MMSG
+static uv_once_t once = UV_ONCE_INIT;
+static int uv__recvmmsg_avail;
+static int uv__sendmmsg_avail;
+#endif
+
 
 static void uv__udp_run_completed(uv_udp_t* handle);
 static void uv__udp_io(uv_loop_t* loop, uv__io_t* w, unsigned int revents);
@@ -49,6 +69,37 @@ static int uv__udp_maybe_deferred_bind(uv_udp_t* handle,
                                        unsigned int flags);
 
 
+#if HAVE_MMSG
+static void uv__udp_mmsg_init(void) {
+  int ret;
+  int s;
+
+  s = uv__socket(AF_INET, SOCK_DGRAM, 0);
+  if (s < 0)
+    return;
+
+  ret = uv__sendmmsg(s, NULL, 0, 0);
+  if (ret == 0 || errno != ENOSYS) {
+    uv__sendmmsg_avail = 1;
+    uv__recvmmsg_avail = 1;
+  } else {
+    ret = uv__recvmmsg(s, NULL, 0, MSG_DONTWAIT, NULL);
+    if (ret == 0 || errno != ENOSYS)
+      uv__recvmmsg_avail = 1;
+  }
+
+  uv__close(s);
+}
+#endif
+
+
+static socklen_t uv__udp_addrlen(const struct sockaddr_storage* addr) {
+  if (addr->ss_family == AF_INET6)
+    return sizeof(struct sockaddr_in6);
+  return sizeof(struct sockaddr_in);
+}
+
+
 void uv__udp_close(uv_udp_t* handle) {
   uv__io_close(handle->loop, &handle->io_watcher);
   uv__handle_stop(handle);
@@ -148,6 +199,75 @@ static void uv__udp_io(uv_loop_t* loop, uv__io_t* w, unsigned int revents) {
 }
 
 
+#if HAVE_MMSG
+static ssize_t uv__udp_recvmmsg(uv_udp_t* handle, uv_buf_t* buf) {
+  struct sockaddr_storage peers[UV__MMSG_MAXWIDTH];
+  struct iovec iov[UV__MMSG_MAXWIDTH];
+  struct uv__mmsghdr msgs[UV__MMSG_MAXWIDTH];
+  const struct sockaddr* addr;
+  uv_udp_recv_cb recv_cb;
+  uv_buf_t chunk_buf;
+  ssize_t nread;
+  size_t chunks;
+  size_t k;
+  int flags;
+
+  /* Split the buffer into datagram-sized chunks, one per message. */
+  chunks = buf->len / UV__UDP_DGRAM_MAXSIZE;
+  if (chunks > ARRAY_SIZE(iov))
+    chunks = ARRAY_SIZE(iov);
+
+  for (k = 0; k < chunks; k++) {
+    iov[k].iov_base = buf->base + k * UV__UDP_DGRAM_MAXSIZE;
+    iov[k].iov_len = UV__UDP_DGRAM_MAXSIZE;
+    memset(&msgs[k].msg_hdr, 0, sizeof(msgs[k].msg_hdr));
+    msgs[k].msg_hdr.msg_iov = iov + k;
+    msgs[k].msg_hdr.msg_iovlen = 1;
+    msgs[k].msg_hdr.msg_name = peers + k;
+    msgs[k].msg_hdr.msg_namelen = sizeof(peers[0]);
+  }
+
+  do
+    nread = uv__recvmmsg(handle->io_watcher.fd, msgs, chunks, 0, NULL);
+  while (nread == -1 && errno == EINTR);
+
+  if (nread < 1) {
+    if (nread == 0 || errno == EAGAIN || errno == EWOULDBLOCK)
+      handle->recv_cb(handle, 0, buf, NULL, 0);
+    else
+      handle->recv_cb(handle, UV__ERR(errno), buf, NULL, 0);
+    return -1;
+  }
+
+  /* recv_cb may stop the handle or close it halfway through the batch. The
+   * remaining datagrams are dropped then, but the buffer still has to be
+   * handed back.
+   */
+  recv_cb = handle->recv_cb;
+  for (k = 0; k < (size_t) nread; k++) {
+    if (handle->recv_cb == NULL || handle->io_watcher.fd == -1)
+      break;
+
+    flags = UV_UDP_MMSG_CHUNK;
+    if (msgs[k].msg_hdr.msg_flags & MSG_TRUNC)
+      flags |= UV_UDP_PARTIAL;
+
+    addr = NULL;
+    if (msgs[k].msg_hdr.msg_namelen != 0)
+      addr = (const struct sockaddr*) &peers[k];
+
+    chunk_buf = uv_buf_init(iov[k].iov_base, iov[k].iov_len);
+    handle->recv_cb(handle, msgs[k].msg_len, &chunk_buf, addr, flags);
+  }
+
+  /* One last callback so that the caller can release the whole buffer. */
+  recv_cb(handle, 0, buf, NULL, 0);
+
+  return nread;
+}
+#endif
+
+
 static void uv__udp_recvmsg(uv_udp_t* handle) {
   struct sockaddr_storage peer;
   struct msghdr h;
@@ -169,13 +289,26 @@ static void uv__udp_recvmsg(uv_udp_t* handle) {
 
   do {
     buf = uv_buf_init(NULL, 0);
-    handle->alloc_cb((uv_handle_t*) handle, 64 * 1024, &buf);
+    handle->alloc_cb((uv_handle_t*) handle, UV__UDP_DGRAM_MAXSIZE, &buf);
     if (buf.base == NULL || buf.len == 0) {
       handle->recv_cb(handle, UV_ENOBUFS, &buf, NULL, 0);
       return;
     }
     assert(buf.base != NULL);
 
+#if HAVE_MMSG
+    /* A buffer with room for a single datagram gains nothing from recvmmsg,
+     * so it goes through the plain recvmsg path below.
+     */
+    if ((handle->flags & UV_HANDLE_UDP_RECVMMSG) &&
+        buf.len >= 2 * UV__UDP_DGRAM_MAXSIZE) {
+      nread = uv__udp_recvmmsg(handle, &buf);
+      if (nread > 0)
+        count -= nread;
+      continue;
+    }
+#endif
+
     h.msg_namelen = sizeof(peer);
     h.msg_iov = (void*) &buf;
     h.msg_iovlen = 1;
@@ -213,12 +346,85 @@ static void uv__udp_recvmsg(uv_udp_t* handle) {
 }
 
 
+#if HAVE_MMSG
+static void uv__udp_sendmmsg(uv_udp_t* handle) {
+  uv_udp_send_t* req;
+  struct uv__mmsghdr h[UV__MMSG_MAXWIDTH];
+  struct uv__mmsghdr* p;
+  QUEUE* q;
+  ssize_t npkts;
+  size_t pkts;
+  size_t i;
+
+  while (!QUEUE_EMPTY(&handle->write_queue)) {
+    pkts = 0;
+    QUEUE_FOREACH(q, &handle->write_queue) {
+      if (pkts == ARRAY_SIZE(h))
+        break;
+
+      req = QUEUE_DATA(q, uv_udp_send_t, queue);
+      p = &h[pkts++];
+      memset(p, 0, sizeof(*p));
+      p->msg_hdr.msg_name = &req->addr;
+      p->msg_hdr.msg_namelen = uv__udp_addrlen(&req->addr);
+      p->msg_hdr.msg_iov = (struct iovec*) req->bufs;
+      p->msg_hdr.msg_iovlen = req->nbufs;
+    }
+
+    do
+      npkts = uv__sendmmsg(handle->io_watcher.fd, h, pkts, 0);
+    while (npkts == -1 && errno == EINTR);
+
+    if (npkts == -1) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+        break;
+
+      /* sendmmsg only fails when the first datagram does; fail that one and
+       * carry on with the rest.
+       */
+      q = QUEUE_HEAD(&handle->write_queue);
+      req = QUEUE_DATA(q, uv_udp_send_t, queue);
+      req->status = UV__ERR(errno);
+      QUEUE_REMOVE(&req->queue);
+      QUEUE_INSERT_TAIL(&handle->write_completed_queue, &req->queue);
+      uv__io_feed(handle->loop, &handle->io_watcher);
+      continue;
+    }
+
+    /* See uv__udp_sendmsg() on why there is no such thing as a partial
+     * datagram write.
+     */
+    for (i = 0; i < (size_t) npkts; i++) {
+      q = QUEUE_HEAD(&handle->write_queue);
+      req = QUEUE_DATA(q, uv_udp_send_t, queue);
+      req->status = h[i].msg_len;
+      QUEUE_REMOVE(&req->queue);
+      QUEUE_INSERT_TAIL(&handle->write_completed_queue, &req->queue);
+    }
+    uv__io_feed(handle->loop, &handle->io_watcher);
+
+    /* A short count means that the socket buffer is full. */
+    if ((size_t) npkts < pkts)
+      break;
+  }
+}
+#endif
+
+
 static void uv__udp_sendmsg(uv_udp_t* handle) {
   uv_udp_send_t* req;
   QUEUE* q;
   struct msghdr h;
   ssize_t size;
 
+#if HAVE_MMSG
+  uv_once(&once, uv__udp_mmsg_init);
+  if (uv__sendmmsg_avail) {
+    uv__udp_sendmmsg(handle);
+    return;
+  }
+#endif
+
   while (!QUEUE_EMPTY(&handle->write_queue)) {
     q = QUEUE_HEAD(&handle->write_queue);
     assert(q != NULL);
@@ -228,8 +434,7 @@ static void uv__udp_sendmsg(uv_udp_t* handle) {
 
     memset(&h, 0, sizeof h);
     h.msg_name = &req->addr;
-    h.msg_namelen = (req->addr.ss_family == AF_INET6 ?
-      sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in));
+    h.msg_namelen = uv__udp_addrlen(&req->addr);
     h.msg_iov = (struct iovec*) req->bufs;
     h.msg_iovlen = req->nbufs;
 
@@ -484,6 +689,86 @@ int uv__udp_try_send(uv_udp_t* handle,
 }
 
 
+int uv__udp_try_send2(uv_udp_t* handle,
+                      unsigned int count,
+                      uv_buf_t* bufs[],
+                      unsigned int nbufs[],
+                      struct sockaddr* addrs[]) {
+#if HAVE_MMSG
+  struct uv__mmsghdr h[UV__MMSG_MAXWIDTH];
+  unsigned int n;
+  unsigned int k;
+#endif
+  struct msghdr m;
+  unsigned int i;
+  ssize_t r;
+  int err;
+
+  err = uv__udp_maybe_deferred_bind(handle, addrs[0]->sa_family, 0);
+  if (err)
+    return err;
+
+#if HAVE_MMSG
+  uv_once(&once, uv__udp_mmsg_init);
+  if (uv__sendmmsg_avail) {
+    for (i = 0; i < count; i += n) {
+      n = count - i;
+      if (n > ARRAY_SIZE(h))
+        n = ARRAY_SIZE(h);
+
+      memset(h, 0, n * sizeof(h[0]));
+      for (k = 0; k < n; k++) {
+        h[k].msg_hdr.msg_name = addrs[i + k];
+        h[k].msg_hdr.msg_namelen =
+            uv__udp_addrlen((struct sockaddr_storage*) addrs[i + k]);
+        h[k].msg_hdr.msg_iov = (struct iovec*) bufs[i + k];
+        h[k].msg_hdr.msg_iovlen = nbufs[i + k];
+      }
+
+      do
+        r = uv__sendmmsg(handle->io_watcher.fd, h, n, 0);
+      while (r == -1 && errno == EINTR);
+
+      if (r == -1)
+        goto error;
+
+      if ((unsigned int) r < n)
+        return i + r;
+    }
+
+    return count;
+  }
+#endif
+
+  for (i = 0; i < count; i++) {
+    memset(&m, 0, sizeof(m));
+    m.msg_name = addrs[i];
+    m.msg_namelen = uv__udp_addrlen((struct sockaddr_storage*) addrs[i]);
+    m.msg_iov = (struct iovec*) bufs[i];
+    m.msg_iovlen = nbufs[i];
+
+    do
+      r = sendmsg(handle->io_watcher.fd, &m, 0);
+    while (r == -1 && errno == EINTR);
+
+    if (r == -1)
+      goto error;
+  }
+
+  return count;
+
+error:
+  /* Report the datagrams that did go out; the error surfaces again when the
+   * caller retries the rest.
+   */
+  if (i > 0)
+    return i;
+  if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+    return UV_EAGAIN;
+  return UV__ERR(errno);
+}
+
+
 static int uv__udp_set_membership4(uv_udp_t* handle,
                                    const struct sockaddr_in* multicast_addr,
                                    const char* interface_addr,
@@ -588,7 +873,7 @@ int uv_udp_init_ex(uv_loop_t* loop, uv_udp_t* handle, unsigned int flags) {
   if (domain != AF_INET && domain != AF_INET6 && domain != AF_UNSPEC)
     return UV_EINVAL;
 
-  if (flags & ~0xFF)
+  if (flags & ~0xFF & ~UV_UDP_RECVMMSG)
     return UV_EINVAL;
 
   if (domain != AF_UNSPEC) {
@@ -608,6 +893,15 @@ int uv_udp_init_ex(uv_loop_t* loop, uv_udp_t* handle, unsigned int flags) {
   uv__io_init(&handle->io_watcher, uv__udp_io, fd);
   QUEUE_INIT(&handle->write_queue);
   QUEUE_INIT(&handle->write_completed_queue);
+
+#if HAVE_MMSG
+  if (flags & UV_UDP_RECVMMSG) {
+    uv_once(&once, uv__udp_mmsg_init);
+    if (uv__recvmmsg_avail)
+      handle->flags |= UV_HANDLE_UDP_RECVMMSG;
+  }
+#endif
+
   return 0;
 }
 
@@ -351,6 +351,30 @@ int uv_udp_try_send(uv_udp_t* handle,
 }
 
 
+int uv_udp_try_send2(uv_udp_t* handle,
+                     unsigned int count,
+                     uv_buf_t* bufs[],
+                     unsigned int nbufs[],
+                     struct sockaddr* addrs[],
+                     unsigned int flags) {
+  unsigned int i;
+
+  if (handle->type != UV_UDP || count < 1 || flags != 0)
+    return UV_EINVAL;
+
+  for (i = 0; i < count; i++)
+    if (nbufs[i] < 1 ||
+        (addrs[i]->sa_family != AF_INET && addrs[i]->sa_family != AF_INET6))
+      return UV_EINVAL;
+
+  /* Don't let the datagrams overtake the ones that are already queued. */
+  if (handle->send_queue_count != 0)
+    return UV_EAGAIN;
+
+  return uv__udp_try_send2(handle, count, bufs, nbufs, addrs);
+}
+
+
 int uv_udp_recv_start(uv_udp_t* handle,
                       uv_alloc_cb alloc_cb,
                       uv_udp_recv_cb recv_cb) {
@@ -604,8 +628,16 @@ int uv_loop_configure(uv_loop_t* loop, uv_loop_option option, ...) {
   va_list ap;
   int err;
 
-  va_start(ap, option);
   /* Any platform-agnostic options should be handled here. */
+  if (option == UV_METRICS_IDLE_TIME) {
+    loop->metrics.enabled = 1;
+    return 0;
+  }
+
+  if (option == UV_LOOP_TIMER_WHEEL)
+    return uv__timer_wheel_init(loop);
+
+  va_start(ap, option);
   err = uv__loop_configure(loop, option, ap);
   va_end(ap);
 
@@ -613,6 +645,11 @@ int uv_loop_configure(uv_loop_t* loop, uv_loop_option option, ...) {
 }
 
 
+uint64_t uv_metrics_idle_time(uv_loop_t* loop) {
+  return loop->metrics.idle_time;
+}
+
+
 static uv_loop_t default_loop_struct;
 static uv_loop_t* default_loop_ptr;
 
@@ -663,6 +700,9 @@ int uv_loop_close(uv_loop_t* loop) {
 
   uv__loop_close(loop);
 
+  uv__free(loop->timer_wheel);
+  loop->timer_wheel = NULL;
+
 #ifndef NDEBUG
   saved_data = loop->data;
   memset(loop, -1, sizeof(*loop));
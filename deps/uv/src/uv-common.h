@@ -102,6 +102,7 @@ enum {
 
   /* Only used by uv_udp_t handles. */
   UV_HANDLE_UDP_PROCESSING              = 0x01000000,
+  UV_HANDLE_UDP_RECVMMSG                = 0x02000000,
 
   /* Only used by uv_pipe_t handles. */
   UV_HANDLE_NON_OVERLAPPED_PIPE         = 0x01000000,
@@ -155,6 +156,12 @@ int uv__udp_try_send(uv_udp_t* handle,
                      const struct sockaddr* addr,
                      unsigned int addrlen);
 
+int uv__udp_try_send2(uv_udp_t* handle,
+                      unsigned int count,
+                      uv_buf_t* bufs[],
+                      unsigned int nbufs[],
+                      struct sockaddr* addrs[]);
+
 int uv__udp_recv_start(uv_udp_t* handle, uv_alloc_cb alloccb,
                        uv_udp_recv_cb recv_cb);
 
@@ -164,15 +171,9 @@ void uv__fs_poll_close(uv_fs_poll_t* handle);
 
 int uv__getaddrinfo_translate_error(int sys_err);    /* EAI_* error. */
 
-enum uv__work_kind {
-  UV__WORK_CPU,
-  UV__WORK_FAST_IO,
-  UV__WORK_SLOW_IO
-};
-
 void uv__work_submit(uv_loop_t* loop,
                      struct uv__work *w,
-                     enum uv__work_kind kind,
+                     uv_work_class_t work_class,
                      void (*work)(struct uv__work *w),
                      void (*done)(struct uv__work *w, int status));
 
@@ -186,8 +187,30 @@ void uv__fs_scandir_cleanup(uv_fs_t* req);
 
 int uv__next_timeout(const uv_loop_t* loop);
 void uv__run_timers(uv_loop_t* loop);
+int uv__timer_wheel_init(uv_loop_t* loop);
 void uv__timer_close(uv_timer_t* handle);
 
+/* The time between these two counts as idle time if the loop was configured
+ * with UV_METRICS_IDLE_TIME. Backends call them right around the syscall
+ * that blocks for I/O, so running callbacks never counts as idle.
+ */
+#define uv__metrics_poll_enter(loop)                                          \
+  do {                                                                        \
+    if ((loop)->metrics.enabled)                                              \
+      (loop)->metrics.entry_time = uv_hrtime();                               \
+  }                                                                           \
+  while (0)
+
+#define uv__metrics_poll_exit(loop)                                           \
+  do {                                                                        \
+    if ((loop)->metrics.entry_time != 0) {                                    \
+      (loop)->metrics.idle_time +=                                            \
+          uv_hrtime() - (loop)->metrics.entry_time;                           \
+      (loop)->metrics.entry_time = 0;                                         \
+    }                                                                         \
+  }                                                                           \
+  while (0)
+
 #define uv__has_active_reqs(loop)                                             \
   ((loop)->active_reqs.count > 0)
 
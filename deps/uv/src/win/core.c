@@ -239,6 +239,8 @@ int uv_loop_init(uv_loop_t* loop) {
   loop->time = 0;
   uv_update_time(loop);
 
+  memset(&loop->metrics, 0, sizeof(loop->metrics));
+
   QUEUE_INIT(&loop->wq);
   QUEUE_INIT(&loop->handle_queue);
   loop->active_reqs.count = 0;
@@ -270,6 +272,7 @@ int uv_loop_init(uv_loop_t* loop) {
   loop->active_udp_streams = 0;
 
   loop->timer_counter = 0;
+  loop->timer_wheel = NULL;
   loop->stop_flag = 0;
 
   err = uv_mutex_init(&loop->wq_mutex);
@@ -351,6 +354,12 @@ int uv__loop_configure(uv_loop_t* loop, uv_loop_option option, va_list ap) {
 }
 
 
+int uv_loop_busy_poll_stats(const uv_loop_t* loop,
+                            uv_busy_poll_stats_t* stats) {
+  return UV_ENOSYS;
+}
+
+
 int uv_backend_fd(const uv_loop_t* loop) {
   return -1;
 }
@@ -392,11 +401,13 @@ static void uv__poll_wine(uv_loop_t* loop, DWORD timeout) {
   timeout_time = loop->time + timeout;
 
   for (repeat = 0; ; repeat++) {
+    uv__metrics_poll_enter(loop);
     GetQueuedCompletionStatus(loop->iocp,
                               &bytes,
                               &key,
                               &overlapped,
                               timeout);
+    uv__metrics_poll_exit(loop);
 
     if (overlapped) {
       /* Package was dequeued */
@@ -444,12 +455,14 @@ static void uv__poll(uv_loop_t* loop, DWORD timeout) {
   timeout_time = loop->time + timeout;
 
   for (repeat = 0; ; repeat++) {
+    uv__metrics_poll_enter(loop);
     success = GetQueuedCompletionStatusEx(loop->iocp,
                                           overlappeds,
                                           ARRAY_SIZE(overlappeds),
                                           &count,
                                           timeout,
                                           FALSE);
+    uv__metrics_poll_exit(loop);
 
     if (success) {
       for (i = 0; i < count; i++) {
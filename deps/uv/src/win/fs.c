@@ -57,7 +57,7 @@
       uv__req_register(loop, req);                                            \
       uv__work_submit(loop,                                                   \
                       &req->work_req,                                         \
-                      UV__WORK_FAST_IO,                                       \
+                      UV_WORK_CLASS_FS,                                       \
                       uv__fs_work,                                            \
                       uv__fs_done);                                           \
       return 0;                                                               \
@@ -1408,6 +1408,7 @@ static void fs__copyfile(uv_fs_t* req) {
     return;
   }
 
+  req->fs.info.mode = UV_FS_COPYFILE_METHOD_SYSTEM;
   SET_REQ_RESULT(req, 0);
 }
 
@@ -2407,10 +2408,19 @@ int uv_fs_copyfile(uv_loop_t* loop,
     return uv_translate_sys_error(err);
 
   req->fs.info.file_flags = flags;
+  req->fs.info.mode = UV_FS_COPYFILE_METHOD_UNKNOWN;
   POST;
 }
 
 
+uv_fs_copyfile_method uv_fs_get_copyfile_method(const uv_fs_t* req) {
+  if (req->fs_type != UV_FS_COPYFILE || req->result != 0)
+    return UV_FS_COPYFILE_METHOD_UNKNOWN;
+
+  return (uv_fs_copyfile_method) req->fs.info.mode;
+}
+
+
 int uv_fs_sendfile(uv_loop_t* loop, uv_fs_t* req, uv_file fd_out,
     uv_file fd_in, int64_t in_offset, size_t length, uv_fs_cb cb) {
   INIT(UV_FS_SENDFILE);
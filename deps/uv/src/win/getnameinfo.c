@@ -145,7 +145,7 @@ int uv_getnameinfo(uv_loop_t* loop,
   if (getnameinfo_cb) {
     uv__work_submit(loop,
                     &req->work_req,
-                    UV__WORK_SLOW_IO,
+                    UV_WORK_CLASS_DNS,
                     uv__getnameinfo_work,
                     uv__getnameinfo_done);
     return 0;
@@ -1497,6 +1497,9 @@ int uv__tcp_bind(uv_tcp_t* handle,
                  unsigned int flags) {
   int err;
 
+  if (flags & UV_TCP_REUSEPORT)
+    return UV_ENOTSUP;
+
   err = uv_tcp_try_bind(handle, addr, addrlen, flags);
   if (err)
     return uv_translate_sys_error(err);
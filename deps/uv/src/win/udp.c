@@ -128,7 +128,8 @@ int uv_udp_init_ex(uv_loop_t* loop, uv_udp_t* handle, unsigned int flags) {
   if (domain != AF_INET && domain != AF_INET6 && domain != AF_UNSPEC)
     return UV_EINVAL;
 
-  if (flags & ~0xFF)
+  /* UV_UDP_RECVMMSG is accepted but has no effect on Windows. */
+  if (flags & ~0xFF & ~UV_UDP_RECVMMSG)
     return UV_EINVAL;
 
   uv__handle_init(loop, (uv_handle_t*) handle, UV_UDP);
@@ -960,3 +961,27 @@ int uv__udp_try_send(uv_udp_t* handle,
 
   return bytes;
 }
+
+
+int uv__udp_try_send2(uv_udp_t* handle,
+                      unsigned int count,
+                      uv_buf_t* bufs[],
+                      unsigned int nbufs[],
+                      struct sockaddr* addrs[]) {
+  unsigned int addrlen;
+  unsigned int i;
+  int r;
+
+  for (i = 0; i < count; i++) {
+    if (addrs[i]->sa_family == AF_INET6)
+      addrlen = sizeof(struct sockaddr_in6);
+    else
+      addrlen = sizeof(struct sockaddr_in);
+
+    r = uv__udp_try_send(handle, bufs[i], nbufs[i], addrs[i], addrlen);
+    if (r < 0)
+      return i > 0 ? i : r;
+  }
+
+  return count;
+}
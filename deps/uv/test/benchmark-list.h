@@ -75,6 +75,8 @@ BENCHMARK_DECLARE (spawn)
 BENCHMARK_DECLARE (thread_create)
 BENCHMARK_DECLARE (million_async)
 BENCHMARK_DECLARE (million_timers)
+BENCHMARK_DECLARE (threadpool_contention)
+BENCHMARK_DECLARE (threadpool_contention_work_stealing)
 HELPER_DECLARE    (tcp4_blackhole_server)
 HELPER_DECLARE    (tcp_pump_server)
 HELPER_DECLARE    (pipe_pump_server)
@@ -160,4 +162,7 @@ TASK_LIST_START
   BENCHMARK_ENTRY  (thread_create)
   BENCHMARK_ENTRY  (million_async)
   BENCHMARK_ENTRY  (million_timers)
+
+  BENCHMARK_ENTRY  (threadpool_contention)
+  BENCHMARK_ENTRY  (threadpool_contention_work_stealing)
 TASK_LIST_END
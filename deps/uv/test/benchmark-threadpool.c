@@ -0,0 +1,142 @@
+/* Copyright Joyent, Inc. and other Node contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "task.h"
+#include "uv.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Every submitter thread runs its own loop and keeps a fixed number of tiny
+ * requests in flight, so that the time is dominated by queueing overhead and
+ * lock contention in the threadpool rather than by the work itself.
+ */
+#define NUM_SUBMITTERS 4
+#define NUM_IN_FLIGHT 256
+#define NUM_REQS_PER_SUBMITTER 250000
+
+struct submitter {
+  uv_loop_t loop;
+  uv_thread_t thread;
+  uv_work_t reqs[NUM_IN_FLIGHT];
+  unsigned int queued;
+  unsigned int done;
+};
+
+static struct submitter submitters[NUM_SUBMITTERS];
+
+
+static void work_cb(uv_work_t* req) {
+  volatile unsigned int i;
+
+  for (i = 0; i < 100; i++);
+}
+
+
+static void after_work_cb(uv_work_t* req, int status) {
+  struct submitter* s;
+
+  ASSERT(status == 0);
+  s = req->data;
+  s->done++;
+
+  if (s->queued < NUM_REQS_PER_SUBMITTER) {
+    s->queued++;
+    ASSERT(0 == uv_queue_work(&s->loop, req, work_cb, after_work_cb));
+  }
+}
+
+
+static void submitter_cb(void* arg) {
+  struct submitter* s;
+  unsigned int i;
+
+  s = arg;
+  for (i = 0; i < NUM_IN_FLIGHT; i++) {
+    s->reqs[i].data = s;
+    s->queued++;
+    ASSERT(0 == uv_queue_work(&s->loop, s->reqs + i, work_cb, after_work_cb));
+  }
+
+  ASSERT(0 == uv_run(&s->loop, UV_RUN_DEFAULT));
+}
+
+
+static int threadpool_contention(const char* work_stealing) {
+  uv_cpu_info_t* cpus;
+  char nthreads[16];
+  size_t size;
+  uint64_t start;
+  uint64_t duration;
+  unsigned int total;
+  int ncpus;
+  int i;
+
+  /* The threadpool reads these when it is started by the first request. */
+  ASSERT(0 == uv_os_setenv("UV_THREADPOOL_WORK_STEALING", work_stealing));
+  size = sizeof(nthreads);
+  if (uv_os_getenv("UV_THREADPOOL_SIZE", nthreads, &size) == UV_ENOENT) {
+    ASSERT(0 == uv_cpu_info(&cpus, &ncpus));
+    uv_free_cpu_info(cpus, ncpus);
+    snprintf(nthreads, sizeof(nthreads), "%d", ncpus > 128 ? 128 : ncpus);
+    ASSERT(0 == uv_os_setenv("UV_THREADPOOL_SIZE", nthreads));
+  }
+
+  for (i = 0; i < NUM_SUBMITTERS; i++)
+    ASSERT(0 == uv_loop_init(&submitters[i].loop));
+
+  start = uv_hrtime();
+  for (i = 0; i < NUM_SUBMITTERS; i++)
+    ASSERT(0 == uv_thread_create(&submitters[i].thread,
+                                 submitter_cb,
+                                 submitters + i));
+
+  total = 0;
+  for (i = 0; i < NUM_SUBMITTERS; i++) {
+    ASSERT(0 == uv_thread_join(&submitters[i].thread));
+    ASSERT(submitters[i].done == NUM_REQS_PER_SUBMITTER);
+    total += submitters[i].done;
+  }
+  duration = uv_hrtime() - start;
+
+  for (i = 0; i < NUM_SUBMITTERS; i++)
+    ASSERT(0 == uv_loop_close(&submitters[i].loop));
+
+  fprintf(stderr,
+          "threadpool_contention (%s, %s threads): %s reqs/s\n",
+          work_stealing[0] == '1' ? "work stealing" : "shared queue",
+          nthreads,
+          fmt(total / (duration / 1e9)));
+  fflush(stderr);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+BENCHMARK_IMPL(threadpool_contention) {
+  return threadpool_contention("0");
+}
+
+
+BENCHMARK_IMPL(threadpool_contention_work_stealing) {
+  return threadpool_contention("1");
+}
@@ -48,6 +48,11 @@ static void handle_result(uv_fs_t* req) {
 
   ASSERT(req->fs_type == UV_FS_COPYFILE);
   ASSERT(req->result == 0);
+  ASSERT(uv_fs_get_copyfile_method(req) != UV_FS_COPYFILE_METHOD_UNKNOWN);
+#if defined(__linux__)
+  /* Plain copies never use the platform copy on Linux. */
+  ASSERT(uv_fs_get_copyfile_method(req) != UV_FS_COPYFILE_METHOD_SYSTEM);
+#endif
 
   /* Verify that the file size and mode are the same. */
   r = uv_fs_stat(NULL, &stat_req, req->path, NULL);
@@ -112,6 +117,7 @@ TEST_IMPL(fs_copyfile) {
   r = uv_fs_copyfile(NULL, &req, src, dst, 0, NULL);
   ASSERT(req.result == UV_ENOENT);
   ASSERT(r == UV_ENOENT);
+  ASSERT(uv_fs_get_copyfile_method(&req) == UV_FS_COPYFILE_METHOD_UNKNOWN);
   uv_fs_req_cleanup(&req);
   /* The destination should not exist. */
   r = uv_fs_stat(NULL, &req, dst, NULL);
@@ -129,6 +135,10 @@ TEST_IMPL(fs_copyfile) {
   touch_file(src, 0);
   r = uv_fs_copyfile(NULL, &req, src, dst, 0, NULL);
   ASSERT(r == 0);
+#if defined(__linux__)
+  /* There was nothing to copy, no copy mechanism was used. */
+  ASSERT(uv_fs_get_copyfile_method(&req) == UV_FS_COPYFILE_METHOD_NONE);
+#endif
   handle_result(&req);
 
   /* Copies file synchronously. Overwrites existing file. */
@@ -181,8 +191,12 @@ TEST_IMPL(fs_copyfile) {
                      NULL);
   ASSERT(r == 0 || r == UV_ENOSYS || r == UV_ENOTSUP);
 
-  if (r == 0)
+  if (r == 0) {
+#if defined(__linux__)
+    ASSERT(uv_fs_get_copyfile_method(&req) == UV_FS_COPYFILE_METHOD_CLONE);
+#endif
     handle_result(&req);
+  }
 
   unlink(dst); /* Cleanup */
   return 0;
@@ -0,0 +1,282 @@
+/* Copyright libuv project contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "uv.h"
+#include "task.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/wait.h>
+
+/* Exercises the io_uring submission path.  The requests below must produce
+ * the same results whether the kernel supports io_uring or libuv silently
+ * falls back to the threadpool; when the ring is there they must have been
+ * served by it.
+ */
+
+static const char path[] = "test_file_io_uring";
+static const char missing[] = "test_file_io_uring_missing";
+static char data[] = "hello io_uring";
+static char buf[64];
+static uv_loop_t loop;
+static uv_fs_t req;
+static uv_file file;
+static int done_cb_called;
+static int ring_cb_called;
+
+
+/* Requests that went through the ring never get a work function. */
+static void check_ring(uv_fs_t* req) {
+  if (loop.io_uring == NULL)
+    return;
+  ASSERT(req->work_req.work == NULL);
+  ring_cb_called++;
+}
+
+
+static void init_ring_loop(void) {
+  ASSERT(0 == setenv("UV_USE_IO_URING", "1", 1));
+  ASSERT(0 == uv_loop_init(&loop));
+  ASSERT(0 == unsetenv("UV_USE_IO_URING"));
+}
+
+
+static void lstat_cb(uv_fs_t* req);
+static void close_cb(uv_fs_t* req);
+static void stat_cb(uv_fs_t* req);
+static void read_cb(uv_fs_t* req);
+static void fstat_cb(uv_fs_t* req);
+static void fsync_cb(uv_fs_t* req);
+static void write_cb(uv_fs_t* req);
+
+
+static void lstat_cb(uv_fs_t* req) {
+  ASSERT(req->fs_type == UV_FS_LSTAT);
+  check_ring(req);
+  ASSERT(req->result == UV_ENOENT);
+  uv_fs_req_cleanup(req);
+  done_cb_called++;
+}
+
+
+static void close_cb(uv_fs_t* req) {
+  ASSERT(req->fs_type == UV_FS_CLOSE);
+  check_ring(req);
+  ASSERT(req->result == 0);
+  uv_fs_req_cleanup(req);
+  ASSERT(0 == uv_fs_lstat(&loop, req, missing, lstat_cb));
+}
+
+
+static void stat_cb(uv_fs_t* req) {
+  ASSERT(req->fs_type == UV_FS_STAT);
+  check_ring(req);
+  ASSERT(req->result == 0);
+  ASSERT(req->ptr == &req->statbuf);
+  ASSERT(req->statbuf.st_size == sizeof(data));
+  ASSERT((req->statbuf.st_mode & S_IFMT) == S_IFREG);
+  uv_fs_req_cleanup(req);
+  ASSERT(0 == uv_fs_close(&loop, req, file, close_cb));
+}
+
+
+static void read_cb(uv_fs_t* req) {
+  ASSERT(req->fs_type == UV_FS_READ);
+  check_ring(req);
+  ASSERT(req->result == sizeof(data));
+  ASSERT(0 == memcmp(buf, data, sizeof(data)));
+  uv_fs_req_cleanup(req);
+  ASSERT(0 == uv_fs_stat(&loop, req, path, stat_cb));
+}
+
+
+static void fstat_cb(uv_fs_t* req) {
+  uv_buf_t iov;
+
+  ASSERT(req->fs_type == UV_FS_FSTAT);
+  check_ring(req);
+  ASSERT(req->result == 0);
+  ASSERT(req->statbuf.st_size == sizeof(data));
+  ASSERT(req->statbuf.st_nlink == 1);
+  uv_fs_req_cleanup(req);
+
+  iov = uv_buf_init(buf, sizeof(buf));
+  ASSERT(0 == uv_fs_read(&loop, req, file, &iov, 1, 0, read_cb));
+}
+
+
+static void fsync_cb(uv_fs_t* req) {
+  ASSERT(req->fs_type == UV_FS_FDATASYNC);
+  check_ring(req);
+  ASSERT(req->result == 0);
+  uv_fs_req_cleanup(req);
+  ASSERT(0 == uv_fs_fstat(&loop, req, file, fstat_cb));
+}
+
+
+static void write_cb(uv_fs_t* req) {
+  ASSERT(req->fs_type == UV_FS_WRITE);
+  check_ring(req);
+  ASSERT(req->result == sizeof(data));
+  uv_fs_req_cleanup(req);
+  ASSERT(0 == uv_fs_fdatasync(&loop, req, file, fsync_cb));
+}
+
+
+static void open_cb(uv_fs_t* req) {
+  uv_buf_t iov;
+
+  ASSERT(req->fs_type == UV_FS_OPEN);
+  check_ring(req);
+  ASSERT(req->result >= 0);
+  file = req->result;
+  uv_fs_req_cleanup(req);
+
+  iov = uv_buf_init(data, sizeof(data));
+  ASSERT(0 == uv_fs_write(&loop, req, file, &iov, 1, 0, write_cb));
+}
+
+
+static void cancel_cb(uv_fs_t* req) {
+  ASSERT(req->fs_type == UV_FS_STAT);
+  ASSERT(req->result == UV_ECANCELED);
+  ASSERT(req->ptr == NULL);
+  uv_fs_req_cleanup(req);
+  done_cb_called++;
+}
+
+
+static void fork_read_cb(uv_fs_t* req) {
+  ASSERT(req->fs_type == UV_FS_READ);
+  ASSERT(req->result == 1 || req->result == UV_ECANCELED);
+  uv_fs_req_cleanup(req);
+  done_cb_called++;
+}
+#endif
+
+
+TEST_IMPL(fs_io_uring) {
+#ifndef __linux__
+  RETURN_SKIP("io_uring is Linux-only");
+#else
+  unlink(path);
+  unlink(missing);
+
+  init_ring_loop();
+
+  ASSERT(0 == uv_fs_open(&loop,
+                         &req,
+                         path,
+                         O_RDWR | O_CREAT | O_TRUNC,
+                         S_IRUSR | S_IWUSR,
+                         open_cb));
+  ASSERT(0 == uv_run(&loop, UV_RUN_DEFAULT));
+  ASSERT(1 == done_cb_called);
+  if (loop.io_uring != NULL)
+    ASSERT(8 == ring_cb_called);
+
+  unlink(path);
+  ASSERT(0 == uv_loop_close(&loop));
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+#endif
+}
+
+
+TEST_IMPL(fs_io_uring_cancel) {
+#ifndef __linux__
+  RETURN_SKIP("io_uring is Linux-only");
+#else
+  init_ring_loop();
+  if (loop.io_uring == NULL) {
+    ASSERT(0 == uv_loop_close(&loop));
+    RETURN_SKIP("io_uring is not available");
+  }
+
+  /* Queued in the ring, but not submitted until the loop runs. */
+  ASSERT(0 == uv_fs_stat(&loop, &req, ".", cancel_cb));
+  ASSERT(req.work_req.work == NULL);
+  ASSERT(0 == uv_cancel((uv_req_t*) &req));
+  ASSERT(0 == uv_run(&loop, UV_RUN_DEFAULT));
+  ASSERT(1 == done_cb_called);
+
+  ASSERT(0 == uv_loop_close(&loop));
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+#endif
+}
+
+
+TEST_IMPL(fs_io_uring_fork) {
+#ifndef __linux__
+  RETURN_SKIP("io_uring is Linux-only");
+#else
+  uv_buf_t iov;
+  pid_t child_pid;
+  pid_t waited_pid;
+  int child_stat;
+  int fds[2];
+
+  init_ring_loop();
+  if (loop.io_uring == NULL) {
+    ASSERT(0 == uv_loop_close(&loop));
+    RETURN_SKIP("io_uring is not available");
+  }
+
+  /* A read from an empty pipe stays in flight in the kernel. */
+  ASSERT(0 == pipe(fds));
+  iov = uv_buf_init(buf, 1);
+  ASSERT(0 == uv_fs_read(&loop, &req, fds[0], &iov, 1, -1, fork_read_cb));
+  ASSERT(1 == uv_run(&loop, UV_RUN_NOWAIT));
+  ASSERT(0 == done_cb_called);
+
+  child_pid = fork();
+  ASSERT(child_pid != -1);
+
+  if (child_pid == 0) {
+    /* The read belongs to the parent's ring, the child gets it cancelled. */
+    ASSERT(0 == uv_loop_fork(&loop));
+    ASSERT(0 == uv_run(&loop, UV_RUN_DEFAULT));
+    ASSERT(1 == done_cb_called);
+    ASSERT(req.result == UV_ECANCELED);
+  } else {
+    waited_pid = waitpid(child_pid, &child_stat, 0);
+    ASSERT(waited_pid == child_pid);
+    ASSERT(WIFEXITED(child_stat));
+    ASSERT(0 == WEXITSTATUS(child_stat));
+
+    ASSERT(1 == write(fds[1], "x", 1));
+    ASSERT(0 == uv_run(&loop, UV_RUN_DEFAULT));
+    ASSERT(1 == done_cb_called);
+    ASSERT(req.result == 1);
+  }
+
+  close(fds[0]);
+  close(fds[1]);
+  ASSERT(0 == uv_loop_close(&loop));
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+#endif
+}
@@ -33,6 +33,9 @@ TEST_DECLARE   (loop_stop)
 TEST_DECLARE   (loop_update_time)
 TEST_DECLARE   (loop_backend_timeout)
 TEST_DECLARE   (loop_configure)
+TEST_DECLARE   (loop_busy_poll)
+TEST_DECLARE   (metrics_idle_time)
+TEST_DECLARE   (metrics_idle_time_disabled)
 TEST_DECLARE   (default_loop_close)
 TEST_DECLARE   (barrier_1)
 TEST_DECLARE   (barrier_2)
@@ -92,6 +95,7 @@ TEST_DECLARE   (tcp_open_connected)
 TEST_DECLARE   (tcp_connect_error_after_write)
 TEST_DECLARE   (tcp_shutdown_after_write)
 TEST_DECLARE   (tcp_bind_error_addrinuse)
+TEST_DECLARE   (tcp_reuseport)
 TEST_DECLARE   (tcp_bind_error_addrnotavail_1)
 TEST_DECLARE   (tcp_bind_error_addrnotavail_2)
 TEST_DECLARE   (tcp_bind_error_fault)
@@ -146,6 +150,8 @@ TEST_DECLARE   (udp_no_autobind)
 TEST_DECLARE   (udp_open)
 TEST_DECLARE   (udp_open_twice)
 TEST_DECLARE   (udp_try_send)
+TEST_DECLARE   (udp_mmsg)
+TEST_DECLARE   (udp_mmsg_send_queue)
 TEST_DECLARE   (pipe_bind_error_addrinuse)
 TEST_DECLARE   (pipe_bind_error_addrnotavail)
 TEST_DECLARE   (pipe_bind_error_inval)
@@ -181,6 +187,8 @@ TEST_DECLARE   (timer_run_once)
 TEST_DECLARE   (timer_from_check)
 TEST_DECLARE   (timer_null_callback)
 TEST_DECLARE   (timer_early_check)
+TEST_DECLARE   (timer_wheel)
+TEST_DECLARE   (timer_wheel_migrate)
 TEST_DECLARE   (idle_starvation)
 TEST_DECLARE   (loop_handles)
 TEST_DECLARE   (get_loadavg)
@@ -288,6 +296,9 @@ TEST_DECLARE   (fs_fstat)
 TEST_DECLARE   (fs_access)
 TEST_DECLARE   (fs_chmod)
 TEST_DECLARE   (fs_copyfile)
+TEST_DECLARE   (fs_io_uring)
+TEST_DECLARE   (fs_io_uring_cancel)
+TEST_DECLARE   (fs_io_uring_fork)
 TEST_DECLARE   (fs_unlink_readonly)
 #ifdef _WIN32
 TEST_DECLARE   (fs_unlink_archive_readonly)
@@ -354,6 +365,13 @@ TEST_DECLARE   (threadpool_cancel_getnameinfo)
 TEST_DECLARE   (threadpool_cancel_work)
 TEST_DECLARE   (threadpool_cancel_fs)
 TEST_DECLARE   (threadpool_cancel_single)
+TEST_DECLARE   (threadpool_class_share)
+TEST_DECLARE   (threadpool_class_priority)
+TEST_DECLARE   (threadpool_class_einval)
+TEST_DECLARE   (threadpool_work_stealing)
+TEST_DECLARE   (threadpool_work_stealing_cancel)
+TEST_DECLARE   (threadpool_set_size)
+TEST_DECLARE   (threadpool_stats)
 TEST_DECLARE   (thread_local_storage)
 TEST_DECLARE   (thread_stack_size)
 TEST_DECLARE   (thread_mutex)
@@ -452,6 +470,9 @@ TASK_LIST_START
   TEST_ENTRY  (loop_update_time)
   TEST_ENTRY  (loop_backend_timeout)
   TEST_ENTRY  (loop_configure)
+  TEST_ENTRY  (loop_busy_poll)
+  TEST_ENTRY  (metrics_idle_time)
+  TEST_ENTRY  (metrics_idle_time_disabled)
   TEST_ENTRY  (default_loop_close)
   TEST_ENTRY  (barrier_1)
   TEST_ENTRY  (barrier_2)
@@ -555,6 +576,7 @@ TASK_LIST_START
 
   TEST_ENTRY  (tcp_connect_error_after_write)
   TEST_ENTRY  (tcp_bind_error_addrinuse)
+  TEST_ENTRY  (tcp_reuseport)
   TEST_ENTRY  (tcp_bind_error_addrnotavail_1)
   TEST_ENTRY  (tcp_bind_error_addrnotavail_2)
   TEST_ENTRY  (tcp_bind_error_fault)
@@ -610,6 +632,8 @@ TASK_LIST_START
   TEST_ENTRY  (udp_multicast_join6)
   TEST_ENTRY  (udp_multicast_ttl)
   TEST_ENTRY  (udp_try_send)
+  TEST_ENTRY  (udp_mmsg)
+  TEST_ENTRY  (udp_mmsg_send_queue)
 
   TEST_ENTRY  (udp_open)
   TEST_HELPER (udp_open, udp4_echo_server)
@@ -659,6 +683,8 @@ TASK_LIST_START
   TEST_ENTRY  (timer_from_check)
   TEST_ENTRY  (timer_null_callback)
   TEST_ENTRY  (timer_early_check)
+  TEST_ENTRY  (timer_wheel)
+  TEST_ENTRY  (timer_wheel_migrate)
 
   TEST_ENTRY  (idle_starvation)
 
@@ -837,6 +863,9 @@ TASK_LIST_START
   TEST_ENTRY  (fs_access)
   TEST_ENTRY  (fs_chmod)
   TEST_ENTRY  (fs_copyfile)
+  TEST_ENTRY  (fs_io_uring)
+  TEST_ENTRY  (fs_io_uring_cancel)
+  TEST_ENTRY  (fs_io_uring_fork)
   TEST_ENTRY  (fs_unlink_readonly)
 #ifdef _WIN32
   TEST_ENTRY  (fs_unlink_archive_readonly)
@@ -902,6 +931,13 @@ TASK_LIST_START
   TEST_ENTRY  (threadpool_cancel_work)
   TEST_ENTRY  (threadpool_cancel_fs)
   TEST_ENTRY  (threadpool_cancel_single)
+  TEST_ENTRY  (threadpool_class_share)
+  TEST_ENTRY  (threadpool_class_priority)
+  TEST_ENTRY  (threadpool_class_einval)
+  TEST_ENTRY  (threadpool_work_stealing)
+  TEST_ENTRY  (threadpool_work_stealing_cancel)
+  TEST_ENTRY  (threadpool_set_size)
+  TEST_ENTRY  (threadpool_stats)
   TEST_ENTRY  (thread_local_storage)
   TEST_ENTRY  (thread_stack_size)
   TEST_ENTRY  (thread_mutex)
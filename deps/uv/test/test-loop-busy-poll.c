@@ -0,0 +1,106 @@
+/* Copyright Joyent, Inc. and other Node contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include "uv.h"
+#include "task.h"
+
+#ifdef __linux__
+
+static uv_async_t async_handle;
+static uv_timer_t timer_handle;
+static int async_cb_called;
+static int timer_cb_called;
+
+
+static void async_cb(uv_async_t* handle) {
+  async_cb_called++;
+  uv_close((uv_handle_t*) handle, NULL);
+}
+
+
+static void timer_cb(uv_timer_t* handle) {
+  timer_cb_called++;
+  uv_close((uv_handle_t*) handle, NULL);
+}
+
+
+static void thread_cb(void* arg) {
+  uv_sleep(1);
+  ASSERT(0 == uv_async_send(&async_handle));
+}
+
+
+TEST_IMPL(loop_busy_poll) {
+  uv_busy_poll_stats_t stats;
+  uv_thread_t thread;
+  uv_loop_t loop;
+
+  ASSERT(0 == uv_loop_init(&loop));
+  ASSERT(0 == uv_loop_busy_poll_stats(&loop, &stats));
+  ASSERT(stats.budget == 0);
+  ASSERT(stats.polls == 0);
+
+  /* An event that arrives within the budget is picked up by spinning. The
+   * budget is generous because the thread that sends it has to be scheduled
+   * while the loop thread is spinning.
+   */
+  ASSERT(0 == uv_loop_configure(&loop, UV_LOOP_BUSY_POLL, 5000000u));
+  ASSERT(0 == uv_async_init(&loop, &async_handle, async_cb));
+  ASSERT(0 == uv_thread_create(&thread, thread_cb, NULL));
+  ASSERT(0 == uv_run(&loop, UV_RUN_DEFAULT));
+  ASSERT(0 == uv_thread_join(&thread));
+  ASSERT(async_cb_called == 1);
+
+  ASSERT(0 == uv_loop_busy_poll_stats(&loop, &stats));
+  ASSERT(stats.budget == 5000000u);
+  ASSERT(stats.hits >= 1);
+  ASSERT(stats.polls >= stats.hits);
+
+  /* A short budget runs out and the loop blocks until the timer expires. */
+  ASSERT(0 == uv_loop_configure(&loop, UV_LOOP_BUSY_POLL, 10u));
+  ASSERT(0 == uv_timer_init(&loop, &timer_handle));
+  ASSERT(0 == uv_timer_start(&timer_handle, timer_cb, 50, 0));
+  ASSERT(0 == uv_run(&loop, UV_RUN_DEFAULT));
+  ASSERT(timer_cb_called == 1);
+
+  ASSERT(0 == uv_loop_busy_poll_stats(&loop, &stats));
+  ASSERT(stats.budget == 10u);
+  ASSERT(stats.blocks >= 1);
+
+  ASSERT(0 == uv_loop_close(&loop));
+  return 0;
+}
+
+#else
+
+TEST_IMPL(loop_busy_poll) {
+  uv_busy_poll_stats_t stats;
+  uv_loop_t loop;
+
+  ASSERT(0 == uv_loop_init(&loop));
+  ASSERT(UV_ENOSYS == uv_loop_configure(&loop, UV_LOOP_BUSY_POLL, 100u));
+  ASSERT(UV_ENOSYS == uv_loop_busy_poll_stats(&loop, &stats));
+  ASSERT(0 == uv_loop_close(&loop));
+  return 0;
+}
+
+#endif
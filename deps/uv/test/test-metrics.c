@@ -0,0 +1,87 @@
+/* Copyright Joyent, Inc. and other Node contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include "uv.h"
+#include "task.h"
+
+#define TIMEOUT 100
+#define NS_PER_MS 1000000
+
+static int timer_cb_called;
+
+
+static void timer_cb(uv_timer_t* handle) {
+  timer_cb_called++;
+}
+
+
+static void busy_timer_cb(uv_timer_t* handle) {
+  uint64_t start;
+
+  /* Time spent in callbacks is not idle time. */
+  start = uv_hrtime();
+  while (uv_hrtime() - start < TIMEOUT * NS_PER_MS)
+    ;
+
+  timer_cb_called++;
+}
+
+
+TEST_IMPL(metrics_idle_time) {
+  uv_timer_t timer;
+  uint64_t idle_time;
+
+  ASSERT(0 == uv_loop_configure(uv_default_loop(), UV_METRICS_IDLE_TIME));
+  ASSERT(0 == uv_metrics_idle_time(uv_default_loop()));
+
+  ASSERT(0 == uv_timer_init(uv_default_loop(), &timer));
+  ASSERT(0 == uv_timer_start(&timer, timer_cb, TIMEOUT, 0));
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+  ASSERT(timer_cb_called == 1);
+
+  idle_time = uv_metrics_idle_time(uv_default_loop());
+  ASSERT(idle_time >= (TIMEOUT - 10) * NS_PER_MS);
+  ASSERT(idle_time <= (TIMEOUT + 500) * NS_PER_MS);
+
+  ASSERT(0 == uv_timer_start(&timer, busy_timer_cb, 0, 0));
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+  ASSERT(timer_cb_called == 2);
+  ASSERT(uv_metrics_idle_time(uv_default_loop()) - idle_time <
+         (TIMEOUT / 2) * NS_PER_MS);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+TEST_IMPL(metrics_idle_time_disabled) {
+  uv_timer_t timer;
+
+  ASSERT(0 == uv_timer_init(uv_default_loop(), &timer));
+  ASSERT(0 == uv_timer_start(&timer, timer_cb, 10, 0));
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+  ASSERT(timer_cb_called == 1);
+  ASSERT(0 == uv_metrics_idle_time(uv_default_loop()));
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
@@ -0,0 +1,116 @@
+/* Copyright Joyent, Inc. and other Node contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "uv.h"
+#include "task.h"
+
+static uv_tcp_t servers[3];
+static uv_tcp_t client;
+static uv_tcp_t conn;
+static uv_connect_t connect_req;
+static int connection_cb_called;
+static int connect_cb_called;
+static int close_cb_called;
+
+
+static void close_cb(uv_handle_t* handle) {
+  close_cb_called++;
+}
+
+
+static void close_all(void) {
+  uv_close((uv_handle_t*) &servers[0], close_cb);
+  uv_close((uv_handle_t*) &servers[1], close_cb);
+  uv_close((uv_handle_t*) &servers[2], close_cb);
+}
+
+
+static void connection_cb(uv_stream_t* server, int status) {
+  ASSERT(status == 0);
+  ASSERT(server == (uv_stream_t*) &servers[0] ||
+         server == (uv_stream_t*) &servers[1]);
+
+  ASSERT(0 == uv_tcp_init(server->loop, &conn));
+  ASSERT(0 == uv_accept(server, (uv_stream_t*) &conn));
+  uv_close((uv_handle_t*) &conn, close_cb);
+
+  connection_cb_called++;
+  if (connect_cb_called == 1)
+    close_all();
+}
+
+
+static void connect_cb(uv_connect_t* req, int status) {
+  ASSERT(status == 0);
+  uv_close((uv_handle_t*) req->handle, close_cb);
+
+  connect_cb_called++;
+  if (connection_cb_called == 1)
+    close_all();
+}
+
+
+TEST_IMPL(tcp_reuseport) {
+  struct sockaddr_in addr;
+  uv_loop_t* loop;
+  int r;
+  int i;
+
+  loop = uv_default_loop();
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+
+  for (i = 0; i < 3; i++)
+    ASSERT(0 == uv_tcp_init(loop, &servers[i]));
+
+  r = uv_tcp_bind(&servers[0], (const struct sockaddr*) &addr, UV_TCP_REUSEPORT);
+  if (r == UV_ENOTSUP) {
+    close_all();
+    ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+    RETURN_SKIP("SO_REUSEPORT is not supported on this platform");
+  }
+  ASSERT(r == 0);
+
+  /* Other sockets can join if they ask for it, */
+  r = uv_tcp_bind(&servers[1], (const struct sockaddr*) &addr, UV_TCP_REUSEPORT);
+  ASSERT(r == 0);
+  ASSERT(0 == uv_listen((uv_stream_t*) &servers[0], 128, connection_cb));
+  ASSERT(0 == uv_listen((uv_stream_t*) &servers[1], 128, connection_cb));
+
+  /* but not if they don't. */
+  r = uv_tcp_bind(&servers[2], (const struct sockaddr*) &addr, 0);
+  if (r == 0)
+    r = uv_listen((uv_stream_t*) &servers[2], 128, connection_cb);
+  ASSERT(r == UV_EADDRINUSE);
+
+  ASSERT(0 == uv_tcp_init(loop, &client));
+  ASSERT(0 == uv_tcp_connect(&connect_req,
+                             &client,
+                             (const struct sockaddr*) &addr,
+                             connect_cb));
+
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(connection_cb_called == 1);
+  ASSERT(connect_cb_called == 1);
+  ASSERT(close_cb_called == 5);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
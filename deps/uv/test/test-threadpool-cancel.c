@@ -43,9 +43,11 @@ static unsigned done2_cb_called;
 static unsigned timer_cb_called;
 static uv_work_t pause_reqs[4];
 static uv_sem_t pause_sems[ARRAY_SIZE(pause_reqs)];
+static uv_sem_t started_sem;
 
 
 static void work_cb(uv_work_t* req) {
+  uv_sem_post(&started_sem);
   uv_sem_wait(pause_sems + (req - pause_reqs));
 }
 
@@ -67,10 +69,18 @@ static void saturate_threadpool(void) {
   putenv(buf);
 
   loop = uv_default_loop();
+  ASSERT(0 == uv_sem_init(&started_sem, 0));
   for (i = 0; i < ARRAY_SIZE(pause_reqs); i += 1) {
     ASSERT(0 == uv_sem_init(pause_sems + i, 0));
     ASSERT(0 == uv_queue_work(loop, pause_reqs + i, work_cb, done_cb));
   }
+
+  /* Work of other classes can be picked up ahead of the pause requests, wait
+   * until they really occupy every thread.
+   */
+  for (i = 0; i < ARRAY_SIZE(pause_reqs); i += 1)
+    uv_sem_wait(&started_sem);
+  uv_sem_destroy(&started_sem);
 }
 
 
@@ -243,8 +253,16 @@ TEST_IMPL(threadpool_cancel_fs) {
   unsigned n;
   uv_buf_t iov;
 
-  INIT_CANCEL_INFO(&ci, reqs);
   loop = uv_default_loop();
+#ifdef __linux__
+  /* Requests that go through io_uring don't wait for the threadpool, they
+   * have long completed when the timer fires.
+   */
+  if (loop->io_uring != NULL)
+    RETURN_SKIP("File system requests go through io_uring");
+#endif
+
+  INIT_CANCEL_INFO(&ci, reqs);
   saturate_threadpool();
   iov = uv_buf_init(NULL, 0);
 
@@ -0,0 +1,228 @@
+/* Copyright Joyent, Inc. and other Node contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "uv.h"
+#include "task.h"
+
+#include <stdlib.h>
+
+#define NUM_USER_WORK 4
+
+static uv_sem_t started;
+static uv_sem_t release;
+static uv_mutex_t lock;
+static unsigned int running;
+static unsigned int max_running;
+static int after_work_cb_count;
+static int order[NUM_USER_WORK + 2];
+static int order_count;
+
+static uv_work_t user_reqs[NUM_USER_WORK];
+static uv_work_t fs_req;
+static uv_work_t cpu_req;
+static uv_work_t* fs_reqs;
+
+
+static void record(uv_work_t* req) {
+  uv_mutex_lock(&lock);
+  order[order_count++] = (int) (intptr_t) req->data;
+  uv_mutex_unlock(&lock);
+}
+
+
+static void after_work_cb(uv_work_t* req, int status) {
+  ASSERT(status == 0);
+  after_work_cb_count++;
+}
+
+
+static void share_user_work_cb(uv_work_t* req) {
+  uv_mutex_lock(&lock);
+  running++;
+  if (running > max_running)
+    max_running = running;
+  uv_mutex_unlock(&lock);
+
+  /* The first request holds on to the only USER thread until the FS
+   * request has run.
+   */
+  if (req == &user_reqs[0])
+    uv_sem_wait(&release);
+  else
+    uv_sleep(5);
+
+  record(req);
+
+  uv_mutex_lock(&lock);
+  running--;
+  uv_mutex_unlock(&lock);
+}
+
+
+static void share_fs_work_cb(uv_work_t* req) {
+  record(req);
+  uv_sem_post(&release);
+}
+
+
+TEST_IMPL(threadpool_class_share) {
+  unsigned int nthreads;
+  unsigned int share;
+  int priority;
+  int i;
+
+  ASSERT(0 == uv_threadpool_get_class(UV_WORK_CLASS_FS, &nthreads, NULL));
+  if (nthreads < 2)
+    RETURN_SKIP("Needs a threadpool with at least two threads.");
+
+  ASSERT(0 == uv_sem_init(&release, 0));
+  ASSERT(0 == uv_mutex_init(&lock));
+
+  ASSERT(0 == uv_threadpool_set_class(UV_WORK_CLASS_USER, 1, 0));
+  ASSERT(0 == uv_threadpool_get_class(UV_WORK_CLASS_USER, &share, &priority));
+  ASSERT(share == 1);
+  ASSERT(priority == 0);
+
+  for (i = 0; i < NUM_USER_WORK; i++) {
+    user_reqs[i].data = (void*) (intptr_t) (i + 1);
+    ASSERT(0 == uv_queue_work(uv_default_loop(),
+                              &user_reqs[i],
+                              share_user_work_cb,
+                              after_work_cb));
+  }
+
+  /* Runs on one of the threads that the USER class may not use. */
+  fs_req.data = (void*) (intptr_t) 0;
+  ASSERT(0 == uv_queue_work_ex(uv_default_loop(),
+                               &fs_req,
+                               UV_WORK_CLASS_FS,
+                               share_fs_work_cb,
+                               after_work_cb));
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+
+  ASSERT(after_work_cb_count == NUM_USER_WORK + 1);
+  ASSERT(max_running == 1);
+  ASSERT(order_count == NUM_USER_WORK + 1);
+  ASSERT(order[0] == 0);
+
+  uv_sem_destroy(&release);
+  uv_mutex_destroy(&lock);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+static void blocking_work_cb(uv_work_t* req) {
+  uv_sem_post(&started);
+  uv_sem_wait(&release);
+}
+
+
+static void priority_work_cb(uv_work_t* req) {
+  record(req);
+}
+
+
+TEST_IMPL(threadpool_class_priority) {
+  unsigned int nthreads;
+  unsigned int i;
+
+  ASSERT(0 == uv_sem_init(&started, 0));
+  ASSERT(0 == uv_sem_init(&release, 0));
+  ASSERT(0 == uv_mutex_init(&lock));
+
+  ASSERT(0 == uv_threadpool_set_class(UV_WORK_CLASS_CPU, 0, 5));
+  ASSERT(0 == uv_threadpool_set_class(UV_WORK_CLASS_USER, 0, 0));
+  ASSERT(0 == uv_threadpool_get_class(UV_WORK_CLASS_FS, &nthreads, NULL));
+  ASSERT(nthreads > 0);
+
+  /* Occupy every thread in the pool. */
+  fs_reqs = malloc(nthreads * sizeof(*fs_reqs));
+  ASSERT(fs_reqs != NULL);
+  for (i = 0; i < nthreads; i++)
+    ASSERT(0 == uv_queue_work_ex(uv_default_loop(),
+                                 &fs_reqs[i],
+                                 UV_WORK_CLASS_FS,
+                                 blocking_work_cb,
+                                 after_work_cb));
+  for (i = 0; i < nthreads; i++)
+    uv_sem_wait(&started);
+
+  /* Queued first, but the CPU class has the higher priority. */
+  user_reqs[0].data = (void*) (intptr_t) 1;
+  ASSERT(0 == uv_queue_work(uv_default_loop(),
+                            &user_reqs[0],
+                            priority_work_cb,
+                            after_work_cb));
+  cpu_req.data = (void*) (intptr_t) 2;
+  ASSERT(0 == uv_queue_work_ex(uv_default_loop(),
+                               &cpu_req,
+                               UV_WORK_CLASS_CPU,
+                               priority_work_cb,
+                               after_work_cb));
+
+  /* Free up a single thread, it has to pick the CPU request first. */
+  uv_sem_post(&release);
+  for (;;) {
+    uv_mutex_lock(&lock);
+    i = order_count;
+    uv_mutex_unlock(&lock);
+    if (i == 2)
+      break;
+    uv_sleep(1);
+  }
+
+  for (i = 1; i < nthreads; i++)
+    uv_sem_post(&release);
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+
+  ASSERT(after_work_cb_count == (int) nthreads + 2);
+  ASSERT(order[0] == 2);
+  ASSERT(order[1] == 1);
+
+  free(fs_reqs);
+  uv_sem_destroy(&started);
+  uv_sem_destroy(&release);
+  uv_mutex_destroy(&lock);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+TEST_IMPL(threadpool_class_einval) {
+  uv_work_t req;
+
+  ASSERT(UV_EINVAL == uv_queue_work_ex(uv_default_loop(),
+                                       &req,
+                                       UV_WORK_CLASS_MAX,
+                                       priority_work_cb,
+                                       NULL));
+  ASSERT(UV_EINVAL == uv_threadpool_set_class(UV_WORK_CLASS_MAX, 0, 0));
+  ASSERT(UV_EINVAL == uv_threadpool_set_class(UV_WORK_CLASS_CPU, 1025, 0));
+  ASSERT(UV_EINVAL == uv_threadpool_get_class(UV_WORK_CLASS_MAX, NULL, NULL));
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
@@ -0,0 +1,160 @@
+/* Copyright Joyent, Inc. and other Node contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include "uv.h"
+#include "task.h"
+
+#define NUM_WORK 8
+
+static uv_sem_t started;
+static uv_sem_t release;
+static uv_work_t reqs[NUM_WORK];
+static int after_work_cb_count;
+
+
+static void blocking_work_cb(uv_work_t* req) {
+  uv_sem_post(&started);
+  uv_sem_wait(&release);
+}
+
+
+static void sleeping_work_cb(uv_work_t* req) {
+  uv_sleep(2);
+}
+
+
+static void after_work_cb(uv_work_t* req, int status) {
+  ASSERT(status == 0);
+  after_work_cb_count++;
+}
+
+
+/* Runs NUM_WORK requests that can only all finish if they run at the same
+ * time, which takes NUM_WORK threads.
+ */
+static void run_concurrently(uv_loop_t* loop) {
+  uv_threadpool_stats_t stats;
+  int i;
+
+  after_work_cb_count = 0;
+  for (i = 0; i < NUM_WORK; i++)
+    ASSERT(0 == uv_queue_work(loop, &reqs[i], blocking_work_cb, after_work_cb));
+
+  for (i = 0; i < NUM_WORK; i++)
+    uv_sem_wait(&started);
+
+  ASSERT(0 == uv_threadpool_get_stats(&stats));
+  ASSERT(stats.classes[UV_WORK_CLASS_USER].running == NUM_WORK);
+  ASSERT(stats.classes[UV_WORK_CLASS_USER].queued == 0);
+
+  for (i = 0; i < NUM_WORK; i++)
+    uv_sem_post(&release);
+
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(after_work_cb_count == NUM_WORK);
+}
+
+
+TEST_IMPL(threadpool_set_size) {
+  uv_threadpool_stats_t stats;
+  uv_loop_t* loop;
+  int i;
+
+  ASSERT(UV_EINVAL == uv_threadpool_set_size(0));
+  ASSERT(UV_EINVAL == uv_threadpool_set_size(1025));
+
+  ASSERT(0 == uv_sem_init(&started, 0));
+  ASSERT(0 == uv_sem_init(&release, 0));
+  loop = uv_default_loop();
+
+  ASSERT(0 == uv_threadpool_set_size(NUM_WORK));
+  ASSERT(uv_threadpool_get_size() == NUM_WORK);
+  run_concurrently(loop);
+
+  /* The retired threads finish whatever is still queued on their way out. */
+  ASSERT(0 == uv_threadpool_set_size(1));
+  ASSERT(uv_threadpool_get_size() == 1);
+  after_work_cb_count = 0;
+  for (i = 0; i < NUM_WORK; i++)
+    ASSERT(0 == uv_queue_work(loop, &reqs[i], sleeping_work_cb, after_work_cb));
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(after_work_cb_count == NUM_WORK);
+
+  ASSERT(0 == uv_threadpool_get_stats(&stats));
+  ASSERT(stats.size == 1);
+
+  /* Grow again, reusing the slots of the retired threads. */
+  ASSERT(0 == uv_threadpool_set_size(NUM_WORK));
+  run_concurrently(loop);
+
+  uv_sem_destroy(&started);
+  uv_sem_destroy(&release);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+TEST_IMPL(threadpool_stats) {
+  uv_threadpool_class_stats_t* user;
+  uv_threadpool_stats_t stats;
+  uint64_t waited;
+  uint64_t ran;
+  uv_loop_t* loop;
+  int i;
+
+  ASSERT(UV_EINVAL == uv_threadpool_get_stats(NULL));
+
+  ASSERT(0 == uv_threadpool_get_stats(&stats));
+  user = &stats.classes[UV_WORK_CLASS_USER];
+  ASSERT(stats.size == uv_threadpool_get_size());
+  ASSERT(user->completed == 0);
+  ASSERT(user->queued == 0);
+
+  loop = uv_default_loop();
+  for (i = 0; i < NUM_WORK; i++)
+    ASSERT(0 == uv_queue_work(loop, &reqs[i], sleeping_work_cb, after_work_cb));
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(after_work_cb_count == NUM_WORK);
+
+  ASSERT(0 == uv_threadpool_get_stats(&stats));
+  ASSERT(user->completed == NUM_WORK);
+  ASSERT(user->queued == 0);
+  ASSERT(stats.classes[UV_WORK_CLASS_FS].completed == 0);
+
+  /* Every request sleeps for 2 ms, so none can have run in less than
+   * 2^10 microseconds.
+   */
+  waited = 0;
+  ran = 0;
+  for (i = 0; i < UV_THREADPOOL_HISTOGRAM_BUCKETS; i++) {
+    waited += user->wait_time[i];
+    ran += user->run_time[i];
+    if (i < 10)
+      ASSERT(user->run_time[i] == 0);
+  }
+  ASSERT(waited == NUM_WORK);
+  ASSERT(ran == NUM_WORK);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
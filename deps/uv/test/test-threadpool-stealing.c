@@ -0,0 +1,170 @@
+/* Copyright Joyent, Inc. and other Node contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "uv.h"
+#include "task.h"
+
+#include <stdlib.h>
+
+#define NUM_WORK 10000
+#define NUM_BLOCKING 16
+#define NUM_CANCEL 64
+
+static uv_mutex_t lock;
+static uv_sem_t started;
+static uv_sem_t release;
+static unsigned int running;
+static unsigned int max_running;
+static int work_cb_count;
+static int done_cb_count;
+static int cancelled_cb_count;
+
+
+static void enable_work_stealing(void) {
+  /* Takes effect because the threadpool is started lazily. */
+  ASSERT(0 == uv_os_setenv("UV_THREADPOOL_WORK_STEALING", "1"));
+  ASSERT(0 == uv_os_setenv("UV_THREADPOOL_SIZE", "8"));
+}
+
+
+static void counting_work_cb(uv_work_t* req) {
+  uv_mutex_lock(&lock);
+  work_cb_count++;
+  running++;
+  if (running > max_running)
+    max_running = running;
+  uv_mutex_unlock(&lock);
+
+  if (req->data != NULL)
+    uv_sleep(1);
+
+  uv_mutex_lock(&lock);
+  running--;
+  uv_mutex_unlock(&lock);
+}
+
+
+static void done_cb(uv_work_t* req, int status) {
+  ASSERT(status == 0);
+  done_cb_count++;
+}
+
+
+TEST_IMPL(threadpool_work_stealing) {
+  uv_work_t* reqs;
+  int i;
+
+  enable_work_stealing();
+  ASSERT(0 == uv_mutex_init(&lock));
+  ASSERT(0 == uv_threadpool_set_class(UV_WORK_CLASS_USER, 2, 0));
+
+  reqs = malloc(NUM_WORK * sizeof(*reqs));
+  ASSERT(reqs != NULL);
+
+  /* A few slow requests so that work piles up in the worker queues. */
+  for (i = 0; i < NUM_WORK; i++) {
+    reqs[i].data = (i % 100 == 0) ? &reqs[i] : NULL;
+    ASSERT(0 == uv_queue_work(uv_default_loop(),
+                              &reqs[i],
+                              counting_work_cb,
+                              done_cb));
+  }
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+
+  ASSERT(work_cb_count == NUM_WORK);
+  ASSERT(done_cb_count == NUM_WORK);
+  ASSERT(max_running <= 2);
+
+  free(reqs);
+  uv_mutex_destroy(&lock);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+static void blocking_work_cb(uv_work_t* req) {
+  uv_sem_post(&started);
+  uv_sem_wait(&release);
+}
+
+
+static void unexpected_work_cb(uv_work_t* req) {
+  ASSERT(0 && "should not have run");
+}
+
+
+static void cancelled_cb(uv_work_t* req, int status) {
+  ASSERT(status == UV_ECANCELED);
+  cancelled_cb_count++;
+
+  if (cancelled_cb_count == NUM_CANCEL) {
+    int i;
+    for (i = 0; i < NUM_BLOCKING; i++)
+      uv_sem_post(&release);
+  }
+}
+
+
+TEST_IMPL(threadpool_work_stealing_cancel) {
+  uv_work_t blocking_reqs[NUM_BLOCKING];
+  uv_work_t reqs[NUM_CANCEL];
+  int i;
+
+  enable_work_stealing();
+  ASSERT(0 == uv_sem_init(&started, 0));
+  ASSERT(0 == uv_sem_init(&release, 0));
+
+  /* Occupy more threads than there are, so that some of the blocking
+   * requests stay queued too.
+   */
+  for (i = 0; i < NUM_BLOCKING; i++)
+    ASSERT(0 == uv_queue_work_ex(uv_default_loop(),
+                                 blocking_reqs + i,
+                                 UV_WORK_CLASS_CPU,
+                                 blocking_work_cb,
+                                 done_cb));
+  for (i = 0; i < 8; i++)
+    uv_sem_wait(&started);
+
+  for (i = 0; i < NUM_CANCEL; i++)
+    ASSERT(0 == uv_queue_work(uv_default_loop(),
+                              reqs + i,
+                              unexpected_work_cb,
+                              cancelled_cb));
+  for (i = 0; i < NUM_CANCEL; i++)
+    ASSERT(0 == uv_cancel((uv_req_t*) (reqs + i)));
+
+  /* Already running. */
+  ASSERT(UV_EBUSY == uv_cancel((uv_req_t*) blocking_reqs));
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+
+  ASSERT(cancelled_cb_count == NUM_CANCEL);
+  ASSERT(done_cb_count == NUM_BLOCKING);
+
+  uv_sem_destroy(&started);
+  uv_sem_destroy(&release);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
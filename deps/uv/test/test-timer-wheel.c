@@ -0,0 +1,152 @@
+/* Copyright Joyent, Inc. and other Node contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "uv.h"
+#include "task.h"
+
+#define NUM_TIMERS 200
+
+static uv_timer_t timers[NUM_TIMERS];
+static uv_timer_t huge_timer;
+static uv_timer_t repeat_timer;
+static uint64_t last_timeout;
+static int last_index;
+static int timer_cb_called;
+static int repeat_cb_called;
+
+
+static uint64_t timeout_of(int i) {
+  /* Spread over a few levels of the wheel, with plenty of equal timeouts. */
+  return (i * 37) % 150;
+}
+
+
+static void timer_cb(uv_timer_t* handle) {
+  int i;
+
+  i = handle - timers;
+  ASSERT(i >= 0 && i < NUM_TIMERS);
+  ASSERT(i % 3 != 0);  /* Those were stopped. */
+  ASSERT(uv_now(handle->loop) >= (uint64_t) (uintptr_t) handle->data);
+
+  /* Timers fire in order of their timeout, and in the order in which they
+   * were started when the timeouts are equal.
+   */
+  ASSERT(timeout_of(i) >= last_timeout);
+  if (timeout_of(i) == last_timeout)
+    ASSERT(i > last_index);
+  last_timeout = timeout_of(i);
+  last_index = i;
+
+  if (++timer_cb_called == NUM_TIMERS - (NUM_TIMERS + 2) / 3)
+    uv_close((uv_handle_t*) &huge_timer, NULL);
+}
+
+
+static void repeat_cb(uv_timer_t* handle) {
+  if (++repeat_cb_called == 5)
+    uv_close((uv_handle_t*) handle, NULL);
+}
+
+
+static void huge_timer_cb(uv_timer_t* handle) {
+  ASSERT(0 && "huge_timer_cb should not be called");
+}
+
+
+static void start_timers(uv_loop_t* loop) {
+  uint64_t now;
+  int i;
+
+  now = uv_now(loop);
+  last_timeout = 0;
+  last_index = -1;
+  timer_cb_called = 0;
+  repeat_cb_called = 0;
+
+  for (i = 0; i < NUM_TIMERS; i++) {
+    ASSERT(0 == uv_timer_init(loop, &timers[i]));
+    timers[i].data = (void*) (uintptr_t) (now + timeout_of(i));
+    ASSERT(0 == uv_timer_start(&timers[i], timer_cb, timeout_of(i), 0));
+  }
+
+  for (i = 0; i < NUM_TIMERS; i += 3)
+    ASSERT(0 == uv_timer_stop(&timers[i]));
+
+  ASSERT(0 == uv_timer_init(loop, &huge_timer));
+  ASSERT(0 == uv_timer_start(&huge_timer, huge_timer_cb, (uint64_t) -1, 0));
+  ASSERT(0 == uv_timer_init(loop, &repeat_timer));
+  ASSERT(0 == uv_timer_start(&repeat_timer, repeat_cb, 70, 20));
+}
+
+
+static void check_timers(uv_loop_t* loop) {
+  int i;
+
+  ASSERT(timer_cb_called == NUM_TIMERS - (NUM_TIMERS + 2) / 3);
+  ASSERT(repeat_cb_called == 5);
+
+  for (i = 0; i < NUM_TIMERS; i++)
+    uv_close((uv_handle_t*) &timers[i], NULL);
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+}
+
+
+TEST_IMPL(timer_wheel) {
+  uv_loop_t loop;
+
+  ASSERT(0 == uv_loop_init(&loop));
+  ASSERT(0 == uv_loop_configure(&loop, UV_LOOP_TIMER_WHEEL));
+  /* Configuring it again is a no-op. */
+  ASSERT(0 == uv_loop_configure(&loop, UV_LOOP_TIMER_WHEEL));
+
+  start_timers(&loop);
+  ASSERT(0 == uv_run(&loop, UV_RUN_DEFAULT));
+  check_timers(&loop);
+
+  /* The wheel keeps working after it has been idle. */
+  uv_sleep(100);
+  uv_update_time(&loop);
+  start_timers(&loop);
+  ASSERT(0 == uv_run(&loop, UV_RUN_DEFAULT));
+  check_timers(&loop);
+
+  ASSERT(0 == uv_loop_close(&loop));
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+TEST_IMPL(timer_wheel_migrate) {
+  uv_loop_t loop;
+
+  ASSERT(0 == uv_loop_init(&loop));
+
+  /* Timers that are running when the wheel is turned on are moved over. */
+  start_timers(&loop);
+  ASSERT(0 == uv_loop_configure(&loop, UV_LOOP_TIMER_WHEEL));
+  ASSERT(0 == uv_run(&loop, UV_RUN_DEFAULT));
+  check_timers(&loop);
+
+  ASSERT(0 == uv_loop_close(&loop));
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
@@ -0,0 +1,205 @@
+/* Copyright Joyent, Inc. and other Node contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "uv.h"
+#include "task.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK_HANDLE(handle) \
+  ASSERT((uv_udp_t*)(handle) == &recver || (uv_udp_t*)(handle) == &sender)
+
+#define NUM_DGRAMS 10
+
+static uv_udp_t recver;
+static uv_udp_t sender;
+static uv_udp_send_t send_reqs[NUM_DGRAMS];
+static char slab[20 * 64 * 1024];
+static int recv_cb_called;
+static int chunk_cb_called;
+static int release_cb_called;
+static int send_cb_called;
+static int close_cb_called;
+
+
+static void alloc_cb(uv_handle_t* handle,
+                     size_t suggested_size,
+                     uv_buf_t* buf) {
+  CHECK_HANDLE(handle);
+  ASSERT(suggested_size <= sizeof(slab));
+  buf->base = slab;
+  buf->len = sizeof(slab);
+}
+
+
+static void close_cb(uv_handle_t* handle) {
+  CHECK_HANDLE(handle);
+  close_cb_called++;
+}
+
+
+static void recv_cb(uv_udp_t* handle,
+                    ssize_t nread,
+                    const uv_buf_t* rcvbuf,
+                    const struct sockaddr* addr,
+                    unsigned flags) {
+  char expected[8];
+
+  ASSERT(nread >= 0);
+
+  if (nread == 0) {
+    ASSERT(addr == NULL);
+    /* The buffer that is handed back is always the one alloc_cb returned. */
+    ASSERT(rcvbuf->base == slab);
+    release_cb_called++;
+    return;
+  }
+
+  ASSERT(addr != NULL);
+  ASSERT(rcvbuf->base >= slab && rcvbuf->base < slab + sizeof(slab));
+  if (flags & UV_UDP_MMSG_CHUNK)
+    chunk_cb_called++;
+
+  snprintf(expected, sizeof(expected), "PING%d", recv_cb_called);
+  ASSERT(nread == (ssize_t) strlen(expected));
+  ASSERT(memcmp(expected, rcvbuf->base, nread) == 0);
+
+  if (++recv_cb_called == NUM_DGRAMS) {
+    uv_close((uv_handle_t*) &recver, close_cb);
+    uv_close((uv_handle_t*) &sender, close_cb);
+  }
+}
+
+
+static void send_cb(uv_udp_send_t* req, int status) {
+  ASSERT(status == 0);
+  send_cb_called++;
+}
+
+
+static void check_mmsg_used(void) {
+#ifdef __linux__
+  /* All datagrams were in the socket buffer before the first read. */
+  ASSERT(chunk_cb_called == NUM_DGRAMS);
+#else
+  ASSERT(chunk_cb_called == 0);
+#endif
+}
+
+
+TEST_IMPL(udp_mmsg) {
+  struct sockaddr_in addr;
+  struct sockaddr* addrs[NUM_DGRAMS];
+  uv_buf_t* bufs[NUM_DGRAMS];
+  unsigned int nbufs[NUM_DGRAMS];
+  uv_buf_t data[NUM_DGRAMS];
+  char payload[NUM_DGRAMS][8];
+  int i;
+  int r;
+
+  r = uv_udp_init_ex(uv_default_loop(), &recver, AF_INET | UV_UDP_RECVMMSG);
+  ASSERT(r == 0);
+
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+  r = uv_udp_bind(&recver, (const struct sockaddr*) &addr, 0);
+  ASSERT(r == 0);
+
+  r = uv_udp_init(uv_default_loop(), &sender);
+  ASSERT(r == 0);
+
+  for (i = 0; i < NUM_DGRAMS; i++) {
+    snprintf(payload[i], sizeof(payload[i]), "PING%d", i);
+    data[i] = uv_buf_init(payload[i], strlen(payload[i]));
+    bufs[i] = &data[i];
+    nbufs[i] = 1;
+    addrs[i] = (struct sockaddr*) &addr;
+  }
+
+  ASSERT(UV_EINVAL == uv_udp_try_send2(&sender, 0, bufs, nbufs, addrs, 0));
+  ASSERT(UV_EINVAL == uv_udp_try_send2(&sender, 1, bufs, nbufs, addrs, 1));
+
+  /* Send everything before reading so that one read can pick up the batch. */
+  r = uv_udp_try_send2(&sender, NUM_DGRAMS, bufs, nbufs, addrs, 0);
+  ASSERT(r == NUM_DGRAMS);
+
+  r = uv_udp_recv_start(&recver, alloc_cb, recv_cb);
+  ASSERT(r == 0);
+
+  uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+
+  ASSERT(recv_cb_called == NUM_DGRAMS);
+  ASSERT(release_cb_called >= 1);
+  check_mmsg_used();
+  ASSERT(close_cb_called == 2);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+TEST_IMPL(udp_mmsg_send_queue) {
+  struct sockaddr_in addr;
+  char payload[NUM_DGRAMS][8];
+  uv_buf_t buf;
+  int i;
+  int r;
+
+  r = uv_udp_init_ex(uv_default_loop(), &recver, AF_INET | UV_UDP_RECVMMSG);
+  ASSERT(r == 0);
+
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+  r = uv_udp_bind(&recver, (const struct sockaddr*) &addr, 0);
+  ASSERT(r == 0);
+
+  r = uv_udp_init(uv_default_loop(), &sender);
+  ASSERT(r == 0);
+
+  /* Only the first request goes out straight away, the others are queued and
+   * flushed together.
+   */
+  for (i = 0; i < NUM_DGRAMS; i++) {
+    snprintf(payload[i], sizeof(payload[i]), "PING%d", i);
+    buf = uv_buf_init(payload[i], strlen(payload[i]));
+    r = uv_udp_send(&send_reqs[i],
+                    &sender,
+                    &buf,
+                    1,
+                    (const struct sockaddr*) &addr,
+                    send_cb);
+    ASSERT(r == 0);
+  }
+
+  r = uv_udp_recv_start(&recver, alloc_cb, recv_cb);
+  ASSERT(r == 0);
+
+  uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+
+  ASSERT(send_cb_called == NUM_DGRAMS);
+  ASSERT(recv_cb_called == NUM_DGRAMS);
+  ASSERT(close_cb_called == 2);
+  ASSERT(sender.send_queue_size == 0);
+  ASSERT(sender.send_queue_count == 0);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
@@ -34,6 +34,7 @@
         'test-fs.c',
         'test-fs-copyfile.c',
         'test-fs-event.c',
+        'test-fs-io-uring.c',
         'test-getters-setters.c',
         'test-get-currentexe.c',
         'test-get-memory.c',
@@ -57,8 +58,10 @@
         'test-loop-stop.c',
         'test-loop-time.c',
         'test-loop-configure.c',
+        'test-loop-busy-poll.c',
         'test-walk-handles.c',
         'test-watcher-cross-stop.c',
+        'test-metrics.c',
         'test-multiple-listen.c',
         'test-osx-select.c',
         'test-pass-always.c',
@@ -119,9 +122,13 @@
         'test-tcp-unexpected-read.c',
         'test-tcp-oob.c',
         'test-tcp-read-stop.c',
+        'test-tcp-reuseport.c',
         'test-tcp-write-queue-order.c',
         'test-threadpool.c',
         'test-threadpool-cancel.c',
+        'test-threadpool-class.c',
+        'test-threadpool-size.c',
+        'test-threadpool-stealing.c',
         'test-thread-equal.c',
         'test-tmpdir.c',
         'test-mutexes.c',
@@ -131,6 +138,7 @@
         'test-timer-again.c',
         'test-timer-from-check.c',
         'test-timer.c',
+        'test-timer-wheel.c',
         'test-tty.c',
         'test-udp-alloc-cb-fail.c',
         'test-udp-bind.c',
@@ -146,6 +154,7 @@
         'test-udp-multicast-join.c',
         'test-udp-multicast-join6.c',
         'test-dlerror.c',
+        'test-udp-mmsg.c',
         'test-udp-multicast-ttl.c',
         'test-ip4-addr.c',
         'test-ip6-addr.c',
@@ -233,6 +242,7 @@
         'benchmark-sizes.c',
         'benchmark-spawn.c',
         'benchmark-thread.c',
+        'benchmark-threadpool.c',
         'benchmark-tcp-write-batch.c',
         'benchmark-udp-pummel.c',
         'dns-server.c',
@@ -1,5 +1,6 @@
 {
   'variables': {
+    'uv_threadpool_work_stealing%': 'false',
     'conditions': [
       ['OS=="win"', {
         'shared_unix_defines': [ ],
@@ -90,6 +91,9 @@
         'OTHER_CFLAGS': [ '-g', '--std=gnu89', '-pedantic' ],
       },
       'conditions': [
+        [ 'uv_threadpool_work_stealing=="true"', {
+          'defines': [ 'UV_THREADPOOL_WORK_STEALING' ],
+        }],
         [ 'OS=="win"', {
           'defines': [
             '_WIN32_WINNT=0x0600',
@@ -234,6 +238,7 @@
           'sources': [
             'src/unix/linux-core.c',
             'src/unix/linux-inotify.c',
+            'src/unix/linux-iouring.c',
             'src/unix/linux-syscalls.c',
             'src/unix/linux-syscalls.h',
             'src/unix/procfs-exepath.c',
@@ -248,6 +253,7 @@
           'sources': [
             'src/unix/linux-core.c',
             'src/unix/linux-inotify.c',
+            'src/unix/linux-iouring.c',
             'src/unix/linux-syscalls.c',
             'src/unix/linux-syscalls.h',
             'src/unix/pthread-fixes.c',
@@ -41,6 +41,7 @@ const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
 const kOnBody = HTTPParser.kOnBody | 0;
 const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
 const kOnExecute = HTTPParser.kOnExecute | 0;
+const kOnBatch = HTTPParser.kOnBatch | 0;
 
 const MAX_HEADER_PAIRS = 2000;
 
@@ -148,6 +149,33 @@ function parserOnMessageComplete() {
   readStart(parser.socket);
 }
 
+// Called instead of the callbacks above for all the messages parsed from a
+// chunk of data at once, if the parser has a kOnBatch callback. `events` is
+// a flat list of the callbacks that would have been made, each as the
+// callback's index followed by its arguments.
+function parserOnBatch(events) {
+  const parser = this;
+  for (var i = 0; i < events.length;) {
+    switch (events[i]) {
+      case kOnHeadersComplete:
+        parser[kOnHeadersComplete](events[i + 1], events[i + 2],
+                                   events[i + 3], events[i + 4],
+                                   events[i + 5], events[i + 6],
+                                   events[i + 7], events[i + 8],
+                                   events[i + 9]);
+        i += 10;
+        break;
+      case kOnBody:
+        parser[kOnBody](events[i + 1], events[i + 2], events[i + 3]);
+        i += 4;
+        break;
+      default:
+        parser[kOnMessageComplete]();
+        i += 1;
+    }
+  }
+}
+
 
 const parsers = new FreeList('parsers', 1000, function parsersCb() {
   const parser = new HTTPParser(HTTPParser.REQUEST);
@@ -168,6 +196,7 @@ const parsers = new FreeList('parsers', 1000, function parsersCb() {
   parser[kOnBody] = parserOnBody;
   parser[kOnMessageComplete] = parserOnMessageComplete;
   parser[kOnExecute] = null;
+  parser[kOnBatch] = null;
 
   return parser;
 });
@@ -194,6 +223,7 @@ function freeParser(parser, req, socket) {
     parser.incoming = null;
     parser.outgoing = null;
     parser[kOnExecute] = null;
+    parser[kOnBatch] = null;
     if (parsers.free(parser) === false) {
       // Make sure the parser's stack has unwound before deleting the
       // corresponding C++ object through .close().
@@ -249,6 +279,7 @@ module.exports = {
   freeParser,
   httpSocketSetup,
   methods,
+  parserOnBatch,
   parsers,
   kIncomingMessage
 };
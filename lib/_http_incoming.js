@@ -21,6 +21,8 @@
 
 'use strict';
 
+const { internalBinding } = require('internal/bootstrap/loaders');
+const { knownHeaders } = internalBinding('http_parser');
 const util = require('util');
 const Stream = require('stream');
 
@@ -132,13 +134,17 @@ function _addHeaderLines(headers, n) {
 // 'no duplicates' field, a `0` byte is prepended as a flag. The one exception
 // to this is the Set-Cookie header which is indicated by a `1` byte flag, since
 // it is an 'array' field and thus is treated differently in _addHeaderLines().
-// TODO: perhaps http_parser could be returning both raw and lowercased versions
-// of known header names to avoid us having to call toLowerCase() for those
-// headers.
+//
+// The HTTP parser hands out the names of common headers as the same strings
+// every time, so the results for those are looked up in `knownFields` before
+// anything else.
 
 // 'array' header list is taken from:
 // https://mxr.mozilla.org/mozilla/source/netwerk/protocol/http/src/nsHttpHeaderArray.cpp
 function matchKnownFields(field) {
+  const known = knownFields.get(field);
+  if (known !== undefined)
+    return known;
   var low = false;
   while (true) {
     switch (field) {
@@ -264,6 +270,10 @@ function matchKnownFields(field) {
     }
   }
 }
+
+const knownFields = new Map();
+for (const name of knownHeaders)
+  knownFields.set(name, matchKnownFields(name));
 // Add the given (field, value) pair to the message
 //
 // Per RFC2616, section 4.2 it is acceptable to join multiple instances of the
@@ -25,8 +25,11 @@ const assert = require('assert').ok;
 const Stream = require('stream');
 const util = require('util');
 const internalUtil = require('internal/util');
+const { internalBinding } = require('internal/bootstrap/loaders');
+const { serializeHead } = internalBinding('http_parser');
 const { outHeadersKey, utcDate } = require('internal/http');
 const { Buffer } = require('buffer');
+const { kSendFile, toSendFileChunk } = require('internal/net');
 const common = require('_http_common');
 const checkIsHttpToken = common._checkIsHttpToken;
 const checkInvalidHeaderChar = common._checkInvalidHeaderChar;
@@ -51,6 +54,9 @@ const { CRLF, debug } = common;
 
 const kIsCorked = Symbol('isCorked');
 
+// Lazy loaded to improve startup performance.
+let fs;
+
 const hasOwnProperty = Function.call.bind(Object.prototype.hasOwnProperty);
 
 var RE_CONN_CLOSE = /(?:^|\W)close(?:$|\W)/i;
@@ -255,7 +261,7 @@ function _writeRaw(data, encoding, callback) {
     // There might be pending data in the this.output buffer.
     if (this.output.length) {
       this._flushOutput(conn);
-    } else if (!data.length) {
+    } else if (!data.length && data[kSendFile] === undefined) {
       if (typeof callback === 'function') {
         // If the socket was set directly it won't be correctly initialized
         // with an async_id_symbol.
@@ -292,11 +298,15 @@ function _storeHeader(firstLine, headers) {
     date: false,
     expect: false,
     trailer: false,
-    header: firstLine
+    // Header names and values, flattened.
+    headers: []
   };
 
+  // Headers that were set with setHeader() have been validated already.
+  var validate = true;
   var key;
   if (headers === this[outHeadersKey]) {
+    validate = false;
     for (key in headers) {
       const entry = headers[key];
       processHeader(this, state, entry[0], entry[1], false);
@@ -314,12 +324,12 @@ function _storeHeader(firstLine, headers) {
     }
   }
 
-  let { header } = state;
-
   // Date header
-  if (this.sendDate && !state.date) {
-    header += 'Date: ' + utcDate() + CRLF;
-  }
+  const sendDate = this.sendDate && !state.date;
+
+  let header = serializeHead(firstLine, state.headers, validate, sendDate);
+  if (header === undefined)
+    header = serializeHeadSlow(firstLine, state.headers, validate, sendDate);
 
   // Force the connection to close when the response is a 204 No Content or
   // a 304 Not Modified and the user has set a "Transfer-Encoding: chunked"
@@ -393,26 +403,43 @@ function _storeHeader(firstLine, headers) {
 }
 
 function processHeader(self, state, key, value, validate) {
-  if (validate)
+  // The rest is validated along with the values, by serializeHead().
+  if (validate && typeof key !== 'string')
     validateHeaderName(key);
   if (Array.isArray(value)) {
     if (value.length < 2 || !isCookieField(key)) {
       for (var i = 0; i < value.length; i++)
-        storeHeader(self, state, key, value[i], validate);
+        storeHeader(self, state, key, value[i]);
       return;
     }
     value = value.join('; ');
   }
-  storeHeader(self, state, key, value, validate);
+  storeHeader(self, state, key, value);
 }
 
-function storeHeader(self, state, key, value, validate) {
-  if (validate)
-    validateHeaderValue(key, value);
-  state.header += key + ': ' + escapeHeaderValue(value) + CRLF;
+function storeHeader(self, state, key, value) {
+  state.headers.push(key, value);
   matchHeader(self, state, key, value);
 }
 
+// Used when serializeHead() turns down the headers, to throw the right error
+// for an invalid header, or to escape line breaks in header values.
+function serializeHeadSlow(firstLine, headers, validate, sendDate) {
+  let header = firstLine;
+  for (var i = 0; i < headers.length; i += 2) {
+    const key = headers[i];
+    const value = headers[i + 1];
+    if (validate) {
+      validateHeaderName(key);
+      validateHeaderValue(key, value);
+    }
+    header += key + ': ' + escapeHeaderValue(value) + CRLF;
+  }
+  if (sendDate)
+    header += 'Date: ' + utcDate() + CRLF;
+  return header;
+}
+
 function matchHeader(self, state, field, value) {
   if (field.length < 4 || field.length > 17)
     return;
@@ -567,6 +594,15 @@ OutgoingMessage.prototype.write = function write(chunk, encoding, callback) {
   return write_(this, chunk, encoding, callback, false);
 };
 
+OutgoingMessage.prototype.sendFile = function sendFile(file, options,
+                                                       callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = undefined;
+  }
+  return write_(this, toSendFileChunk(file, options), null, callback, false);
+};
+
 function write_(msg, chunk, encoding, callback, fromEnd) {
   if (msg.finished) {
     const err = new ERR_STREAM_WRITE_AFTER_END();
@@ -597,9 +633,16 @@ function write_(msg, chunk, encoding, callback, fromEnd) {
   }
 
 
+  const file = chunk[kSendFile];
+  if (file !== undefined && file.length === undefined && msg.chunkedEncoding) {
+    // The chunk header needs the length of the range up front.
+    if (fs === undefined) fs = require('fs');
+    file.length = Math.max(fs.fstatSync(file.fd).size - file.offset, 0);
+  }
+
   // If we get an empty string or buffer, then just do nothing, and
   // signal the user to keep writing.
-  if (chunk.length === 0) {
+  if (file !== undefined ? file.length === 0 : chunk.length === 0) {
     debug('received empty string or buffer and waiting for more input');
     return true;
   }
@@ -614,6 +657,8 @@ function write_(msg, chunk, encoding, callback, fromEnd) {
   if (msg.chunkedEncoding) {
     if (typeof chunk === 'string')
       len = Buffer.byteLength(chunk, encoding);
+    else if (file !== undefined)
+      len = file.length;
     else
       len = chunk.length;
 
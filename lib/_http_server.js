@@ -35,6 +35,7 @@ const {
   chunkExpression,
   httpSocketSetup,
   kIncomingMessage,
+  parserOnBatch,
   _checkInvalidHeaderChar: checkInvalidHeaderChar
 } = require('_http_common');
 const { OutgoingMessage } = require('_http_outgoing');
@@ -52,6 +53,7 @@ const {
 const Buffer = require('buffer').Buffer;
 
 const kServerResponse = Symbol('ServerResponse');
+const kBatchPipelinedRequests = Symbol('batchPipelinedRequests');
 
 const STATUS_CODES = {
   100: 'Continue',
@@ -120,6 +122,7 @@ const STATUS_CODES = {
 };
 
 const kOnExecute = HTTPParser.kOnExecute | 0;
+const kOnBatch = HTTPParser.kOnBatch | 0;
 
 
 function ServerResponse(req) {
@@ -285,6 +288,7 @@ function Server(options, requestListener) {
 
   this[kIncomingMessage] = options.IncomingMessage || IncomingMessage;
   this[kServerResponse] = options.ServerResponse || ServerResponse;
+  this[kBatchPipelinedRequests] = !!options.batchPipelinedRequests;
 
   net.Server.call(this, { allowHalfOpen: true });
 
@@ -391,6 +395,8 @@ function connectionListenerInternal(server, socket) {
   }
   parser[kOnExecute] =
     onParserExecute.bind(undefined, server, socket, parser, state);
+  if (server[kBatchPipelinedRequests])
+    parser[kOnBatch] = onParserBatch.bind(undefined, socket, parser);
 
   socket._paused = false;
 }
@@ -476,6 +482,17 @@ function socketOnData(server, socket, parser, state, d) {
   onParserExecuteCommon(server, socket, parser, state, ret, d);
 }
 
+// Keep the socket corked while the requests that came in with a single read
+// are handled, so that responses sent right away are written together.
+function onParserBatch(socket, parser, events) {
+  socket.cork();
+  try {
+    parserOnBatch.call(parser, events);
+  } finally {
+    socket.uncork();
+  }
+}
+
 function onParserExecute(server, socket, parser, state, ret) {
   socket._unrefTimer();
   debug('SERVER socketOnParserExecute %d', ret);
@@ -560,7 +577,8 @@ function resOnFinish(req, res, socket, state, server) {
   if (!req._consuming && !req._readableState.resumeScheduled)
     req._dump();
 
-  res.detachSocket(socket);
+  if (res.socket === socket)
+    res.detachSocket(socket);
   req.emit('close');
   process.nextTick(emitCloseNT, res);
 
@@ -570,6 +588,8 @@ function resOnFinish(req, res, socket, state, server) {
     } else {
       socket.end();
     }
+  } else if (socket._httpMessage) {
+    // The socket has already been handed on by resOnPrefinish().
   } else if (state.outgoing.length === 0) {
     if (server.keepAliveTimeout && typeof socket.setTimeout === 'function') {
       socket.setTimeout(0);
@@ -585,6 +605,19 @@ function resOnFinish(req, res, socket, state, server) {
   }
 }
 
+// With batchPipelinedRequests, hand the socket on to the next response as
+// soon as all of this one has been written to the socket instead of waiting
+// for it to be flushed, so that queued responses join the same write.
+function resOnPrefinish(res, socket, state) {
+  if (res._last || socket._httpMessage !== res)
+    return;
+  res.detachSocket(socket);
+  var m = state.outgoing.shift();
+  if (m) {
+    m.assignSocket(socket);
+  }
+}
+
 function emitCloseNT(self) {
   self.emit('close');
 }
@@ -635,6 +668,8 @@ function parserOnIncoming(server, socket, state, req, keepAlive) {
   // response, if so destroy the socket.
   res.on('finish',
          resOnFinish.bind(undefined, req, res, socket, state, server));
+  if (server[kBatchPipelinedRequests])
+    res.on('prefinish', resOnPrefinish.bind(undefined, res, socket, state));
 
   if (req.headers.expect !== undefined &&
       (req.httpVersionMajor === 1 && req.httpVersionMinor === 1)) {
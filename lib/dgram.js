@@ -76,6 +76,7 @@ function Socket(type, listener) {
   var lookup;
   let recvBufferSize;
   let sendBufferSize;
+  let recvBatch = false;
 
   if (type !== null && typeof type === 'object') {
     var options = type;
@@ -83,6 +84,7 @@ function Socket(type, listener) {
     lookup = options.lookup;
     recvBufferSize = options.recvBufferSize;
     sendBufferSize = options.sendBufferSize;
+    recvBatch = !!options.recvBatch;
   }
 
   var handle = newHandle(type, lookup);
@@ -101,7 +103,8 @@ function Socket(type, listener) {
     queue: undefined,
     reuseAddr: options && options.reuseAddr, // Use UV_UDP_REUSEADDR if true.
     recvBufferSize,
-    sendBufferSize
+    sendBufferSize,
+    recvBatch
   };
 }
 util.inherits(Socket, EventEmitter);
@@ -116,8 +119,9 @@ function startListening(socket) {
   const state = socket[kStateSymbol];
 
   state.handle.onmessage = onMessage;
+  state.handle.onmessagebatch = onMessageBatch;
   // Todo: handle errors
-  state.handle.recvStart();
+  state.handle.recvStart(state.recvBatch);
   state.receiving = true;
   state.bindState = BIND_STATE_BOUND;
 
@@ -138,6 +142,7 @@ function replaceHandle(self, newHandle) {
   newHandle.lookup = oldHandle.lookup;
   newHandle.bind = oldHandle.bind;
   newHandle.send = oldHandle.send;
+  newHandle.sendBatch = oldHandle.sendBatch;
   newHandle[owner_symbol] = self;
 
   // Replace the existing handle by the handle we got from master.
@@ -469,14 +474,77 @@ Socket.prototype.send = function(buffer,
     defaultTriggerAsyncIdScope(
       this[async_id_symbol],
       doSend,
-      ex, this, ip, list, address, port, callback
+      ex, this, ip, list, address, port, callback, false
     );
   };
 
   state.handle.lookup(address, afterDns);
 };
 
-function doSend(ex, self, ip, list, address, port, callback) {
+
+// sendBatch(msgs, port[, address][, callback])
+Socket.prototype.sendBatch = function(msgs, port, address, callback) {
+  if (!Array.isArray(msgs))
+    throw new ERR_INVALID_ARG_TYPE('msgs', 'Array', msgs);
+
+  const list = new Array(msgs.length);
+  for (var i = 0; i < msgs.length; i++) {
+    const msg = msgs[i];
+    if (typeof msg === 'string') {
+      list[i] = Buffer.from(msg);
+    } else if (isUint8Array(msg)) {
+      list[i] = msg;
+    } else {
+      throw new ERR_INVALID_ARG_TYPE(`msgs[${i}]`,
+                                     ['Buffer', 'Uint8Array', 'string'],
+                                     msg);
+    }
+  }
+
+  port = port >>> 0;
+  if (port === 0 || port > 65535)
+    throw new ERR_SOCKET_BAD_PORT(port);
+
+  if (typeof callback !== 'function')
+    callback = undefined;
+
+  if (typeof address === 'function') {
+    callback = address;
+    address = undefined;
+  } else if (address && typeof address !== 'string') {
+    throw new ERR_INVALID_ARG_TYPE('address', ['string', 'falsy'], address);
+  }
+
+  healthCheck(this);
+
+  const state = this[kStateSymbol];
+
+  if (list.length === 0) {
+    if (callback)
+      process.nextTick(callback, null, 0);
+    return;
+  }
+
+  if (state.bindState === BIND_STATE_UNBOUND)
+    this.bind({ port: 0, exclusive: true }, null);
+
+  if (state.bindState !== BIND_STATE_BOUND) {
+    enqueue(this, this.sendBatch.bind(this, list, port, address, callback));
+    return;
+  }
+
+  const afterDns = (ex, ip) => {
+    defaultTriggerAsyncIdScope(
+      this[async_id_symbol],
+      doSend,
+      ex, this, ip, list, address, port, callback, true
+    );
+  };
+
+  state.handle.lookup(address, afterDns);
+};
+
+function doSend(ex, self, ip, list, address, port, callback, batch) {
   const state = self[kStateSymbol];
 
   if (ex) {
@@ -500,14 +568,33 @@ function doSend(ex, self, ip, list, address, port, callback) {
     req.oncomplete = afterSend;
   }
 
-  var err = state.handle.send(req,
-                              list,
-                              list.length,
-                              port,
-                              ip,
-                              !!callback);
+  var err;
+  if (batch) {
+    err = state.handle.sendBatch(req,
+                                 list,
+                                 list.length,
+                                 port,
+                                 ip,
+                                 !!callback);
+    // A positive value is the number of datagrams still in flight. Zero means
+    // that all of them went out right away and oncomplete won't be called.
+    if (err === 0 && callback) {
+      let sent = 0;
+      for (var i = 0; i < list.length; i++)
+        sent += list[i].length;
+      process.nextTick(callback, null, sent);
+      return;
+    }
+  } else {
+    err = state.handle.send(req,
+                            list,
+                            list.length,
+                            port,
+                            ip,
+                            !!callback);
+  }
 
-  if (err && callback) {
+  if (err < 0 && callback) {
     // don't emit as error, dgram_legacy.js compatibility
     const ex = exceptionWithHostPort(err, 'send', address, port);
     process.nextTick(callback, ex);
@@ -680,6 +767,28 @@ function onMessage(nread, handle, buf, rinfo) {
 }
 
 
+// The datagrams of a batch arrive concatenated in `buf`.
+function onMessageBatch(handle, buf, sizes, rinfos) {
+  const self = handle[owner_symbol];
+  const msgs = new Array(sizes.length);
+  var offset = 0;
+  for (var i = 0; i < sizes.length; i++) {
+    msgs[i] = buf.slice(offset, offset + sizes[i]);
+    offset += sizes[i];
+    rinfos[i].size = sizes[i];
+  }
+
+  if (self.listenerCount('messages') > 0) {
+    self.emit('messages', msgs, rinfos);
+    return;
+  }
+
+  const state = self[kStateSymbol];
+  for (i = 0; i < msgs.length && state.handle !== null; i++)
+    self.emit('message', msgs[i], rinfos[i]);
+}
+
+
 Socket.prototype.ref = function() {
   const handle = this[kStateSymbol].handle;
 
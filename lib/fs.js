@@ -65,9 +65,11 @@ const {
   preprocessSymlinkDestination,
   Stats,
   getStatsFromBinding,
+  getStatsManyFromBinding,
   realpathCacheKey,
   stringToFlags,
   stringToSymlinkType,
+  toStatManyPaths,
   toUnixTimestamp,
   validateBuffer,
   validateOffsetLengthRead,
@@ -93,7 +95,7 @@ let fs;
 // Lazy loaded
 let promises;
 let watchers;
-let ReadFileContext;
+let walkTree;
 let ReadStream;
 let WriteStream;
 
@@ -235,74 +237,38 @@ function existsSync(path) {
   }
 }
 
-function readFileAfterOpen(err, fd) {
-  const context = this.context;
-
-  if (err) {
-    context.callback(err);
-    return;
-  }
-
-  context.fd = fd;
-
-  const req = new FSReqCallback();
-  req.oncomplete = readFileAfterStat;
-  req.context = context;
-  binding.fstat(fd, false, req);
-}
-
-function readFileAfterStat(err, stats) {
-  const context = this.context;
-
-  if (err)
-    return context.close(err);
-
-  const size = context.size = isFileType(stats, S_IFREG) ? stats[8] : 0;
-
-  if (size === 0) {
-    context.buffers = [];
-    context.read();
-    return;
-  }
-
-  if (size > kMaxLength) {
-    err = new ERR_FS_FILE_TOO_LARGE(size);
-    return context.close(err);
-  }
-
-  try {
-    context.buffer = Buffer.allocUnsafeSlow(size);
-  } catch (err) {
-    return context.close(err);
-  }
-  context.read();
-}
-
 function readFile(path, options, callback) {
   callback = maybeCallback(callback || options);
   options = getOptions(options, { flag: 'r' });
-  if (!ReadFileContext)
-    ReadFileContext = require('internal/fs/read_file_context');
-  const context = new ReadFileContext(callback, options.encoding);
-  context.isUserFd = isFd(path); // file descriptor ownership
 
-  const req = new FSReqCallback();
-  req.context = context;
-  req.oncomplete = readFileAfterOpen;
-
-  if (context.isUserFd) {
-    process.nextTick(function tick() {
-      req.oncomplete(null, path);
-    });
-    return;
+  if (!isFd(path)) {
+    path = toPathIfFileURL(path);
+    validatePath(path);
+    path = pathModule.toNamespacedPath(path);
   }
 
-  path = toPathIfFileURL(path);
-  validatePath(path);
-  binding.open(pathModule.toNamespacedPath(path),
-               stringToFlags(options.flag || 'r'),
-               0o666,
-               req);
+  // The whole open, fstat, read, close sequence runs as one threadpool job.
+  const { encoding } = options;
+  const utf8 = encoding === 'utf8' || encoding === 'utf-8';
+  const req = new FSReqCallback();
+  req.oncomplete = (err, data) => {
+    if (err)
+      return callback(err);
+    if (encoding && !utf8) {
+      try {
+        data = data.toString(encoding);
+      } catch (err) {
+        return callback(err);
+      }
+    }
+    callback(null, data);
+  };
+
+  const flags = stringToFlags(options.flag || 'r');
+  if (utf8)
+    binding.readFileUtf8(path, flags, req);
+  else
+    binding.readFileBuffer(path, flags, req);
 }
 
 function tryStatSync(fd, isUserFd) {
@@ -867,6 +833,31 @@ function statSync(path, options = {}) {
   return getStatsFromBinding(stats);
 }
 
+function statMany(paths, options, callback) {
+  if (arguments.length < 3) {
+    callback = options;
+    options = {};
+  }
+  callback = makeCallback(callback);
+  paths = toStatManyPaths(paths);
+  const followSymlinks = options.followSymlinks !== false;
+  const req = new FSReqCallback(options.bigint);
+  req.oncomplete = (err, result) => {
+    if (err) return callback(err);
+    callback(null, getStatsManyFromBinding(paths, result, followSymlinks));
+  };
+  binding.statMany(paths.map(pathModule.toNamespacedPath), options.bigint,
+                   followSymlinks, req);
+}
+
+function statManySync(paths, options = {}) {
+  paths = toStatManyPaths(paths);
+  const followSymlinks = options.followSymlinks !== false;
+  const result = binding.statMany(paths.map(pathModule.toNamespacedPath),
+                                  options.bigint, followSymlinks);
+  return getStatsManyFromBinding(paths, result, followSymlinks);
+}
+
 function readlink(path, options, callback) {
   callback = makeCallback(typeof options === 'function' ? options : callback);
   options = getOptions(options, {});
@@ -1251,6 +1242,12 @@ function appendFileSync(path, data, options) {
   fs.writeFileSync(path, data, options);
 }
 
+function walk(root, options) {
+  if (walkTree === undefined)
+    walkTree = require('internal/fs/walk');
+  return walkTree(root, options);
+}
+
 function watch(filename, options, listener) {
   if (typeof options === 'function') {
     listener = options;
@@ -1735,8 +1732,9 @@ function copyFileSync(src, dest, flags) {
   src = pathModule._makeLong(src);
   dest = pathModule._makeLong(dest);
   flags = flags | 0;
-  binding.copyFile(src, dest, flags, undefined, ctx);
+  const method = binding.copyFile(src, dest, flags, undefined, ctx);
   handleErrorFromBinding(ctx);
+  return method;
 }
 
 function lazyLoadStreams() {
@@ -1817,6 +1815,8 @@ module.exports = fs = {
   rmdir,
   rmdirSync,
   stat,
+  statMany,
+  statManySync,
   statSync,
   symlink,
   symlinkSync,
@@ -1827,6 +1827,7 @@ module.exports = fs = {
   unlinkSync,
   utimes,
   utimesSync,
+  walk,
   watch,
   watchFile,
   writeFile,
@@ -114,8 +114,9 @@ const handleConversion = {
       // will be sent
       if (!options.keepOpen) {
         handle.onread = nop;
-        socket._handle = null;
+        // Before the handle is detached, as it may hold the timeout.
         socket.setTimeout(0);
+        socket._handle = null;
         // In case of an HTTP connection socket, release the associated
         // resources
         if (socket.parser && socket.parser instanceof HTTPParser) {
@@ -2,7 +2,9 @@
 const assert = require('assert');
 const util = require('util');
 const path = require('path');
+const net = require('net');
 const EventEmitter = require('events');
+const { internalBinding } = require('internal/bootstrap/loaders');
 const { owner_symbol } = require('internal/async_hooks').symbols;
 const Worker = require('internal/cluster/worker');
 const { internal, sendHelper } = require('internal/cluster/utils');
@@ -85,6 +87,8 @@ cluster._getServer = function(obj, options, cb) {
 
     if (handle)
       shared(reply, handle, indexesKey, cb);  // Shared listen socket.
+    else if (reply.reuseport)
+      reuseport(reply, message, indexesKey, cb);  // Listen socket of our own.
     else
       rr(reply, indexesKey, cb);              // Round-robin.
   });
@@ -116,6 +120,28 @@ function shared(message, handle, indexesKey, cb) {
   cb(message.errno, handle);
 }
 
+// SO_REUSEPORT. Bind a socket of our own to the address and port that the
+// master has reserved, and let the kernel balance the connections.
+function reuseport(reply, message, indexesKey, cb) {
+  if (reply.errno)
+    return cb(reply.errno, null);
+
+  const { UV_TCP_REUSEPORT } = internalBinding('tcp_wrap').constants;
+  const handle = net._createServerHandle(message.address,
+                                         reply.sockname.port,
+                                         message.addressType,
+                                         undefined,
+                                         UV_TCP_REUSEPORT);
+  if (typeof handle === 'number') {
+    send({ act: 'close', key: reply.key });
+    delete indexes[indexesKey];
+    return cb(handle, null);
+  }
+
+  // The master's socket stays reserved until all workers have closed theirs.
+  shared(reply, handle, indexesKey, cb);
+}
+
 // Round-robin. Master distributes handles across workers.
 function rr(message, indexesKey, cb) {
   if (message.errno)
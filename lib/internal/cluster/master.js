@@ -4,6 +4,7 @@ const { fork } = require('child_process');
 const util = require('util');
 const path = require('path');
 const EventEmitter = require('events');
+const ReusePortHandle = require('internal/cluster/reuseport_handle');
 const RoundRobinHandle = require('internal/cluster/round_robin_handle');
 const SharedHandle = require('internal/cluster/shared_handle');
 const Worker = require('internal/cluster/worker');
@@ -14,6 +15,7 @@ const cluster = new EventEmitter();
 const intercom = new EventEmitter();
 const SCHED_NONE = 1;
 const SCHED_RR = 2;
+const SCHED_REUSEPORT = 3;
 const { isLegalPort } = require('internal/net');
 const [ minPort, maxPort ] = [ 1024, 65535 ];
 
@@ -26,6 +28,7 @@ cluster.workers = {};
 cluster.settings = {};
 cluster.SCHED_NONE = SCHED_NONE;  // Leave it to the operating system.
 cluster.SCHED_RR = SCHED_RR;      // Master distributes connections.
+cluster.SCHED_REUSEPORT = SCHED_REUSEPORT;  // Kernel balances across workers.
 
 var ids = 0;
 var debugPortOffset = 1;
@@ -34,7 +37,8 @@ var initialized = false;
 // XXX(bnoordhuis) Fold cluster.schedulingPolicy into cluster.settings?
 var schedulingPolicy = {
   'none': SCHED_NONE,
-  'rr': SCHED_RR
+  'rr': SCHED_RR,
+  'reuseport': SCHED_REUSEPORT
 }[process.env.NODE_CLUSTER_SCHED_POLICY];
 
 if (schedulingPolicy === undefined) {
@@ -45,6 +49,10 @@ if (schedulingPolicy === undefined) {
 
 cluster.schedulingPolicy = schedulingPolicy;
 
+// Only Linux spreads connections across a SO_REUSEPORT group. Elsewhere
+// the last socket to bind tends to get them all, so use round-robin instead.
+const reusePortBalances = process.platform === 'linux';
+
 cluster.setupMaster = function(options) {
   var settings = {
     args: process.argv.slice(2),
@@ -71,7 +79,8 @@ cluster.setupMaster = function(options) {
 
   initialized = true;
   schedulingPolicy = cluster.schedulingPolicy;  // Freeze policy.
-  assert(schedulingPolicy === SCHED_NONE || schedulingPolicy === SCHED_RR,
+  assert(schedulingPolicy === SCHED_NONE || schedulingPolicy === SCHED_RR ||
+         schedulingPolicy === SCHED_REUSEPORT,
          `Bad cluster.schedulingPolicy: ${schedulingPolicy}`);
 
   process.nextTick(setupSettingsNT, settings);
@@ -296,10 +305,14 @@ function queryServer(worker, message) {
     // UDP is exempt from round-robin connection balancing for what should
     // be obvious reasons: it's connectionless. There is nothing to send to
     // the workers except raw datagrams and that's pointless.
-    if (schedulingPolicy !== SCHED_RR ||
+    if (schedulingPolicy === SCHED_NONE ||
         message.addressType === 'udp4' ||
         message.addressType === 'udp6') {
       constructor = SharedHandle;
+    } else if (schedulingPolicy === SCHED_REUSEPORT && reusePortBalances &&
+               message.port >= 0 && typeof message.fd !== 'number') {
+      // Pipes and inherited file descriptors fall back to round-robin.
+      constructor = ReusePortHandle;
     }
 
     handles[key] = handle = new constructor(key,
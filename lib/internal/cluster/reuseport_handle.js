@@ -0,0 +1,54 @@
+'use strict';
+const assert = require('assert');
+const net = require('net');
+const { internalBinding } = require('internal/bootstrap/loaders');
+const { UV_TCP_REUSEPORT } = internalBinding('tcp_wrap').constants;
+
+module.exports = ReusePortHandle;
+
+// The master binds a socket with SO_REUSEPORT but never listens on it. That
+// picks the port when port 0 is requested and keeps it reserved, while each
+// worker binds and listens on a socket of its own in the same group. The
+// kernel then balances incoming connections across the workers' sockets,
+// without the master in the data path.
+function ReusePortHandle(key, address, port, addressType, fd) {
+  this.key = key;
+  this.workers = [];
+  this.handle = null;
+  this.errno = 0;
+  this.sockname = null;
+
+  const rval = net._createServerHandle(address, port, addressType, fd,
+                                       UV_TCP_REUSEPORT);
+
+  if (typeof rval === 'number') {
+    this.errno = rval;
+  } else {
+    this.handle = rval;
+    this.sockname = {};
+    this.handle.getsockname(this.sockname);
+  }
+}
+
+ReusePortHandle.prototype.add = function(worker, send) {
+  assert(this.workers.indexOf(worker) === -1);
+  this.workers.push(worker);
+  send(this.errno, { reuseport: true, sockname: this.sockname }, null);
+};
+
+ReusePortHandle.prototype.remove = function(worker) {
+  const index = this.workers.indexOf(worker);
+
+  if (index === -1)
+    return false; // The worker wasn't sharing this handle.
+
+  this.workers.splice(index, 1);
+
+  if (this.workers.length !== 0)
+    return false;
+
+  if (this.handle !== null)
+    this.handle.close();
+  this.handle = null;
+  return true;
+};
@@ -47,6 +47,7 @@ function newHandle(type, lookup) {
     handle.lookup = lookup6.bind(handle, lookup);
     handle.bind = handle.bind6;
     handle.send = handle.send6;
+    handle.sendBatch = handle.sendBatch6;
     return handle;
   }
 
@@ -10,22 +10,32 @@ const {
 const binding = process.binding('fs');
 const { Buffer, kMaxLength } = require('buffer');
 const {
-  ERR_FS_FILE_TOO_LARGE,
-  ERR_INVALID_ARG_TYPE,
-  ERR_INVALID_ARG_VALUE,
-  ERR_METHOD_NOT_IMPLEMENTED
-} = require('internal/errors').codes;
+  codes: {
+    ERR_FS_FILE_TOO_LARGE,
+    ERR_INVALID_ARG_TYPE,
+    ERR_INVALID_ARG_VALUE,
+    ERR_INVALID_OPT_VALUE,
+    ERR_METHOD_NOT_IMPLEMENTED,
+    ERR_OUT_OF_RANGE
+  },
+  uvException
+} = require('internal/errors');
 const { toPathIfFileURL } = require('internal/url');
-const { isUint8Array } = require('internal/util/types');
+const {
+  isArrayBufferView,
+  isUint8Array
+} = require('internal/util/types');
 const {
   copyObject,
   getDirents,
   getOptions,
   getStatsFromBinding,
+  getStatsManyFromBinding,
   nullCheck,
   preprocessSymlinkDestination,
   stringToFlags,
   stringToSymlinkType,
+  toStatManyPaths,
   toUnixTimestamp,
   validateBuffer,
   validateOffsetLengthRead,
@@ -45,6 +55,20 @@ const { kUsePromises } = binding;
 
 const getDirectoryEntriesPromise = promisify(getDirents);
 
+// Keep in sync with ToMadviseAdvice() in src/node_file.cc.
+const kMapAdvice = {
+  normal: 0,
+  random: 1,
+  sequential: 2,
+  willneed: 3,
+  dontneed: 4
+};
+
+// The ArrayBuffers of Buffers returned by filehandle.map(). madvise() is
+// restricted to these, as advice such as 'dontneed' would discard the contents
+// of ordinary heap memory.
+const mappedArrayBuffers = new WeakSet();
+
 class FileHandle {
   constructor(filehandle) {
     this[kHandle] = filehandle;
@@ -54,6 +78,10 @@ class FileHandle {
     return this[kHandle].getAsyncId();
   }
 
+  map(offset, length, options) {
+    return map(this, offset, length, options);
+  }
+
   get fd() {
     return this[kHandle].fd;
   }
@@ -130,8 +158,8 @@ async function writeFileHandle(filehandle, data, options) {
   } while (remaining > 0);
 }
 
-// Note: This is different from kReadFileBufferLength used for non-promisified
-// fs.readFile.
+// Note: non-promisified fs.readFile() reads the whole file in a single
+// threadpool job instead of in chunks.
 const kReadFileMaxChunkSize = 16384;
 
 async function readFileHandle(filehandle, options) {
@@ -169,6 +197,77 @@ async function readFileHandle(filehandle, options) {
   }
 }
 
+function toMapAdvice(advice) {
+  if (advice === undefined)
+    return kMapAdvice.normal;
+  if (typeof advice !== 'string' ||
+      !Object.prototype.hasOwnProperty.call(kMapAdvice, advice)) {
+    throw new ERR_INVALID_OPT_VALUE('advice', advice);
+  }
+  return kMapAdvice[advice];
+}
+
+async function map(handle, offset = 0, length, options = {}) {
+  validateFileHandle(handle);
+  validateInteger(offset, 'offset');
+  if (offset < 0)
+    throw new ERR_OUT_OF_RANGE('offset', '>= 0', offset);
+  if (options === null || typeof options !== 'object')
+    throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+
+  const { shared = false, readonly = false } = options;
+  if (typeof shared !== 'boolean')
+    throw new ERR_INVALID_ARG_TYPE('options.shared', 'boolean', shared);
+  if (typeof readonly !== 'boolean')
+    throw new ERR_INVALID_ARG_TYPE('options.readonly', 'boolean', readonly);
+  const advice = toMapAdvice(options.advice);
+
+  if (length === undefined) {
+    const statFields = await binding.fstat(handle.fd, false, kUsePromises);
+    length = Math.max(statFields[8/* size */] - offset, 0);
+  } else {
+    validateInteger(length, 'length');
+    if (length < 0)
+      throw new ERR_OUT_OF_RANGE('length', '>= 0', length);
+  }
+
+  if (length > kMaxLength)
+    throw new ERR_FS_FILE_TOO_LARGE(length);
+
+  let buffer;
+  if (length === 0) {
+    // mmap() rejects empty mappings.
+    buffer = Buffer.alloc(0);
+  } else {
+    const ctx = {};
+    buffer = binding.mmap(handle.fd, offset, length,
+                          shared, readonly, advice, ctx);
+    if (ctx.errno !== undefined)
+      throw uvException(ctx);
+  }
+  mappedArrayBuffers.add(buffer.buffer);
+  return buffer;
+}
+
+async function madvise(buffer, advice) {
+  if (!isArrayBufferView(buffer)) {
+    throw new ERR_INVALID_ARG_TYPE('buffer',
+                                   ['Buffer', 'TypedArray', 'DataView'],
+                                   buffer);
+  }
+  if (!mappedArrayBuffers.has(buffer.buffer)) {
+    throw new ERR_INVALID_ARG_VALUE('buffer', buffer,
+                                    'is not backed by filehandle.map()');
+  }
+  if (advice === undefined)
+    throw new ERR_INVALID_OPT_VALUE('advice', advice);
+
+  const ctx = {};
+  binding.madvise(buffer, toMapAdvice(advice), ctx);
+  if (ctx.errno !== undefined)
+    throw uvException(ctx);
+}
+
 // All of the functions are defined as async in order to ensure that errors
 // thrown cause promise rejections rather than being thrown synchronously.
 async function access(path, mode = F_OK) {
@@ -367,6 +466,15 @@ async function stat(path, options = { bigint: false }) {
   return getStatsFromBinding(result);
 }
 
+async function statMany(paths, options = { bigint: false }) {
+  paths = toStatManyPaths(paths);
+  const followSymlinks = options.followSymlinks !== false;
+  const result = await binding.statMany(
+    paths.map(pathModule.toNamespacedPath), options.bigint, followSymlinks,
+    kUsePromises);
+  return getStatsManyFromBinding(paths, result, followSymlinks);
+}
+
 async function link(existingPath, newPath) {
   existingPath = toPathIfFileURL(existingPath);
   newPath = toPathIfFileURL(newPath);
@@ -493,6 +601,7 @@ async function readFile(path, options) {
 module.exports = {
   access,
   copyFile,
+  madvise,
   open,
   rename,
   truncate,
@@ -503,6 +612,7 @@ module.exports = {
   symlink,
   lstat,
   stat,
+  statMany,
   link,
   unlink,
   chmod,
@@ -9,8 +9,10 @@ const {
   ERR_INVALID_OPT_VALUE_ENCODING,
   ERR_OUT_OF_RANGE
 } = require('internal/errors').codes;
+const { uvException } = require('internal/errors');
 const { isUint8Array, isArrayBufferView } = require('internal/util/types');
 const { once } = require('internal/util');
+const { toPathIfFileURL } = require('internal/url');
 const pathModule = require('path');
 const util = require('util');
 const kType = Symbol('type');
@@ -44,6 +46,7 @@ const {
   UV_DIRENT_CHAR,
   UV_DIRENT_BLOCK
 } = process.binding('constants').fs;
+const { kFsStatsFieldsLength } = process.binding('fs');
 
 const isWindows = process.platform === 'win32';
 
@@ -318,6 +321,36 @@ function getStatsFromBinding(stats, offset = 0) {
                    stats[12 + offset], stats[13 + offset]);
 }
 
+// Validates the path list passed to fs.statMany() and returns a copy of it
+// with file URLs converted to paths.
+function toStatManyPaths(paths) {
+  if (!Array.isArray(paths))
+    throw new ERR_INVALID_ARG_TYPE('paths', 'Array', paths);
+  const result = new Array(paths.length);
+  for (var i = 0; i < paths.length; i++) {
+    const path = toPathIfFileURL(paths[i]);
+    validatePath(path, `paths[${i}]`);
+    result[i] = path;
+  }
+  return result;
+}
+
+// Turns the [stats, errors] pair returned by binding.statMany() into an
+// array holding an fs.Stats object or an Error for each path.
+function getStatsManyFromBinding(paths, result, followSymlinks) {
+  const [stats, errors] = result;
+  const syscall = followSymlinks ? 'stat' : 'lstat';
+  const entries = new Array(paths.length);
+  for (var i = 0; i < paths.length; i++) {
+    if (errors[i] !== 0) {
+      entries[i] = uvException({ errno: errors[i], syscall, path: paths[i] });
+    } else {
+      entries[i] = getStatsFromBinding(stats, i * kFsStatsFieldsLength);
+    }
+  }
+  return entries;
+}
+
 function stringToFlags(flags) {
   if (typeof flags === 'number') {
     return flags;
@@ -465,9 +498,11 @@ module.exports = {
   preprocessSymlinkDestination,
   realpathCacheKey: Symbol('realpathCacheKey'),
   getStatsFromBinding,
+  getStatsManyFromBinding,
   stringToFlags,
   stringToSymlinkType,
   Stats,
+  toStatManyPaths,
   toUnixTimestamp,
   validateBuffer,
   validateOffsetLengthRead,
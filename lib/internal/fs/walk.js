@@ -0,0 +1,157 @@
+'use strict';
+
+const { internalBinding } = require('internal/bootstrap/loaders');
+const {
+  UV_DIRENT_UNKNOWN,
+  UV_DIRENT_FILE,
+  UV_DIRENT_DIR,
+  UV_DIRENT_LINK,
+  UV_DIRENT_FIFO,
+  UV_DIRENT_SOCKET,
+  UV_DIRENT_CHAR,
+  UV_DIRENT_BLOCK
+} = process.binding('constants').fs;
+const { UV_ENOENT } = internalBinding('uv');
+const binding = process.binding('fs');
+const {
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+    ERR_OUT_OF_RANGE
+  },
+  uvException
+} = require('internal/errors');
+const { toPathIfFileURL } = require('internal/url');
+const { validatePath } = require('internal/fs/utils');
+const pathModule = require('path');
+
+const { kUsePromises } = binding;
+
+// Number of directories scanned by a single threadpool job.
+const kWalkBatchSize = 32;
+
+const kTypeNames = [];
+kTypeNames[UV_DIRENT_UNKNOWN] = 'unknown';
+kTypeNames[UV_DIRENT_FILE] = 'file';
+kTypeNames[UV_DIRENT_DIR] = 'directory';
+kTypeNames[UV_DIRENT_LINK] = 'symlink';
+kTypeNames[UV_DIRENT_FIFO] = 'fifo';
+kTypeNames[UV_DIRENT_SOCKET] = 'socket';
+kTypeNames[UV_DIRENT_CHAR] = 'char';
+kTypeNames[UV_DIRENT_BLOCK] = 'block';
+
+function walk(root, options = {}) {
+  root = toPathIfFileURL(root);
+  validatePath(root, 'root');
+  root = `${root}`;
+
+  if (options === null || typeof options !== 'object')
+    throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+
+  const {
+    maxDepth = Infinity,
+    followSymlinks = false,
+    filter,
+    onError
+  } = options;
+
+  if (typeof maxDepth !== 'number')
+    throw new ERR_INVALID_ARG_TYPE('options.maxDepth', 'number', maxDepth);
+  if (maxDepth !== Infinity && !Number.isSafeInteger(maxDepth) ||
+      maxDepth < 0) {
+    throw new ERR_OUT_OF_RANGE('options.maxDepth',
+                               'a non-negative integer or Infinity',
+                               maxDepth);
+  }
+  if (typeof followSymlinks !== 'boolean') {
+    throw new ERR_INVALID_ARG_TYPE('options.followSymlinks', 'boolean',
+                                   followSymlinks);
+  }
+  if (filter !== undefined && typeof filter !== 'function')
+    throw new ERR_INVALID_ARG_TYPE('options.filter', 'Function', filter);
+  if (onError !== undefined && typeof onError !== 'function')
+    throw new ERR_INVALID_ARG_TYPE('options.onError', 'Function', onError);
+
+  return walkTree(root, maxDepth, followSymlinks, filter, onError);
+}
+
+// The traversal stack lives here, the directories themselves are read on the
+// threadpool, kWalkBatchSize at a time. Keeping the stack in JS lets filter()
+// prune whole subtrees before they are ever read.
+async function* walkTree(root, maxDepth, followSymlinks, filter, onError) {
+  if (maxDepth === 0)
+    return;
+
+  const dirs = [root];
+  const depths = [0];
+
+  // Device and inode numbers of the directories that have been queued, used
+  // to break symlink cycles.
+  let visited;
+  if (followSymlinks) {
+    const stats = await binding.stat(pathModule.toNamespacedPath(root), true,
+                                     kUsePromises);
+    visited = new Set([`${stats[0/* dev */]}:${stats[7/* ino */]}`]);
+  }
+
+  while (dirs.length > 0) {
+    const batch = dirs.splice(-kWalkBatchSize);
+    const batchDepths = depths.splice(-kWalkBatchSize);
+    const [names, types, counts, ids] =
+      await binding.walk(batch.map(pathModule.toNamespacedPath),
+                         followSymlinks, kUsePromises);
+    const nameList = names.split('\0');
+
+    let index = 0;
+    for (let i = 0; i < batch.length; i++) {
+      const count = counts[i];
+      if (count < 0) {
+        const err = uvException({
+          errno: count,
+          syscall: 'scandir',
+          path: batch[i]
+        });
+        // Directories that disappear while the walk is in progress are
+        // skipped, and so are the ones onError() is told about, but the root
+        // has to be readable.
+        if (batch[i] !== root) {
+          if (count === UV_ENOENT)
+            continue;
+          if (onError !== undefined) {
+            onError(err);
+            continue;
+          }
+        }
+        throw err;
+      }
+
+      const dir = batch[i];
+      const depth = batchDepths[i] + 1;
+      for (let j = 0; j < count; j++, index++) {
+        const entry = {
+          path: pathModule.join(dir, nameList[index]),
+          type: kTypeNames[types[index]]
+        };
+
+        if (filter !== undefined && !filter(entry))
+          continue;
+
+        if (entry.type === 'directory' && depth < maxDepth) {
+          let descend = true;
+          if (followSymlinks) {
+            const id = `${ids[2 * index]}:${ids[2 * index + 1]}`;
+            descend = !visited.has(id);
+            visited.add(id);
+          }
+          if (descend) {
+            dirs.push(entry.path);
+            depths.push(depth);
+          }
+        }
+
+        yield entry;
+      }
+    }
+  }
+}
+
+module.exports = walk;
@@ -3,6 +3,10 @@
 const Buffer = require('buffer').Buffer;
 const { writeBuffer } = process.binding('fs');
 const errors = require('internal/errors');
+const { ERR_INVALID_ARG_TYPE, ERR_OUT_OF_RANGE } = errors.codes;
+const { validateInt32, validateInteger } = require('internal/validators');
+
+const kSendFile = Symbol('kSendFile');
 
 // IPv4 Segment
 const v4Seg = '(?:[0-9]|[1-9][0-9]|1[0-9][0-9]|2[0-4][0-9]|25[0-5])';
@@ -65,11 +69,43 @@ function makeSyncWrite(fd) {
   };
 }
 
+// Returns a zero-length Buffer that stands in for a byte range of a file in
+// the write queue of a socket, see `Socket.prototype.sendFile()`.
+function toSendFileChunk(file, options) {
+  let fd = file;
+  if (file !== null && typeof file === 'object' && typeof file.fd === 'number')
+    fd = file.fd;  // FileHandle
+  if (typeof fd !== 'number')
+    throw new ERR_INVALID_ARG_TYPE('file', ['number', 'FileHandle'], file);
+  validateInt32(fd, 'file', 0);
+
+  if (options === undefined || options === null)
+    options = {};
+  else if (typeof options !== 'object')
+    throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+
+  const { offset = 0, length } = options;
+  validateInteger(offset, 'options.offset');
+  if (offset < 0)
+    throw new ERR_OUT_OF_RANGE('options.offset', '>= 0', offset);
+  if (length !== undefined) {
+    validateInteger(length, 'options.length');
+    if (length < 0)
+      throw new ERR_OUT_OF_RANGE('options.length', '>= 0', length);
+  }
+
+  const chunk = Buffer.alloc(0);
+  chunk[kSendFile] = { fd, offset, length };
+  return chunk;
+}
+
 module.exports = {
   isIP,
   isIPv4,
   isIPv6,
   isLegalPort,
   makeSyncWrite,
+  kSendFile,
+  toSendFileChunk,
   normalizedArgsSymbol: Symbol('normalizedArgs')
 };
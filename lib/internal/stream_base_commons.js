@@ -4,11 +4,20 @@ const { Buffer } = require('buffer');
 const { internalBinding } = require('internal/bootstrap/loaders');
 const { WriteWrap } = internalBinding('stream_wrap');
 const { UV_EOF } = internalBinding('uv');
-const { errnoException } = require('internal/errors');
+const {
+  codes: {
+    ERR_INVALID_RETURN_VALUE
+  },
+  errnoException
+} = require('internal/errors');
 const { owner_symbol } = require('internal/async_hooks').symbols;
+const { isUint8Array } = require('internal/util/types');
 
 const kMaybeDestroy = Symbol('kMaybeDestroy');
 const kUpdateTimer = Symbol('kUpdateTimer');
+const kBuffer = Symbol('kBuffer');
+const kBufferCb = Symbol('kBufferCb');
+const kBufferGen = Symbol('kBufferGen');
 
 function handleWriteReq(req, data, encoding) {
   const { handle } = req;
@@ -92,7 +101,28 @@ function onStreamRead(nread, buf) {
   stream[kUpdateTimer]();
 
   if (nread > 0 && !stream.destroyed) {
-    if (!stream.push(buf)) {
+    let ret;
+    let result;
+    const userBuf = stream[kBuffer];
+    if (userBuf) {
+      // The data has been read straight into userBuf by the handle. If a new
+      // buffer is returned, the next read will use that one instead.
+      result = (stream[kBufferCb](nread, userBuf) !== false);
+      const bufGen = stream[kBufferGen];
+      if (bufGen !== null) {
+        const nextBuf = bufGen();
+        if (!isUint8Array(nextBuf)) {
+          // Thrown from here, the error would escape the read callback.
+          return stream.destroy(
+            new ERR_INVALID_RETURN_VALUE('instance of Uint8Array',
+                                         'onread.buffer', nextBuf));
+        }
+        stream[kBuffer] = ret = nextBuf;
+      }
+    } else {
+      result = stream.push(buf);
+    }
+    if (!result) {
       handle.reading = false;
       if (!stream.destroyed) {
         const err = handle.readStop();
@@ -101,7 +131,7 @@ function onStreamRead(nread, buf) {
       }
     }
 
-    return;
+    return ret;
   }
 
   if (nread === 0) {
@@ -135,4 +165,7 @@ module.exports = {
   onStreamRead,
   kMaybeDestroy,
   kUpdateTimer,
+  kBuffer,
+  kBufferCb,
+  kBufferGen,
 };
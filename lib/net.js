@@ -31,18 +31,21 @@ const {
   isIPv6,
   isLegalPort,
   normalizedArgsSymbol,
-  makeSyncWrite
+  makeSyncWrite,
+  kSendFile,
+  toSendFileChunk
 } = require('internal/net');
 const assert = require('assert');
 const { internalBinding } = require('internal/bootstrap/loaders');
 const {
   UV_EADDRINUSE,
-  UV_EINVAL
+  UV_EINVAL,
+  UV_EOF
 } = internalBinding('uv');
 
 const { Buffer } = require('buffer');
 const TTYWrap = internalBinding('tty_wrap');
-const { ShutdownWrap } = internalBinding('stream_wrap');
+const { ShutdownWrap, SendFileWrap } = internalBinding('stream_wrap');
 const {
   TCP,
   TCPConnectWrap,
@@ -53,6 +56,7 @@ const {
   PipeConnectWrap,
   constants: PipeConstants
 } = internalBinding('pipe_wrap');
+const { StreamPipe, canSplice } = internalBinding('stream_pipe');
 const {
   newAsyncId,
   defaultTriggerAsyncIdScope,
@@ -63,7 +67,10 @@ const {
   writevGeneric,
   writeGeneric,
   onStreamRead,
-  kUpdateTimer
+  kUpdateTimer,
+  kBuffer,
+  kBufferCb,
+  kBufferGen
 } = require('internal/stream_base_commons');
 const errors = require('internal/errors');
 const {
@@ -73,17 +80,23 @@ const {
   ERR_INVALID_FD_TYPE,
   ERR_INVALID_IP_ADDRESS,
   ERR_INVALID_OPT_VALUE,
+  ERR_INVALID_RETURN_VALUE,
   ERR_SERVER_ALREADY_LISTEN,
   ERR_SERVER_NOT_RUNNING,
   ERR_SOCKET_BAD_PORT,
   ERR_SOCKET_CLOSED
 } = errors.codes;
 const { validateInt32, validateString } = require('internal/validators');
+const { isUint8Array } = require('internal/util/types');
 const kLastWriteQueueSize = Symbol('lastWriteQueueSize');
 
 // Lazy loaded to improve startup performance.
 let cluster;
 let dns;
+let fs;
+
+// Size of the chunks that sendFile() reads when it can't use sendfile(2).
+const kSendFileChunkSize = 64 * 1024;
 
 const { errnoException, exceptionWithHostPort } = errors;
 
@@ -204,6 +217,10 @@ function normalizeArgs(args) {
 
 
 // called when creating new Socket, or when re-using a closed Socket
+function onStreamTimeout() {
+  this[owner_symbol]._onTimeout();
+}
+
 function initSocketHandle(self) {
   self._undestroy();
   self._sockname = null;
@@ -212,11 +229,27 @@ function initSocketHandle(self) {
   if (self._handle) {
     self._handle[owner_symbol] = self;
     self._handle.onread = onStreamRead;
+    self._handle.ontimeout = onStreamTimeout;
     self[async_id_symbol] = getNewAsyncId(self._handle);
+
+    let userBuf = self[kBuffer];
+    if (userBuf) {
+      const bufGen = self[kBufferGen];
+      if (bufGen !== null) {
+        userBuf = bufGen();
+        if (!isUint8Array(userBuf)) {
+          throw new ERR_INVALID_RETURN_VALUE('instance of Uint8Array',
+                                             'onread.buffer', userBuf);
+        }
+        self[kBuffer] = userBuf;
+      }
+      self._handle.useUserBuffer(userBuf);
+    }
   }
 }
 
 
+const kNativePipe = Symbol('kNativePipe');
 const kBytesRead = Symbol('kBytesRead');
 const kBytesWritten = Symbol('kBytesWritten');
 
@@ -290,6 +323,24 @@ function Socket(options) {
     }
   }
 
+  const onread = options.onread;
+  if (onread !== null && typeof onread === 'object' &&
+      (isUint8Array(onread.buffer) || typeof onread.buffer === 'function') &&
+      typeof onread.callback === 'function') {
+    if (typeof onread.buffer === 'function') {
+      this[kBuffer] = true;
+      this[kBufferGen] = onread.buffer;
+    } else {
+      this[kBuffer] = onread.buffer;
+      this[kBufferGen] = null;
+    }
+    this[kBufferCb] = onread.callback;
+  } else {
+    this[kBuffer] = null;
+    this[kBufferCb] = null;
+    this[kBufferGen] = null;
+  }
+
   // shut down the socket when we're finished with it.
   this.on('end', onReadableStreamEnd);
 
@@ -321,10 +372,14 @@ function Socket(options) {
   // Used after `.destroy()`
   this[kBytesRead] = 0;
   this[kBytesWritten] = 0;
+
+  // Set while pipeNative() moves the data that this socket receives.
+  this[kNativePipe] = null;
 }
 util.inherits(Socket, stream.Duplex);
 
-// Refresh existing timeouts.
+// Refresh existing timeouts. Native idle timeouts, see setTimeout(), are
+// refreshed by the handle itself on every read and write.
 Socket.prototype._unrefTimer = function _unrefTimer() {
   for (var s = this; s !== null; s = s._parent) {
     if (s[kTimeout])
@@ -419,12 +474,23 @@ Socket.prototype.setTimeout = function(msecs, callback) {
   //  even if it will be rescheduled we don't want to leak an existing timer.
   clearTimeout(this[kTimeout]);
 
+  // Handles that wrap a libuv stream track the idle time themselves, which
+  // saves a timer operation in JS on every read and write. They call
+  // ontimeout, which lands in _onTimeout(), once the time is up.
+  const handle = this._handle;
+  const native = handle != null && handle.setIdleTimeout !== undefined;
+  if (native) {
+    handle.setIdleTimeout(msecs);
+    this[kTimeout] = null;
+  }
+
   if (msecs === 0) {
     if (callback) {
       this.removeListener('timeout', callback);
     }
   } else {
-    this[kTimeout] = setUnrefTimeout(this._onTimeout.bind(this), msecs);
+    if (!native)
+      this[kTimeout] = setUnrefTimeout(this._onTimeout.bind(this), msecs);
 
     if (callback) {
       this.once('timeout', callback);
@@ -443,7 +509,10 @@ Socket.prototype._onTimeout = function() {
     const { writeQueueSize } = handle;
     if (lastWriteQueueSize !== writeQueueSize) {
       this[kLastWriteQueueSize] = writeQueueSize;
-      this._unrefTimer();
+      if (this[kTimeout] === null)
+        handle.setIdleTimeout(this.timeout);
+      else
+        this._unrefTimer();
       return;
     }
   }
@@ -531,6 +600,11 @@ Socket.prototype._read = function(n) {
   if (this.connecting || !this._handle) {
     debug('_read wait for connection');
     this.once('connect', () => this._read(n));
+  } else if (this[kNativePipe] !== null) {
+    // The data is read natively. Pick up from here if that stops before the
+    // end of the stream.
+    debug('_read wait for native pipe');
+    this[kNativePipe].pendingRead = true;
   } else if (!this._handle.reading) {
     // not already reading, start the flow
     debug('Socket._read readStart');
@@ -707,6 +781,15 @@ Socket.prototype._writeGeneric = function(writev, data, encoding, cb) {
 
   this._unrefTimer();
 
+  if (writev) {
+    for (var i = 0; i < data.length; i++) {
+      if (data[i].chunk[kSendFile] !== undefined)
+        return writevWithSendFile(this, data, i, cb);
+    }
+  } else if (data[kSendFile] !== undefined) {
+    return sendFileGeneric(this, data[kSendFile], cb);
+  }
+
   var req = createWriteWrap(this._handle, afterWrite);
   if (writev)
     writevGeneric(this, req, data, cb);
@@ -717,6 +800,226 @@ Socket.prototype._writeGeneric = function(writev, data, encoding, cb) {
 };
 
 
+// Splits a batch of buffered writes around a sendFile() chunk.
+function writevWithSendFile(self, data, index, cb) {
+  const file = data[index].chunk[kSendFile];
+  const rest = data.slice(index + 1);
+
+  function afterSendFile(err) {
+    if (err)
+      return cb(err);
+    if (rest.length > 0)
+      self._writeGeneric(true, rest, '', cb);
+    else
+      cb();
+  }
+
+  if (index === 0)
+    return sendFileGeneric(self, file, afterSendFile);
+
+  self._writeGeneric(true, data.slice(0, index), '', (err) => {
+    if (err)
+      return cb(err);
+    sendFileGeneric(self, file, afterSendFile);
+  });
+}
+
+
+function sendFileGeneric(self, file, cb) {
+  const { fd, offset, length } = file;
+
+  if (length === undefined) {
+    if (fs === undefined) fs = require('fs');
+    fs.fstat(fd, (err, stats) => {
+      if (err)
+        return self.destroy(err, cb);
+      const length = Math.max(stats.size - offset, 0);
+      sendFileGeneric(self, { fd, offset, length }, cb);
+    });
+    return;
+  }
+
+  if (!self._handle) {
+    self.destroy(new ERR_SOCKET_CLOSED(), cb);
+    return;
+  }
+
+  if (length === 0)
+    return cb();
+
+  if (typeof self._handle.sendFile === 'function') {
+    const req = new SendFileWrap();
+    req.handle = self._handle;
+    req.callback = cb;
+    req.onprogress = onSendFileProgress;
+    req.oncomplete = afterSendFile;
+    const err = self._handle.sendFile(req, fd, offset, length);
+    if (err !== 0)
+      self.destroy(errnoException(err, 'sendfile'), cb);
+    return;
+  }
+
+  // The handle can't use sendfile(2), e.g. because it is a TLS stream or
+  // because the platform has no support for it. Copy the data through a
+  // buffer, one chunk at a time so that slow readers apply backpressure.
+  sendFileFallback(self, fd, offset, length, cb);
+}
+
+
+function sendFileFallback(self, fd, offset, length, cb) {
+  if (fs === undefined) fs = require('fs');
+  const buffer = Buffer.allocUnsafe(Math.min(length, kSendFileChunkSize));
+
+  function readChunk() {
+    fs.read(fd, buffer, 0, Math.min(length, buffer.length), offset, onRead);
+  }
+
+  function onRead(err, bytesRead) {
+    if (self.destroyed)
+      return;
+    if (err)
+      return self.destroy(err, cb);
+    // The file is shorter than expected.
+    if (bytesRead === 0)
+      return cb();
+
+    offset += bytesRead;
+    length -= bytesRead;
+    const chunk = bytesRead < buffer.length ?
+      buffer.slice(0, bytesRead) : buffer;
+    self._writeGeneric(false, chunk, 'buffer', afterWriteChunk);
+  }
+
+  function afterWriteChunk(err) {
+    if (err)
+      return cb(err);
+    if (length > 0)
+      readChunk();
+    else
+      cb();
+  }
+
+  readChunk();
+}
+
+
+function onSendFileProgress() {
+  const self = this.handle[owner_symbol];
+  if (!self.destroyed)
+    self._unrefTimer();
+}
+
+
+function afterSendFile(status) {
+  const self = this.handle[owner_symbol];
+  debug('afterSendFile', status);
+
+  // callback may come after call to destroy.
+  if (self.destroyed)
+    return;
+
+  if (status < 0) {
+    self.destroy(errnoException(status, 'sendfile'), this.callback);
+    return;
+  }
+
+  self._unrefTimer();
+  this.callback();
+}
+
+
+Socket.prototype.sendFile = function(file, options, cb) {
+  if (typeof options === 'function') {
+    cb = options;
+    options = undefined;
+  }
+  return this.write(toSendFileChunk(file, options), cb);
+};
+
+
+Socket.prototype.pipeNative = function(dest, options) {
+  if (!(dest instanceof Socket))
+    throw new ERR_INVALID_ARG_TYPE('dest', 'net.Socket', dest);
+  const end = !options || options.end !== false;
+  startNativePipe(this, dest, end);
+  return dest;
+};
+
+
+function startNativePipe(source, dest, end) {
+  const connecting = source.connecting ? source : dest.connecting ? dest : null;
+  if (connecting !== null) {
+    connecting.once('connect', () => startNativePipe(source, dest, end));
+    return;
+  }
+
+  if (!source._handle || !dest._handle ||
+      !canSplice(source._handle._externalStream,
+                 dest._handle._externalStream)) {
+    source.pipe(dest, { end });
+    return;
+  }
+
+  const state = { source, dest, end, pendingRead: false };
+  source[kNativePipe] = state;
+  if (source._handle.reading) {
+    source._handle.reading = false;
+    source._handle.readStop();
+  }
+
+  // Pass on what has been read already, and make sure it has been written
+  // out before the kernel starts writing to the socket on its own.
+  let chunk;
+  while ((chunk = source.read()) !== null)
+    dest.write(chunk);
+  if (dest.writableLength > 0 || dest._pendingData !== null)
+    dest.write(Buffer.alloc(0), () => spliceSockets(state));
+  else
+    spliceSockets(state);
+}
+
+
+function spliceSockets(state) {
+  const { source, dest, end } = state;
+  if (source.destroyed || dest.destroyed ||
+      !source._handle || !dest._handle) {
+    source[kNativePipe] = null;
+    return;
+  }
+
+  const pipe = new StreamPipe(source._handle._externalStream,
+                              dest._handle._externalStream);
+  const err = pipe.start();
+  if (err !== undefined && err !== 0) {
+    source[kNativePipe] = null;
+    if (state.pendingRead)
+      source._read();
+    source.pipe(dest, { end });
+    return;
+  }
+  pipe[kNativePipe] = state;
+  pipe.onunpipe = onNativeUnpipe;
+  dest.emit('pipe', source);
+}
+
+
+function onNativeUnpipe(status) {
+  const state = this[kNativePipe];
+  const { source, dest } = state;
+  source[kNativePipe] = null;
+
+  if (status === UV_EOF) {
+    if (state.end)
+      dest.end();
+  } else if (status < 0) {
+    dest.destroy(errnoException(status, 'splice'));
+  } else if (state.pendingRead && !source.destroyed && source._handle) {
+    source._read();
+  }
+  dest.emit('unpipe', source);
+}
+
+
 Socket.prototype._writev = function(chunks, cb) {
   this._writeGeneric(true, chunks, '', cb);
 };
@@ -1177,7 +1480,8 @@ util.inherits(Server, EventEmitter);
 function toNumber(x) { return (x = Number(x)) >= 0 ? x : false; }
 
 // Returns handle if it can be created, or error code if it can't
-function createServerHandle(address, port, addressType, fd) {
+// `flags` are TCP bind flags, such as TCPConstants.UV_TCP_REUSEPORT.
+function createServerHandle(address, port, addressType, fd, flags) {
   var err = 0;
   // assign handle in listen, and clean up if bind or listen fails
   var handle;
@@ -1216,16 +1520,16 @@ function createServerHandle(address, port, addressType, fd) {
     debug('bind to', address || 'any');
     if (!address) {
       // Try binding to ipv6 first
-      err = handle.bind6('::', port);
+      err = handle.bind6('::', port, flags);
       if (err) {
         handle.close();
         // Fallback to ipv4
-        return createServerHandle('0.0.0.0', port);
+        return createServerHandle('0.0.0.0', port, undefined, undefined, flags);
       }
     } else if (addressType === 6) {
-      err = handle.bind6(address, port);
+      err = handle.bind6(address, port, flags);
     } else {
-      err = handle.bind(address, port);
+      err = handle.bind(address, port, flags);
     }
   }
 
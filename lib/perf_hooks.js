@@ -7,11 +7,16 @@ const {
   clearMark: _clearMark,
   measure: _measure,
   milestones,
+  loopIdleTime,
   observerCounts,
   setupObservers,
   timeOrigin,
   timeOriginTimestamp,
   timerify,
+  getThreadpoolStats,
+  setThreadpoolSize,
+  getLoopBusyPollStats,
+  ELDHistogram: _ELDHistogram,
   constants
 } = internalBinding('performance');
 
@@ -28,13 +33,18 @@ const {
   NODE_PERFORMANCE_MILESTONE_LOOP_START,
   NODE_PERFORMANCE_MILESTONE_LOOP_EXIT,
   NODE_PERFORMANCE_MILESTONE_BOOTSTRAP_COMPLETE,
-  NODE_PERFORMANCE_MILESTONE_ENVIRONMENT
+  NODE_PERFORMANCE_MILESTONE_ENVIRONMENT,
+
+  UV_THREADPOOL_HISTOGRAM_BUCKETS,
+  UV_WORK_CLASS_MAX
 } = constants;
 
 const { AsyncResource } = require('async_hooks');
 const L = require('internal/linkedlist');
 const kInspect = require('internal/util').customInspectSymbol;
 const { inherits } = require('util');
+const { validateInt32 } = require('internal/validators');
+const { uvException } = require('internal/errors');
 
 const kCallback = Symbol('callback');
 const kTypes = Symbol('types');
@@ -48,6 +58,8 @@ const kGetEntries = Symbol('get-entries');
 const kIndex = Symbol('index');
 const kMarks = Symbol('marks');
 const kCount = Symbol('count');
+const kHandle = Symbol('handle');
+const kMap = Symbol('map');
 
 const observers = {};
 const observerableTypes = [
@@ -75,6 +87,9 @@ const IDX_SESSION_STATS_STREAMAVERAGEDURATION = 5;
 const IDX_SESSION_STATS_DATA_SENT = 6;
 const IDX_SESSION_STATS_DATA_RECEIVED = 7;
 const IDX_SESSION_STATS_MAX_CONCURRENT_STREAMS = 8;
+const IDX_SESSION_STATS_POOL_ALLOCATIONS = 9;
+const IDX_SESSION_STATS_HEAP_ALLOCATIONS = 10;
+const IDX_SESSION_STATS_POOL_SIZE = 11;
 
 let sessionStats;
 let streamStats;
@@ -119,6 +134,12 @@ function collectHttp2Stats(entry) {
         sessionStats[IDX_SESSION_STATS_DATA_RECEIVED];
       entry.maxConcurrentStreams =
         sessionStats[IDX_SESSION_STATS_MAX_CONCURRENT_STREAMS];
+      entry.poolAllocations =
+        sessionStats[IDX_SESSION_STATS_POOL_ALLOCATIONS];
+      entry.heapAllocations =
+        sessionStats[IDX_SESSION_STATS_HEAP_ALLOCATIONS];
+      entry.poolSize =
+        sessionStats[IDX_SESSION_STATS_POOL_SIZE];
       break;
   }
 }
@@ -433,6 +454,27 @@ class Performance {
     return ret;
   }
 
+  // Idle time is the time the event loop spent waiting for I/O in the poll
+  // phase since it was started, active time everything else. With arguments,
+  // the difference to an earlier result (or between two results) is
+  // returned instead.
+  eventLoopUtilization(util1, util2) {
+    const loopStart =
+      getMilestoneTimestamp(NODE_PERFORMANCE_MILESTONE_LOOP_START);
+    if (loopStart === -1)
+      return { idle: 0, active: 0, utilization: 0 };
+
+    if (util2 !== undefined)
+      return utilizationDelta(util1.idle - util2.idle,
+                              util1.active - util2.active);
+
+    const idle = loopIdleTime[0] / 1e6;
+    const active = now() - timeOrigin - loopStart - idle;
+    if (util1 !== undefined)
+      return utilizationDelta(idle - util1.idle, active - util1.active);
+    return utilizationDelta(idle, active);
+  }
+
   [kInspect]() {
     return {
       nodeTiming: this.nodeTiming,
@@ -441,6 +483,11 @@ class Performance {
   }
 }
 
+function utilizationDelta(idle, active) {
+  const total = idle + active;
+  return { idle, active, utilization: total > 0 ? active / total : 0 };
+}
+
 const performance = new Performance();
 
 function getObserversList(type) {
@@ -542,9 +589,181 @@ function sortedInsert(list, entry) {
   list.splice(location, 0, entry);
 }
 
+// Upper limit of libuv's MAX_THREADPOOL_SIZE.
+const kMaxThreadpoolSize = 1024;
+// Same order as uv_work_class_t.
+const kWorkClasses = ['fs', 'dns', 'cpu', 'user'];
+const kClassStatsLength = 3 + 2 * UV_THREADPOOL_HISTOGRAM_BUCKETS;
+const kMicrosPerMillis = 1e3;
+
+let threadpoolStats;
+
+// Bucket i counts durations from 2^i to 2^(i+1) microseconds, the first one
+// everything below 2 and the last one everything above.
+class ThreadpoolHistogram {
+  constructor(buckets) {
+    this.buckets = buckets;
+    let count = 0;
+    for (var n = 0; n < buckets.length; n++)
+      count += buckets[n];
+    this.count = count;
+  }
+
+  // Returns the upper bound, in milliseconds, of the bucket that holds the
+  // p-th percentile.
+  percentile(p) {
+    if (typeof p !== 'number') {
+      const errors = lazyErrors();
+      throw new errors.ERR_INVALID_ARG_TYPE('p', 'number', p);
+    }
+    if (!(p > 0 && p <= 100)) {
+      const errors = lazyErrors();
+      throw new errors.ERR_OUT_OF_RANGE('p', '> 0 && <= 100', p);
+    }
+    if (this.count === 0)
+      return 0;
+    const target = Math.ceil(this.count * p / 100);
+    const buckets = this.buckets;
+    let seen = 0;
+    for (var n = 0; n < buckets.length - 1; n++) {
+      seen += buckets[n];
+      if (seen >= target)
+        return 2 ** (n + 1) / kMicrosPerMillis;
+    }
+    return Infinity;
+  }
+}
+
+function readThreadpoolStats() {
+  if (threadpoolStats === undefined) {
+    threadpoolStats =
+      new Float64Array(2 + UV_WORK_CLASS_MAX * kClassStatsLength);
+  }
+  getThreadpoolStats(threadpoolStats);
+  return threadpoolStats;
+}
+
+const threadpool = {
+  get size() {
+    return readThreadpoolStats()[0];
+  },
+
+  // The pool is shared by the whole process, including its Workers. Threads
+  // above the new size finish the request they are running before they
+  // exit.
+  resize(size) {
+    validateInt32(size, 'size', 1, kMaxThreadpoolSize);
+    const err = setThreadpoolSize(size);
+    if (err !== 0)
+      throw uvException({ errno: err, syscall: 'uv_threadpool_set_size' });
+  },
+
+  stats() {
+    const fields = readThreadpoolStats();
+    const classes = {};
+    const buckets = UV_THREADPOOL_HISTOGRAM_BUCKETS;
+    for (var n = 0; n < kWorkClasses.length; n++) {
+      const offset = 2 + n * kClassStatsLength;
+      const waitStart = offset + 3;
+      const runStart = waitStart + buckets;
+      classes[kWorkClasses[n]] = {
+        queued: fields[offset],
+        running: fields[offset + 1],
+        completed: fields[offset + 2],
+        waitTime: new ThreadpoolHistogram(
+          Array.from(fields.subarray(waitStart, runStart))),
+        runTime: new ThreadpoolHistogram(
+          Array.from(fields.subarray(runStart, runStart + buckets)))
+      };
+    }
+    return {
+      size: fields[0],
+      idle: fields[1],
+      classes
+    };
+  }
+};
+
+// Wraps the native event loop delay sampler. All values are in nanoseconds.
+class ELDHistogram {
+  constructor(handle) {
+    this[kHandle] = handle;
+    this[kMap] = new Map();
+  }
+
+  reset() { this[kHandle].reset(); }
+  enable() { return this[kHandle].enable(); }
+  disable() { return this[kHandle].disable(); }
+
+  get exceeds() { return this[kHandle].exceeds(); }
+  get min() { return this[kHandle].min(); }
+  get max() { return this[kHandle].max(); }
+  get mean() { return this[kHandle].mean(); }
+  get stddev() { return this[kHandle].stddev(); }
+
+  percentile(percentile) {
+    if (typeof percentile !== 'number') {
+      const errors = lazyErrors();
+      throw new errors.ERR_INVALID_ARG_TYPE('percentile', 'number', percentile);
+    }
+    if (!(percentile > 0 && percentile <= 100)) {
+      const errors = lazyErrors();
+      throw new errors.ERR_INVALID_ARG_VALUE.RangeError(
+        'percentile', percentile);
+    }
+    return this[kHandle].percentile(percentile);
+  }
+
+  get percentiles() {
+    this[kMap].clear();
+    this[kHandle].percentiles(this[kMap]);
+    return this[kMap];
+  }
+
+  [kInspect]() {
+    return {
+      min: this.min,
+      max: this.max,
+      mean: this.mean,
+      stddev: this.stddev,
+      percentiles: this.percentiles,
+      exceeds: this.exceeds
+    };
+  }
+}
+
+function monitorEventLoopDelay(options = {}) {
+  if (typeof options !== 'object' || options === null) {
+    const errors = lazyErrors();
+    throw new errors.ERR_INVALID_ARG_TYPE('options', 'Object', options);
+  }
+  const { resolution = 10 } = options;
+  validateInt32(resolution, 'options.resolution', 1);
+  return new ELDHistogram(new _ELDHistogram(resolution));
+}
+
+let busyPollStats;
+
+// Counters of the --loop-busy-poll mode of this thread's event loop. They
+// stay at zero on platforms that do not support it.
+function eventLoopBusyPoll() {
+  if (busyPollStats === undefined)
+    busyPollStats = new Float64Array(4);
+  getLoopBusyPollStats(busyPollStats);
+  return {
+    budget: busyPollStats[0],
+    polls: busyPollStats[1],
+    hits: busyPollStats[2],
+    blocks: busyPollStats[3]
+  };
+}
+
 module.exports = {
   performance,
-  PerformanceObserver
+  PerformanceObserver,
+  eventLoopBusyPoll,
+  monitorEventLoopDelay,
+  threadpool
 };
 
 Object.defineProperty(module.exports, 'constants', {
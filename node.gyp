@@ -90,6 +90,7 @@
       'lib/internal/child_process.js',
       'lib/internal/cluster/child.js',
       'lib/internal/cluster/master.js',
+      'lib/internal/cluster/reuseport_handle.js',
       'lib/internal/cluster/round_robin_handle.js',
       'lib/internal/cluster/shared_handle.js',
       'lib/internal/cluster/utils.js',
@@ -115,10 +116,10 @@
       'lib/internal/fixed_queue.js',
       'lib/internal/freelist.js',
       'lib/internal/fs/promises.js',
-      'lib/internal/fs/read_file_context.js',
       'lib/internal/fs/streams.js',
       'lib/internal/fs/sync_write_stream.js',
       'lib/internal/fs/utils.js',
+      'lib/internal/fs/walk.js',
       'lib/internal/fs/watchers.js',
       'lib/internal/http.js',
       'lib/internal/inspector_async_hook.js',
@@ -336,6 +337,7 @@
         'src/fs_event_wrap.cc',
         'src/handle_wrap.cc',
         'src/heap_utils.cc',
+        'src/http_header_names.cc',
         'src/js_stream.cc',
         'src/module_wrap.cc',
         'src/node.cc',
@@ -371,6 +373,7 @@
         'src/node_zlib.cc',
         'src/node_i18n.cc',
         'src/pipe_wrap.cc',
+        'src/read_buffer_pool.cc',
         'src/process_wrap.cc',
         'src/sharedarraybuffer_metadata.cc',
         'src/signal_wrap.cc',
@@ -403,6 +406,9 @@
         'src/env.h',
         'src/env-inl.h',
         'src/handle_wrap.h',
+        'src/http_header_names.h',
+        'src/histogram.h',
+        'src/histogram-inl.h',
         'src/js_stream.h',
         'src/module_wrap.h',
         'src/node.h',
@@ -433,6 +439,7 @@
         'src/memory_tracker.h',
         'src/memory_tracker-inl.h',
         'src/pipe_wrap.h',
+        'src/read_buffer_pool.h',
         'src/tty_wrap.h',
         'src/tcp_wrap.h',
         'src/udp_wrap.h',
@@ -925,7 +932,11 @@
         'test/cctest/test_base64.cc',
         'test/cctest/test_node_postmortem_metadata.cc',
         'test/cctest/test_environment.cc',
+        'test/cctest/test_histogram.cc',
+        'test/cctest/test_http2_arena.cc',
+        'test/cctest/test_http_header_names.cc',
         'test/cctest/test_platform.cc',
+        'test/cctest/test_read_buffer_pool.cc',
         'test/cctest/test_traced_value.cc',
         'test/cctest/test_util.cc',
         'test/cctest/test_url.cc'
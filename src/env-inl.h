@@ -540,6 +540,31 @@ inline void Environment::set_http2_state(
   http2_state_ = std::move(buffer);
 }
 
+inline StreamIdleTimeouts* Environment::stream_idle_timeouts() const {
+  return stream_idle_timeouts_;
+}
+
+inline void Environment::set_stream_idle_timeouts(
+    StreamIdleTimeouts* timeouts) {
+  stream_idle_timeouts_ = timeouts;
+}
+
+inline ReadBufferPool* Environment::read_buffer_pool() const {
+  return read_buffer_pool_;
+}
+
+inline void Environment::set_read_buffer_pool(ReadBufferPool* pool) {
+  read_buffer_pool_ = pool;
+}
+
+inline HTTPHeaderNames* Environment::http_header_names() const {
+  return http_header_names_;
+}
+
+inline void Environment::set_http_header_names(HTTPHeaderNames* names) {
+  http_header_names_ = names;
+}
+
 bool Environment::debug_enabled(DebugCategory category) const {
 #ifdef DEBUG
   CHECK_GE(static_cast<int>(category), 0);
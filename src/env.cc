@@ -6,6 +6,8 @@
 #include "node_file.h"
 #include "node_context_data.h"
 #include "node_worker.h"
+#include "http_header_names.h"
+#include "read_buffer_pool.h"
 #include "tracing/agent.h"
 
 #include <stdio.h>
@@ -223,6 +225,8 @@ Environment::~Environment() {
   delete[] heap_statistics_buffer_;
   delete[] heap_space_statistics_buffer_;
   delete[] http_parser_buffer_;
+  delete read_buffer_pool_;
+  delete http_header_names_;
 }
 
 void Environment::Start(const std::vector<std::string>& args,
@@ -241,6 +245,23 @@ void Environment::Start(const std::vector<std::string>& args,
 
   uv_check_start(immediate_check_handle(), CheckImmediate);
 
+  // Have libuv account for the time spent waiting for I/O, which is what
+  // performance.eventLoopUtilization() is based on.
+  uv_loop_configure(event_loop(), UV_METRICS_IDLE_TIME);
+
+  // Not supported everywhere; it is a tuning knob, so ignore UV_ENOSYS.
+  if (per_process_opts->loop_busy_poll > 0) {
+    uv_loop_configure(event_loop(),
+                      UV_LOOP_BUSY_POLL,
+                      static_cast<unsigned int>(
+                          per_process_opts->loop_busy_poll));
+  }
+
+  // Timers that are already running, such as the one behind setTimeout(),
+  // are moved over to the wheel.
+  if (per_process_opts->timer_wheel)
+    CHECK_EQ(0, uv_loop_configure(event_loop(), UV_LOOP_TIMER_WHEEL));
+
   // Inform V8's CPU profiler when we're idle.  The profiler is sampling-based
   // but not all samples are created equal; mark the wall clock time spent in
   // epoll_wait() and friends so profiling tools can filter it out.  The samples
@@ -615,6 +636,12 @@ void Environment::RunTimers(uv_timer_t* handle) {
 void Environment::CheckImmediate(uv_check_t* handle) {
   Environment* env = Environment::from_immediate_check_handle(handle);
 
+  // The check phase directly follows the poll phase, the only place where
+  // the loop's idle time changes, so refreshing it here keeps the copy that
+  // JS sees current for everything except the I/O callbacks of this very
+  // iteration.
+  env->performance_state()->UpdateLoopIdleTime(env->event_loop());
+
   if (env->immediate_info()->count() == 0)
     return;
 
@@ -799,9 +826,14 @@ void Environment::BuildEmbedderGraph(v8::Isolate* isolate,
                                      v8::EmbedderGraph* graph,
                                      void* data) {
   MemoryTracker tracker(isolate, graph);
-  static_cast<Environment*>(data)->ForEachBaseObject([&](BaseObject* obj) {
+  Environment* env = static_cast<Environment*>(data);
+  env->ForEachBaseObject([&](BaseObject* obj) {
     tracker.Track(obj);
   });
+  if (env->read_buffer_pool() != nullptr)
+    tracker.Track(env->read_buffer_pool());
+  if (env->http_header_names() != nullptr)
+    tracker.Track(env->http_header_names());
 }
 
 
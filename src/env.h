@@ -47,6 +47,10 @@ struct nghttp2_rcbuf;
 
 namespace node {
 
+class HTTPHeaderNames;
+class ReadBufferPool;
+class StreamIdleTimeouts;
+
 namespace fs {
 class FileHandleReadWrap;
 }
@@ -221,6 +225,7 @@ struct PackageConfig {
   V(onheaders_string, "onheaders")                                            \
   V(oninit_string, "oninit")                                                  \
   V(onmessage_string, "onmessage")                                            \
+  V(onmessagebatch_string, "onmessagebatch")                                  \
   V(onnewsession_string, "onnewsession")                                      \
   V(onocspresponse_string, "onocspresponse")                                  \
   V(ongoawaydata_string, "ongoawaydata")                                      \
@@ -230,10 +235,12 @@ struct PackageConfig {
   V(onreadstart_string, "onreadstart")                                        \
   V(onreadstop_string, "onreadstop")                                          \
   V(onping_string, "onping")                                                  \
+  V(onprogress_string, "onprogress")                                          \
   V(onsettings_string, "onsettings")                                          \
   V(onshutdown_string, "onshutdown")                                          \
   V(onsignal_string, "onsignal")                                              \
   V(onstreamclose_string, "onstreamclose")                                    \
+  V(ontimeout_string, "ontimeout")                                            \
   V(ontrailers_string, "ontrailers")                                          \
   V(onunpipe_string, "onunpipe")                                              \
   V(onwrite_string, "onwrite")                                                \
@@ -691,6 +698,21 @@ class Environment {
   inline http2::Http2State* http2_state() const;
   inline void set_http2_state(std::unique_ptr<http2::Http2State> state);
 
+  // Created on first use by LibuvStreamWrap::SetIdleTimeout(), and deleted
+  // when the Environment's handles are cleaned up.
+  inline StreamIdleTimeouts* stream_idle_timeouts() const;
+  inline void set_stream_idle_timeouts(StreamIdleTimeouts* timeouts);
+
+  // Created on first use by ReadBufferPool::Get(), and deleted along with
+  // the Environment.
+  inline ReadBufferPool* read_buffer_pool() const;
+  inline void set_read_buffer_pool(ReadBufferPool* pool);
+
+  // Created on first use by HTTPHeaderNames::Get(), and deleted along with
+  // the Environment.
+  inline HTTPHeaderNames* http_header_names() const;
+  inline void set_http_header_names(HTTPHeaderNames* names);
+
   inline bool debug_enabled(DebugCategory category) const;
   inline void set_debug_enabled(DebugCategory category, bool enabled);
   void set_debug_categories(const std::string& cats, bool enabled);
@@ -962,6 +984,9 @@ class Environment {
   char* http_parser_buffer_;
   bool http_parser_buffer_in_use_ = false;
   std::unique_ptr<http2::Http2State> http2_state_;
+  StreamIdleTimeouts* stream_idle_timeouts_ = nullptr;
+  ReadBufferPool* read_buffer_pool_ = nullptr;
+  HTTPHeaderNames* http_header_names_ = nullptr;
 
   bool debug_enabled_[static_cast<int>(DebugCategory::CATEGORY_COUNT)] = {0};
 
@@ -0,0 +1,128 @@
+#ifndef SRC_HISTOGRAM_INL_H_
+#define SRC_HISTOGRAM_INL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "histogram.h"
+#include "util.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace node {
+
+Histogram::Histogram(int64_t highest) : highest_(highest) {
+  CHECK_GE(highest, kSubBuckets);
+  counts_.resize(IndexOf(highest) + 1);
+}
+
+void Histogram::Reset() {
+  std::fill(counts_.begin(), counts_.end(), 0);
+  count_ = 0;
+  exceeds_ = 0;
+  min_ = 0;
+  max_ = 0;
+  mean_ = 0;
+  m2_ = 0;
+}
+
+// Values below kSubBuckets get a bucket of their own. Above that, a value
+// is shifted right until it fits in [kSubBuckets / 2, kSubBuckets), and the
+// number of shifts selects the group of kSubBuckets / 2 buckets it goes in.
+size_t Histogram::IndexOf(int64_t value) const {
+  if (value < kSubBuckets)
+    return static_cast<size_t>(value);
+  int shift = 0;
+  while ((value >> shift) >= kSubBuckets)
+    shift++;
+  int64_t top = value >> shift;
+  return static_cast<size_t>(
+      kSubBuckets + (shift - 1) * kHalfSubBuckets + (top - kHalfSubBuckets));
+}
+
+int64_t Histogram::HighestEquivalentValue(size_t index) const {
+  int64_t i = static_cast<int64_t>(index);
+  if (i < kSubBuckets)
+    return i;
+  i -= kSubBuckets;
+  int shift = static_cast<int>(i / kHalfSubBuckets) + 1;
+  int64_t top = kHalfSubBuckets + i % kHalfSubBuckets;
+  return ((top + 1) << shift) - 1;
+}
+
+bool Histogram::Record(int64_t value) {
+  if (value < 0)
+    return false;
+  if (value > highest_) {
+    exceeds_++;
+    return false;
+  }
+
+  counts_[IndexOf(value)]++;
+  if (count_ == 0 || value < min_)
+    min_ = value;
+  if (value > max_)
+    max_ = value;
+
+  count_++;
+  double delta = value - mean_;
+  mean_ += delta / count_;
+  m2_ += delta * (value - mean_);
+  return true;
+}
+
+int64_t Histogram::Min() const {
+  return min_;
+}
+
+int64_t Histogram::Max() const {
+  return max_;
+}
+
+double Histogram::Mean() const {
+  return count_ > 0 ? mean_ : NAN;
+}
+
+double Histogram::Stddev() const {
+  return count_ > 0 ? std::sqrt(m2_ / count_) : NAN;
+}
+
+int64_t Histogram::Percentile(double percentile) const {
+  if (count_ == 0)
+    return 0;
+  if (percentile <= 0)
+    return min_;
+  if (percentile >= 100)
+    return max_;
+
+  int64_t target = std::max<int64_t>(
+      1, static_cast<int64_t>(percentile / 100 * count_ + 0.5));
+  int64_t seen = 0;
+  for (size_t i = 0; i < counts_.size(); i++) {
+    seen += counts_[i];
+    if (seen >= target)
+      return std::min(HighestEquivalentValue(i), max_);
+  }
+  return max_;
+}
+
+template <typename Fn>
+void Histogram::Percentiles(Fn&& fn) const {
+  if (count_ == 0)
+    return;
+  fn(0.0, min_);
+  for (double percentile = 50; percentile < 100;
+       percentile += (100 - percentile) / 2) {
+    int64_t value = Percentile(percentile);
+    if (value >= max_)
+      break;
+    fn(percentile, value);
+  }
+  fn(100.0, max_);
+}
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_HISTOGRAM_INL_H_
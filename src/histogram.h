@@ -0,0 +1,68 @@
+#ifndef SRC_HISTOGRAM_H_
+#define SRC_HISTOGRAM_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace node {
+
+// A log-linear histogram in the style of HdrHistogram: every power of two is
+// split into kSubBuckets / 2 linear sub-buckets, so a recorded value is never
+// reported with a relative error above 2 / kSubBuckets. Values from 0 up to
+// the highest trackable value are accepted; larger ones are only counted
+// in Exceeds().
+class Histogram {
+ public:
+  static constexpr int kSubBucketBits = 7;
+  static constexpr int64_t kSubBuckets = int64_t{1} << kSubBucketBits;
+  static constexpr int64_t kHalfSubBuckets = kSubBuckets / 2;
+
+  inline explicit Histogram(int64_t highest);
+
+  inline void Reset();
+
+  // Returns false if the value was out of range and has not been recorded.
+  inline bool Record(int64_t value);
+
+  inline int64_t Min() const;
+  inline int64_t Max() const;
+  inline double Mean() const;
+  inline double Stddev() const;
+  inline int64_t Count() const { return count_; }
+  inline int64_t Exceeds() const { return exceeds_; }
+  inline int64_t Highest() const { return highest_; }
+
+  // Returns the highest value that at least |percentile| percent of the
+  // recorded values are less than or equal to.
+  inline int64_t Percentile(double percentile) const;
+
+  // Calls fn(percentile, value) for the 0th percentile, for percentiles that
+  // close half of the remaining distance to 100 each time (50, 75, 87.5, ...)
+  // while their value is below the maximum, and finally for the 100th.
+  template <typename Fn>
+  inline void Percentiles(Fn&& fn) const;
+
+ private:
+  inline size_t IndexOf(int64_t value) const;
+  inline int64_t HighestEquivalentValue(size_t index) const;
+
+  const int64_t highest_;
+  std::vector<int64_t> counts_;
+  int64_t count_ = 0;
+  int64_t exceeds_ = 0;
+  int64_t min_ = 0;
+  int64_t max_ = 0;
+  // Running mean and sum of squared differences, updated with Welford's
+  // method so that the mean and stddev are exact rather than bucketed.
+  double mean_ = 0;
+  double m2_ = 0;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_HISTOGRAM_H_
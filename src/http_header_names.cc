@@ -0,0 +1,151 @@
+#include "http_header_names.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "node_internals.h"
+#include "util-inl.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+namespace node {
+
+using v8::Array;
+using v8::Isolate;
+using v8::Local;
+using v8::NewStringType;
+using v8::String;
+
+const HTTPHeaderNames::Name HTTPHeaderNames::kNames[] = {
+#define V(lowercase, canonical) { lowercase, canonical, sizeof(lowercase) - 1 },
+  HTTP_KNOWN_HEADERS(V)
+#undef V
+};
+
+const size_t HTTPHeaderNames::kCount = arraysize(HTTPHeaderNames::kNames);
+
+namespace {
+
+// Open addressing table from the hash of a lowercase name to its index in
+// kNames. Must be a power of two and well above the number of names.
+constexpr size_t kTableSize = 256;
+
+// FNV-1a over the lowercase name.
+inline uint32_t Hash(const char* name, size_t length) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= static_cast<uint8_t>(ToLower(name[i]));
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+}  // anonymous namespace
+
+
+HTTPHeaderNames::HTTPHeaderNames(Environment* env)
+    : env_(env), strings_(new Persistent<String>[2 * kCount]) {
+  Isolate* isolate = env->isolate();
+  for (size_t i = 0; i < kCount; i++) {
+    const char* spellings[] = { kNames[i].lowercase, kNames[i].canonical };
+    for (size_t j = 0; j < arraysize(spellings); j++) {
+      Local<String> string =
+          String::NewFromOneByte(isolate,
+                                 reinterpret_cast<const uint8_t*>(spellings[j]),
+                                 NewStringType::kInternalized,
+                                 kNames[i].length).ToLocalChecked();
+      strings_[2 * i + j].Reset(isolate, string);
+    }
+  }
+}
+
+
+HTTPHeaderNames::~HTTPHeaderNames() {
+  delete[] strings_;
+}
+
+
+HTTPHeaderNames* HTTPHeaderNames::Get(Environment* env) {
+  HTTPHeaderNames* names = env->http_header_names();
+  if (names == nullptr) {
+    names = new HTTPHeaderNames(env);
+    env->set_http_header_names(names);
+  }
+  return names;
+}
+
+
+int HTTPHeaderNames::Lookup(const char* name, size_t length) {
+  struct Table {
+    Table() {
+      static_assert(arraysize(kNames) * 2 <= kTableSize,
+                    "kTableSize is too small");
+      for (size_t i = 0; i < kTableSize; i++)
+        slots[i] = kUnknown;
+      for (size_t i = 0; i < kCount; i++) {
+        size_t slot = Hash(kNames[i].lowercase, kNames[i].length);
+        while (slots[slot & (kTableSize - 1)] != kUnknown)
+          slot++;
+        slots[slot & (kTableSize - 1)] = static_cast<int>(i);
+        max_length = std::max(max_length, kNames[i].length);
+      }
+    }
+
+    int slots[kTableSize];
+    size_t max_length = 0;
+  };
+  static const Table table;
+
+  if (length == 0 || length > table.max_length)
+    return kUnknown;
+
+  for (size_t slot = Hash(name, length);; slot++) {
+    int index = table.slots[slot & (kTableSize - 1)];
+    if (index == kUnknown)
+      return kUnknown;
+    const Name& candidate = kNames[index];
+    if (candidate.length != length)
+      continue;
+    size_t i = 0;
+    while (i < length && ToLower(name[i]) == candidate.lowercase[i])
+      i++;
+    if (i == length)
+      return index;
+  }
+}
+
+
+Local<String> HTTPHeaderNames::ToString(const char* name,
+                                        size_t length) const {
+  Isolate* isolate = env_->isolate();
+  if (length == 0)
+    return String::Empty(isolate);
+
+  int index = Lookup(name, length);
+  if (index != kUnknown) {
+    if (memcmp(name, kNames[index].lowercase, length) == 0)
+      return StrongPersistentToLocal(strings_[2 * index]);
+    if (memcmp(name, kNames[index].canonical, length) == 0)
+      return StrongPersistentToLocal(strings_[2 * index + 1]);
+  }
+  return OneByteString(isolate, name, length);
+}
+
+
+Local<Array> HTTPHeaderNames::ToArray() const {
+  Local<Array> array = Array::New(env_->isolate(), 2 * kCount);
+  for (size_t i = 0; i < 2 * kCount; i++) {
+    array->Set(env_->context(), i,
+               StrongPersistentToLocal(strings_[i])).FromJust();
+  }
+  return array;
+}
+
+
+void HTTPHeaderNames::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackThis(this);
+  tracker->TrackFieldWithSize("strings",
+                              2 * kCount * sizeof(Persistent<String>));
+}
+
+}  // namespace node
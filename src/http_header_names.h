@@ -0,0 +1,137 @@
+#ifndef SRC_HTTP_HEADER_NAMES_H_
+#define SRC_HTTP_HEADER_NAMES_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "base_object.h"
+#include "memory_tracker.h"
+#include "node_persistent.h"
+#include "v8.h"
+
+namespace node {
+
+class Environment;
+
+// Header names that are common enough to be worth recognizing, as
+// V(lowercase spelling, canonical spelling).
+#define HTTP_KNOWN_HEADERS(V)                                                  \
+  V("accept", "Accept")                                                        \
+  V("accept-charset", "Accept-Charset")                                        \
+  V("accept-encoding", "Accept-Encoding")                                      \
+  V("accept-language", "Accept-Language")                                      \
+  V("accept-ranges", "Accept-Ranges")                                          \
+  V("access-control-allow-origin", "Access-Control-Allow-Origin")              \
+  V("access-control-request-headers", "Access-Control-Request-Headers")        \
+  V("access-control-request-method", "Access-Control-Request-Method")          \
+  V("age", "Age")                                                              \
+  V("allow", "Allow")                                                          \
+  V("authorization", "Authorization")                                          \
+  V("cache-control", "Cache-Control")                                          \
+  V("connection", "Connection")                                                \
+  V("content-disposition", "Content-Disposition")                              \
+  V("content-encoding", "Content-Encoding")                                    \
+  V("content-language", "Content-Language")                                    \
+  V("content-length", "Content-Length")                                        \
+  V("content-location", "Content-Location")                                    \
+  V("content-range", "Content-Range")                                          \
+  V("content-type", "Content-Type")                                            \
+  V("cookie", "Cookie")                                                        \
+  V("date", "Date")                                                            \
+  V("dnt", "DNT")                                                              \
+  V("etag", "ETag")                                                            \
+  V("expect", "Expect")                                                        \
+  V("expires", "Expires")                                                      \
+  V("forwarded", "Forwarded")                                                  \
+  V("from", "From")                                                            \
+  V("host", "Host")                                                            \
+  V("if-match", "If-Match")                                                    \
+  V("if-modified-since", "If-Modified-Since")                                  \
+  V("if-none-match", "If-None-Match")                                          \
+  V("if-range", "If-Range")                                                    \
+  V("if-unmodified-since", "If-Unmodified-Since")                              \
+  V("keep-alive", "Keep-Alive")                                                \
+  V("last-modified", "Last-Modified")                                          \
+  V("link", "Link")                                                            \
+  V("location", "Location")                                                    \
+  V("max-forwards", "Max-Forwards")                                            \
+  V("origin", "Origin")                                                        \
+  V("pragma", "Pragma")                                                        \
+  V("proxy-authenticate", "Proxy-Authenticate")                                \
+  V("proxy-authorization", "Proxy-Authorization")                              \
+  V("proxy-connection", "Proxy-Connection")                                    \
+  V("range", "Range")                                                          \
+  V("referer", "Referer")                                                      \
+  V("retry-after", "Retry-After")                                              \
+  V("sec-websocket-key", "Sec-WebSocket-Key")                                  \
+  V("sec-websocket-version", "Sec-WebSocket-Version")                          \
+  V("server", "Server")                                                        \
+  V("set-cookie", "Set-Cookie")                                                \
+  V("strict-transport-security", "Strict-Transport-Security")                  \
+  V("te", "TE")                                                                \
+  V("trailer", "Trailer")                                                      \
+  V("transfer-encoding", "Transfer-Encoding")                                  \
+  V("upgrade", "Upgrade")                                                      \
+  V("upgrade-insecure-requests", "Upgrade-Insecure-Requests")                  \
+  V("user-agent", "User-Agent")                                                \
+  V("vary", "Vary")                                                            \
+  V("via", "Via")                                                              \
+  V("warning", "Warning")                                                      \
+  V("www-authenticate", "WWW-Authenticate")                                    \
+  V("x-forwarded-for", "X-Forwarded-For")                                      \
+  V("x-forwarded-host", "X-Forwarded-Host")                                    \
+  V("x-forwarded-proto", "X-Forwarded-Proto")                                  \
+  V("x-real-ip", "X-Real-IP")                                                  \
+  V("x-request-id", "X-Request-ID")                                            \
+  V("x-requested-with", "X-Requested-With")
+
+// Internalized JS strings for the lowercase and canonical spellings of
+// HTTP_KNOWN_HEADERS, so that the HTTP parser does not have to create new
+// strings for the names of most headers it sees. Since the same string
+// objects are handed to JS every time, JS can in turn look up what it knows
+// about a header without lowercasing its name first.
+class HTTPHeaderNames : public MemoryRetainer {
+ public:
+  static constexpr int kUnknown = -1;
+
+  ~HTTPHeaderNames() override;
+
+  // Returns the names for |env|, creating them if necessary.
+  static HTTPHeaderNames* Get(Environment* env);
+
+  // Returns the index of |name| in HTTP_KNOWN_HEADERS, ignoring case, or
+  // kUnknown.
+  static int Lookup(const char* name, size_t length);
+
+  // Returns a JS string for |name|, which is one of the internalized strings
+  // if it is spelled exactly like one of them.
+  v8::Local<v8::String> ToString(const char* name, size_t length) const;
+
+  // Returns an array of all the internalized strings, lowercase spelling
+  // first for each header.
+  v8::Local<v8::Array> ToArray() const;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  ADD_MEMORY_INFO_NAME(HTTPHeaderNames)
+
+ private:
+  struct Name {
+    const char* lowercase;
+    const char* canonical;
+    size_t length;
+  };
+
+  static const Name kNames[];
+  static const size_t kCount;
+
+  explicit HTTPHeaderNames(Environment* env);
+
+  Environment* const env_;
+  // Two strings for every entry of kNames, lowercase spelling first.
+  Persistent<v8::String>* const strings_;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_HTTP_HEADER_NAMES_H_
@@ -2545,6 +2545,8 @@ void ProcessArgv(std::vector<std::string>* args,
   // TODO(addaleax): Remove.
   zero_fill_all_buffers = per_process_opts->zero_fill_all_buffers;
   no_deprecation = per_process_opts->per_isolate->per_env->no_deprecation;
+  if (per_process_opts->http_parser == "simd")
+    http_parser_set_scan(HTTP_PARSER_SCAN_SIMD);
 #if HAVE_OPENSSL
   ssl_openssl_cert_store = per_process_opts->ssl_openssl_cert_store;
 #if NODE_FIPS_MODE
@@ -2826,6 +2828,30 @@ MultiIsolatePlatform* CreatePlatform(
 }
 
 
+// Applies the --threadpool-* options. They take precedence over the
+// UV_THREADPOOL_*_SHARE and UV_THREADPOOL_*_PRIORITY environment variables.
+static void ConfigureThreadpool() {
+  const std::pair<uv_work_class_t, const std::string*> classes[] = {
+    { UV_WORK_CLASS_FS, &per_process_opts->threadpool_fs },
+    { UV_WORK_CLASS_DNS, &per_process_opts->threadpool_dns },
+    { UV_WORK_CLASS_CPU, &per_process_opts->threadpool_cpu },
+    { UV_WORK_CLASS_USER, &per_process_opts->threadpool_user }
+  };
+  for (const auto& work_class : classes) {
+    if (work_class.second->empty())
+      continue;
+    unsigned int share;
+    int priority;
+    CHECK_EQ(0, uv_threadpool_get_class(work_class.first, nullptr, &priority));
+    // The option string has already been validated by CheckOptions().
+    CHECK(options_parser::ParseThreadpoolClass(*work_class.second,
+                                               &share,
+                                               &priority));
+    CHECK_EQ(0, uv_threadpool_set_class(work_class.first, share, priority));
+  }
+}
+
+
 MultiIsolatePlatform* InitializeV8Platform(int thread_pool_size) {
   v8_platform.Initialize(thread_pool_size);
   return v8_platform.Platform();
@@ -2953,6 +2979,9 @@ Isolate* NewIsolate(ArrayBufferAllocator* allocator, uv_loop_t* event_loop) {
   // Register the isolate on the platform before the isolate gets initialized,
   // so that the isolate can access the platform during initialization.
   v8_platform.Platform()->RegisterIsolate(isolate, event_loop);
+  // V8 asks whether idle tasks are available while it sets up the heap.
+  if (per_process_opts->per_isolate->v8_idle_tasks)
+    v8_platform.Platform()->SetIdleTasksEnabled(isolate, true);
   Isolate::Initialize(isolate, params);
 
   isolate->AddMessageListener(OnMessage);
@@ -3043,6 +3072,7 @@ int Start(int argc, char** argv) {
   V8::SetEntropySource(crypto::EntropySource);
 #endif  // HAVE_OPENSSL
 
+  ConfigureThreadpool();
   InitializeV8Platform(per_process_opts->v8_thread_pool_size);
   V8::Initialize();
   performance::performance_v8_start = PERFORMANCE_NOW();
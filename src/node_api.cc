@@ -3848,7 +3848,8 @@ class Work : public node::AsyncResource, public node::ThreadPoolWork {
     : AsyncResource(env->isolate,
                     async_resource,
                     *v8::String::Utf8Value(env->isolate, async_resource_name)),
-      ThreadPoolWork(node::Environment::GetCurrent(env->isolate)),
+      ThreadPoolWork(node::Environment::GetCurrent(env->isolate),
+                     UV_WORK_CLASS_USER),
       _env(env),
       _data(data),
       _execute(execute),
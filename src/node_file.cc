@@ -21,6 +21,7 @@
 
 #include "aliased_buffer.h"
 #include "node_buffer.h"
+#include "node_errors.h"
 #include "node_internals.h"
 #include "node_stat_watcher.h"
 #include "node_file.h"
@@ -42,6 +43,12 @@
 # include <io.h>
 #endif
 
+#ifndef _WIN32
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+#include <algorithm>
 #include <memory>
 
 namespace node {
@@ -49,6 +56,8 @@ namespace node {
 namespace fs {
 
 using v8::Array;
+using v8::ArrayBuffer;
+using v8::ArrayBufferCreationMode;
 using v8::BigUint64Array;
 using v8::Context;
 using v8::EscapableHandleScope;
@@ -58,6 +67,7 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Int32;
+using v8::Int32Array;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
@@ -69,6 +79,7 @@ using v8::Promise;
 using v8::String;
 using v8::Symbol;
 using v8::Uint32;
+using v8::Uint8Array;
 using v8::Undefined;
 using v8::Value;
 
@@ -492,6 +503,35 @@ void AfterNoArgs(uv_fs_t* req) {
     req_wrap->Resolve(Undefined(req_wrap->env()->isolate()));
 }
 
+// Returns the name fs.copyFile() reports for the mechanism libuv used, or
+// nullptr if the request didn't complete successfully.
+static const char* CopyFileMethodName(const uv_fs_t* req) {
+  switch (uv_fs_get_copyfile_method(req)) {
+    case UV_FS_COPYFILE_METHOD_CLONE: return "clone";
+    case UV_FS_COPYFILE_METHOD_COPY_FILE_RANGE: return "copy_file_range";
+    case UV_FS_COPYFILE_METHOD_SENDFILE: return "sendfile";
+    case UV_FS_COPYFILE_METHOD_SYSTEM: return "system";
+    case UV_FS_COPYFILE_METHOD_NONE: return "none";
+    case UV_FS_COPYFILE_METHOD_COPY_FILE_RANGE_SENDFILE:
+      return "copy_file_range+sendfile";
+    default: return nullptr;
+  }
+}
+
+void AfterCopyFile(uv_fs_t* req) {
+  FSReqBase* req_wrap = FSReqBase::from_req(req);
+  FSReqAfterScope after(req_wrap, req);
+
+  if (after.Proceed()) {
+    Isolate* isolate = req_wrap->env()->isolate();
+    const char* method = CopyFileMethodName(req);
+    if (method == nullptr)
+      req_wrap->Resolve(Undefined(isolate));
+    else
+      req_wrap->Resolve(OneByteString(isolate, method));
+  }
+}
+
 void AfterStat(uv_fs_t* req) {
   FSReqBase* req_wrap = FSReqBase::from_req(req);
   FSReqAfterScope after(req_wrap, req);
@@ -1009,6 +1049,590 @@ static void FStat(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Stats a whole list of paths as one threadpool job, so that a batch costs a
+// single round trip through the threadpool and a single call into JS instead
+// of one of each per path. The result is a flat stats array holding
+// kFsStatsFieldsLength fields per path, and an Int32Array holding 0 or the
+// libuv error code for each path.
+template <typename NativeT, typename V8T>
+class StatManyWork : public ThreadPoolWork {
+ public:
+  StatManyWork(Environment* env,
+               std::vector<std::string>&& paths,
+               bool follow_links)
+      : ThreadPoolWork(env, UV_WORK_CLASS_FS),
+        env_(env),
+        paths_(std::move(paths)),
+        follow_links_(follow_links),
+        fields_(paths_.size() * Environment::kFsStatsFieldsLength),
+        errors_(paths_.size()) {}
+
+  // Takes ownership of |req_wrap|, which is resolved with the result of
+  // ToResult() and deleted once the job has finished.
+  void Dispatch(FSReqBase* req_wrap) {
+    req_wrap_ = req_wrap;
+    ScheduleWork();
+  }
+
+  void DoThreadPoolWork() override {
+    for (size_t i = 0; i < paths_.size(); i++) {
+      const size_t offset = i * Environment::kFsStatsFieldsLength;
+      // The loop is not used by synchronous requests, which is what allows
+      // them to run here.
+      uv_fs_t req;
+      int err = follow_links_ ?
+          uv_fs_stat(nullptr, &req, paths_[i].c_str(), nullptr) :
+          uv_fs_lstat(nullptr, &req, paths_[i].c_str(), nullptr);
+      errors_.data[i] = err;
+      if (err == 0) {
+        FillStatsFields(&fields_.data, &req.statbuf, offset);
+      } else {
+        std::fill_n(fields_.data + offset,
+                    Environment::kFsStatsFieldsLength,
+                    0);
+      }
+      uv_fs_req_cleanup(&req);
+    }
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<StatManyWork> self(this);
+    std::unique_ptr<FSReqBase> req_wrap(req_wrap_);
+    HandleScope handle_scope(env_->isolate());
+    Context::Scope context_scope(env_->context());
+
+    if (status != 0) {
+      req_wrap->Reject(UVException(env_->isolate(), status, "stat"));
+      return;
+    }
+    req_wrap->Resolve(ToResult());
+  }
+
+  // Hands the result buffers over to JS as [stats, errors].
+  Local<Array> ToResult() {
+    Isolate* isolate = env_->isolate();
+    const size_t count = paths_.size();
+    const size_t length = count * Environment::kFsStatsFieldsLength;
+
+    Local<ArrayBuffer> fields_ab =
+        ArrayBuffer::New(isolate,
+                         fields_.release(),
+                         length * sizeof(NativeT),
+                         ArrayBufferCreationMode::kInternalized);
+    Local<ArrayBuffer> errors_ab =
+        ArrayBuffer::New(isolate,
+                         errors_.release(),
+                         count * sizeof(int32_t),
+                         ArrayBufferCreationMode::kInternalized);
+
+    Local<Array> result = Array::New(isolate, 2);
+    result->Set(env_->context(), 0,
+                V8T::New(fields_ab, 0, length)).FromJust();
+    result->Set(env_->context(), 1,
+                Int32Array::New(errors_ab, 0, count)).FromJust();
+    return result;
+  }
+
+ private:
+  Environment* env_;
+  FSReqBase* req_wrap_ = nullptr;
+  std::vector<std::string> paths_;
+  bool follow_links_;
+  MallocedBuffer<NativeT> fields_;
+  MallocedBuffer<int32_t> errors_;
+};
+
+template <typename NativeT, typename V8T>
+static void StatManyImpl(const FunctionCallbackInfo<Value>& args,
+                         std::vector<std::string>&& paths,
+                         bool follow_links,
+                         FSReqBase* req_wrap_async) {
+  Environment* env = Environment::GetCurrent(args);
+  StatManyWork<NativeT, V8T>* work =
+      new StatManyWork<NativeT, V8T>(env, std::move(paths), follow_links);
+
+  if (req_wrap_async != nullptr) {
+    work->Dispatch(req_wrap_async);
+    req_wrap_async->SetReturnValue(args);
+  } else {
+    std::unique_ptr<StatManyWork<NativeT, V8T>> sync_work(work);
+    FS_SYNC_TRACE_BEGIN(statMany);
+    sync_work->DoThreadPoolWork();
+    FS_SYNC_TRACE_END(statMany);
+    args.GetReturnValue().Set(sync_work->ToResult());
+  }
+}
+
+static void StatMany(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+
+  CHECK(args[0]->IsArray());
+  Local<Array> list = args[0].As<Array>();
+  std::vector<std::string> paths;
+  paths.reserve(list->Length());
+  for (uint32_t i = 0; i < list->Length(); i++) {
+    Local<Value> value;
+    if (!list->Get(env->context(), i).ToLocal(&value))
+      return;
+    BufferValue path(env->isolate(), value);
+    CHECK_NOT_NULL(*path);
+    paths.emplace_back(*path, path.length());
+  }
+
+  bool use_bigint = args[1]->IsTrue();
+  bool follow_links = args[2]->IsTrue();
+
+  // statMany(paths, use_bigint, follow_links, req) or
+  // statMany(paths, use_bigint, follow_links, undefined)
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[3], use_bigint);
+  if (use_bigint) {
+    StatManyImpl<uint64_t, BigUint64Array>(args, std::move(paths),
+                                           follow_links, req_wrap_async);
+  } else {
+    StatManyImpl<double, Float64Array>(args, std::move(paths),
+                                       follow_links, req_wrap_async);
+  }
+}
+
+// Scans a list of directories as one threadpool job for fs.walk(). The JS
+// side owns the traversal stack and the filtering, it hands over the next few
+// directories to scan and gets all of their entries back in one go:
+//
+//   [names, types, counts, ids]
+//
+// |names| is a single string with the entry names separated by NUL bytes,
+// |types| holds a UV_DIRENT_* value per entry and |counts| holds the number
+// of entries for each directory, or a negative libuv error code if it could
+// not be read. When symlinks are followed, |types| describes the target and
+// |ids| holds the device and inode number of every directory entry, so that
+// the walker can detect cycles. Otherwise |ids| is undefined.
+class WalkWork : public ThreadPoolWork {
+ public:
+  WalkWork(Environment* env,
+           std::vector<std::string>&& dirs,
+           bool follow_links)
+      : ThreadPoolWork(env, UV_WORK_CLASS_FS),
+        env_(env),
+        dirs_(std::move(dirs)),
+        follow_links_(follow_links) {}
+
+  // Takes ownership of |req_wrap|, which is resolved with the result of
+  // ToResult() and deleted once the job has finished.
+  void Dispatch(FSReqBase* req_wrap) {
+    req_wrap_ = req_wrap;
+    ScheduleWork();
+  }
+
+  void DoThreadPoolWork() override {
+    counts_.reserve(dirs_.size());
+    for (const std::string& dir : dirs_)
+      counts_.push_back(ScanDirectory(dir));
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<WalkWork> self(this);
+    std::unique_ptr<FSReqBase> req_wrap(req_wrap_);
+    HandleScope handle_scope(env_->isolate());
+    Context::Scope context_scope(env_->context());
+
+    if (status != 0) {
+      req_wrap->Reject(UVException(env_->isolate(), status, "scandir"));
+      return;
+    }
+
+    Local<Value> result;
+    if (ToResult().ToLocal(&result))
+      req_wrap->Resolve(result);
+    else
+      req_wrap->Reject(UVException(env_->isolate(), UV_ENOMEM, "scandir"));
+  }
+
+  MaybeLocal<Array> ToResult() {
+    Isolate* isolate = env_->isolate();
+    Local<Context> context = env_->context();
+
+    Local<String> names;
+    if (!String::NewFromUtf8(isolate,
+                             names_.data(),
+                             v8::NewStringType::kNormal,
+                             names_.size()).ToLocal(&names)) {
+      return MaybeLocal<Array>();
+    }
+
+    Local<ArrayBuffer> types_ab = ArrayBuffer::New(isolate, types_.size());
+    if (!types_.empty())
+      memcpy(types_ab->GetContents().Data(), types_.data(), types_.size());
+
+    const size_t counts_size = counts_.size() * sizeof(counts_[0]);
+    Local<ArrayBuffer> counts_ab = ArrayBuffer::New(isolate, counts_size);
+    if (!counts_.empty())
+      memcpy(counts_ab->GetContents().Data(), counts_.data(), counts_size);
+
+    Local<Value> ids = Undefined(isolate);
+    if (follow_links_) {
+      const size_t ids_size = ids_.size() * sizeof(ids_[0]);
+      Local<ArrayBuffer> ids_ab = ArrayBuffer::New(isolate, ids_size);
+      if (!ids_.empty())
+        memcpy(ids_ab->GetContents().Data(), ids_.data(), ids_size);
+      ids = BigUint64Array::New(ids_ab, 0, ids_.size());
+    }
+
+    Local<Array> result = Array::New(isolate, 4);
+    result->Set(context, 0, names).FromJust();
+    result->Set(context, 1,
+                Uint8Array::New(types_ab, 0, types_.size())).FromJust();
+    result->Set(context, 2,
+                Int32Array::New(counts_ab, 0, counts_.size())).FromJust();
+    result->Set(context, 3, ids).FromJust();
+    return result;
+  }
+
+ private:
+  // Appends the entries of |dir| and returns how many there were, or a
+  // libuv error code.
+  int32_t ScanDirectory(const std::string& dir) {
+    // The loop is not used by synchronous requests, which is what allows
+    // them to run here.
+    uv_fs_t req;
+    int err = uv_fs_scandir(nullptr, &req, dir.c_str(), 0, nullptr);
+    if (err < 0) {
+      uv_fs_req_cleanup(&req);
+      return err;
+    }
+
+    int32_t count = 0;
+    uv_dirent_t ent;
+    while ((err = uv_fs_scandir_next(&req, &ent)) == 0) {
+      std::string path = dir + kPathSeparator[0] + ent.name;
+      uv_dirent_type_t type = ent.type;
+      uv_stat_t* statbuf = nullptr;
+      uv_fs_t stat_req;
+
+      // Not every filesystem reports entry types, and directories reached
+      // through symlinks need their device and inode number.
+      if (type == UV_DIRENT_UNKNOWN ||
+          (follow_links_ && (type == UV_DIRENT_LINK ||
+                             type == UV_DIRENT_DIR))) {
+        int r = follow_links_ ?
+            uv_fs_stat(nullptr, &stat_req, path.c_str(), nullptr) :
+            uv_fs_lstat(nullptr, &stat_req, path.c_str(), nullptr);
+        if (r == 0) {
+          statbuf = &stat_req.statbuf;
+          type = TypeFromMode(statbuf->st_mode);
+        }
+        // A dangling symlink stays a symlink, anything else that vanished
+        // in the meantime keeps whatever type readdir reported.
+        uv_fs_req_cleanup(&stat_req);
+      }
+
+      names_.append(ent.name);
+      names_.push_back('\0');
+      types_.push_back(static_cast<uint8_t>(type));
+      if (follow_links_) {
+        ids_.push_back(statbuf != nullptr ? statbuf->st_dev : 0);
+        ids_.push_back(statbuf != nullptr ? statbuf->st_ino : 0);
+      }
+      count++;
+    }
+
+    uv_fs_req_cleanup(&req);
+    return err == UV_EOF ? count : err;
+  }
+
+  static uv_dirent_type_t TypeFromMode(uint64_t mode) {
+    switch (mode & S_IFMT) {
+      case S_IFREG: return UV_DIRENT_FILE;
+      case S_IFDIR: return UV_DIRENT_DIR;
+#ifdef S_IFLNK
+      case S_IFLNK: return UV_DIRENT_LINK;
+#endif
+#ifdef S_IFIFO
+      case S_IFIFO: return UV_DIRENT_FIFO;
+#endif
+#ifdef S_IFSOCK
+      case S_IFSOCK: return UV_DIRENT_SOCKET;
+#endif
+      case S_IFCHR: return UV_DIRENT_CHAR;
+#ifdef S_IFBLK
+      case S_IFBLK: return UV_DIRENT_BLOCK;
+#endif
+      default: return UV_DIRENT_UNKNOWN;
+    }
+  }
+
+  Environment* env_;
+  FSReqBase* req_wrap_ = nullptr;
+  std::vector<std::string> dirs_;
+  bool follow_links_;
+  std::string names_;
+  std::vector<uint8_t> types_;
+  std::vector<int32_t> counts_;
+  std::vector<uint64_t> ids_;
+};
+
+// walk(dirs, follow_links, req)
+static void Walk(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+
+  CHECK(args[0]->IsArray());
+  Local<Array> list = args[0].As<Array>();
+  std::vector<std::string> dirs;
+  dirs.reserve(list->Length());
+  for (uint32_t i = 0; i < list->Length(); i++) {
+    Local<Value> value;
+    if (!list->Get(env->context(), i).ToLocal(&value))
+      return;
+    BufferValue path(env->isolate(), value);
+    CHECK_NOT_NULL(*path);
+    dirs.emplace_back(*path, path.length());
+  }
+
+  const bool follow_links = args[1]->IsTrue();
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[2]);
+  CHECK_NOT_NULL(req_wrap_async);
+  WalkWork* work = new WalkWork(env, std::move(dirs), follow_links);
+  work->Dispatch(req_wrap_async);
+  req_wrap_async->SetReturnValue(args);
+}
+
+// Reads a whole file as a single threadpool job. fs.readFile() otherwise needs
+// an open, an fstat, a read per 8 KiB chunk and a close, each of which is a
+// round trip through the threadpool and back into JS. The result is allocated
+// once, at its final size when the file size is known, and is handed to JS
+// either as a Buffer that adopts the memory or decoded as UTF-8.
+class ReadFileWork : public ThreadPoolWork {
+ public:
+  ReadFileWork(Environment* env,
+               std::string&& path,
+               int fd,
+               int flags,
+               bool utf8)
+      : ThreadPoolWork(env, UV_WORK_CLASS_FS),
+        env_(env),
+        path_(std::move(path)),
+        fd_(fd),
+        flags_(flags),
+        utf8_(utf8) {}
+
+  ~ReadFileWork() override {
+    free(data_);
+  }
+
+  // Takes ownership of |req_wrap|, which is resolved with the result of
+  // ToResult() and deleted once the job has finished.
+  void Dispatch(FSReqBase* req_wrap) {
+    req_wrap_ = req_wrap;
+    ScheduleWork();
+  }
+
+  void DoThreadPoolWork() override {
+    // The loop is not used by synchronous requests, which is what allows
+    // them to run here.
+    uv_fs_t req;
+    int fd = fd_;
+    if (fd < 0) {
+      fd = uv_fs_open(nullptr, &req, path_.c_str(), flags_, 0666, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (fd < 0) {
+        SetError(fd, "open");
+        return;
+      }
+    }
+
+    ReadAll(fd);
+
+    // A user supplied fd stays open.
+    if (fd_ < 0) {
+      int err = uv_fs_close(nullptr, &req, fd, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (err < 0)
+        SetError(err, "close");
+    }
+
+    if (err_ == 0 && utf8_) {
+      // Pure ASCII, which is what most config and template files are, can be
+      // copied into a one-byte string instead of going through the UTF-8
+      // decoder on the main thread.
+      is_ascii_ = std::all_of(data_, data_ + length_, [](char c) {
+        return (static_cast<unsigned char>(c) & 0x80) == 0;
+      });
+    }
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<ReadFileWork> self(this);
+    std::unique_ptr<FSReqBase> req_wrap(req_wrap_);
+    HandleScope handle_scope(env_->isolate());
+    Context::Scope context_scope(env_->context());
+
+    if (status != 0) {
+      req_wrap->Reject(UVException(env_->isolate(), status, "read"));
+      return;
+    }
+
+    Local<Value> error;
+    Local<Value> result;
+    if (ToResult(&error).ToLocal(&result))
+      req_wrap->Resolve(result);
+    else
+      req_wrap->Reject(error);
+  }
+
+  // Returns the file contents, or an empty handle with |*error| set.
+  MaybeLocal<Value> ToResult(Local<Value>* error) {
+    Isolate* isolate = env_->isolate();
+
+    if (err_ == kErrTooLarge) {
+      std::string message = "File size (" + std::to_string(size_) +
+                            ") is greater than possible Buffer: " +
+                            std::to_string(Buffer::kMaxLength) + " bytes";
+      *error = ERR_FS_FILE_TOO_LARGE(isolate, message.c_str());
+      return MaybeLocal<Value>();
+    }
+
+    if (err_ < 0) {
+      *error = UVException(isolate, err_, syscall_, nullptr,
+                           fd_ < 0 ? path_.c_str() : nullptr);
+      return MaybeLocal<Value>();
+    }
+
+    if (utf8_) {
+      return StringBytes::Encode(isolate, data_, length_,
+                                 is_ascii_ ? LATIN1 : UTF8, error);
+    }
+
+    if (length_ == 0) {
+      return Buffer::New(env_, static_cast<size_t>(0))
+          .FromMaybe(Local<Object>());
+    }
+
+    // The Buffer adopts the memory.
+    MaybeLocal<Object> buffer = Buffer::New(env_, data_, length_);
+    if (!buffer.IsEmpty())
+      data_ = nullptr;
+    return buffer.FromMaybe(Local<Object>());
+  }
+
+ private:
+  static const int kErrTooLarge = 1;
+
+  // Size of the first read when the file size is unknown, as for pipes and
+  // most files in /proc. The buffer doubles whenever it fills up.
+  static const size_t kUnknownSizeChunk = 64 * 1024;
+
+  void SetError(int err, const char* syscall) {
+    if (err_ != 0)
+      return;
+    err_ = err;
+    syscall_ = syscall;
+  }
+
+  void ReadAll(int fd) {
+    uv_fs_t req;
+    int err = uv_fs_fstat(nullptr, &req, fd, nullptr);
+    const uv_stat_t statbuf = req.statbuf;
+    uv_fs_req_cleanup(&req);
+    if (err < 0)
+      return SetError(err, "fstat");
+
+    const bool size_known =
+        (statbuf.st_mode & S_IFMT) == S_IFREG && statbuf.st_size > 0;
+    size_ = statbuf.st_size;
+    if (size_known && size_ > Buffer::kMaxLength)
+      return SetError(kErrTooLarge, "read");
+
+    size_t capacity = size_known ? size_ : kUnknownSizeChunk;
+    data_ = UncheckedMalloc(capacity);
+    if (data_ == nullptr)
+      return SetError(UV_ENOMEM, "read");
+
+    for (;;) {
+      if (length_ == capacity) {
+        // A file with a known size is done once that much has been read.
+        if (size_known)
+          break;
+        if (capacity == Buffer::kMaxLength) {
+          size_ = capacity + 1;
+          return SetError(kErrTooLarge, "read");
+        }
+        capacity = std::min<size_t>(capacity * 2, Buffer::kMaxLength);
+        char* data = UncheckedRealloc(data_, capacity);
+        if (data == nullptr)
+          return SetError(UV_ENOMEM, "read");
+        data_ = data;
+      }
+
+      uv_buf_t buf = uv_buf_init(data_ + length_, capacity - length_);
+      // Read from the current position, like fs.readFile() does with a user
+      // supplied fd.
+      int nread = uv_fs_read(nullptr, &req, fd, &buf, 1, -1, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (nread < 0)
+        return SetError(nread, "read");
+      if (nread == 0)
+        break;
+      length_ += nread;
+    }
+
+    // Don't let the Buffer hold on to the slack of the last doubling.
+    if (length_ > 0 && length_ < capacity) {
+      char* data = UncheckedRealloc(data_, length_);
+      if (data != nullptr)
+        data_ = data;
+    }
+  }
+
+  Environment* env_;
+  FSReqBase* req_wrap_ = nullptr;
+  std::string path_;
+  int fd_;
+  int flags_;
+  bool utf8_;
+  int err_ = 0;
+  const char* syscall_ = nullptr;
+  uint64_t size_ = 0;
+  char* data_ = nullptr;
+  size_t length_ = 0;
+  bool is_ascii_ = false;
+};
+
+// readFileUtf8(path | fd, flags, req)
+// readFileBuffer(path | fd, flags, req)
+template <bool utf8>
+static void ReadFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+
+  std::string path;
+  int fd = -1;
+  if (args[0]->IsInt32()) {
+    fd = args[0].As<Int32>()->Value();
+    CHECK_GE(fd, 0);
+  } else {
+    BufferValue value(env->isolate(), args[0]);
+    CHECK_NOT_NULL(*value);
+    path.assign(*value, value.length());
+  }
+
+  CHECK(args[1]->IsInt32());
+  const int flags = args[1].As<Int32>()->Value();
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[2]);
+  CHECK_NOT_NULL(req_wrap_async);
+  ReadFileWork* work = new ReadFileWork(env, std::move(path), fd, flags, utf8);
+  work->Dispatch(req_wrap_async);
+  req_wrap_async->SetReturnValue(args);
+}
+
 static void Symlink(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -1657,15 +2281,20 @@ static void CopyFile(const FunctionCallbackInfo<Value>& args) {
   FSReqBase* req_wrap_async = GetReqWrap(env, args[3]);
   if (req_wrap_async != nullptr) {  // copyFile(src, dest, flags, req)
     AsyncDestCall(env, req_wrap_async, args, "copyfile",
-                  *dest, dest.length(), UTF8, AfterNoArgs,
+                  *dest, dest.length(), UTF8, AfterCopyFile,
                   uv_fs_copyfile, *src, *dest, flags);
-  } else {  // copyFile(src, dest, flags, undefined, ctx)
+  } else {  // method = copyFile(src, dest, flags, undefined, ctx)
     CHECK_EQ(argc, 5);
     FSReqWrapSync req_wrap_sync;
     FS_SYNC_TRACE_BEGIN(copyfile);
-    SyncCall(env, args[4], &req_wrap_sync, "copyfile",
-             uv_fs_copyfile, *src, *dest, flags);
+    int err = SyncCall(env, args[4], &req_wrap_sync, "copyfile",
+                       uv_fs_copyfile, *src, *dest, flags);
     FS_SYNC_TRACE_END(copyfile);
+    if (err < 0)
+      return;  // error info is in ctx
+    const char* method = CopyFileMethodName(&req_wrap_sync.req);
+    if (method != nullptr)
+      args.GetReturnValue().Set(OneByteString(env->isolate(), method));
   }
 }
 
@@ -2172,6 +2801,135 @@ static void Mkdtemp(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+#ifndef _WIN32
+// A file mapping that backs a Buffer. The mapping itself starts at a page
+// boundary, so |base| may point before the first byte of the Buffer.
+struct MappedRegion {
+  void* base;
+  size_t length;
+};
+
+static void UnmapRegion(char* data, void* hint) {
+  MappedRegion* region = static_cast<MappedRegion*>(hint);
+  CHECK_EQ(munmap(region->base, region->length), 0);
+  delete region;
+}
+
+// Keep in sync with kMapAdvice in lib/internal/fs/promises.js.
+static int ToMadviseAdvice(int advice) {
+  switch (advice) {
+    case 1: return MADV_RANDOM;
+    case 2: return MADV_SEQUENTIAL;
+    case 3: return MADV_WILLNEED;
+    case 4: return MADV_DONTNEED;
+    default: return MADV_NORMAL;
+  }
+}
+#endif  // _WIN32
+
+static void SetSyncError(Environment* env,
+                         Local<Value> ctx,
+                         int err,
+                         const char* syscall) {
+  Local<Object> ctx_obj = ctx.As<Object>();
+  ctx_obj->Set(env->context(), env->errno_string(),
+               Integer::New(env->isolate(), err)).FromJust();
+  ctx_obj->Set(env->context(), env->syscall_string(),
+               OneByteString(env->isolate(), syscall)).FromJust();
+}
+
+// buffer = mmap(fd, offset, length, shared, readonly, advice, ctx)
+static void Mmap(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_EQ(argc, 7);
+
+  CHECK(args[0]->IsInt32());
+  const int fd = args[0].As<Int32>()->Value();
+
+  CHECK(args[1]->IsNumber());
+  const int64_t offset = args[1].As<Integer>()->Value();
+  CHECK_GE(offset, 0);
+
+  CHECK(args[2]->IsNumber());
+  const int64_t length = args[2].As<Integer>()->Value();
+  CHECK_GT(length, 0);
+  CHECK_LE(static_cast<uint64_t>(length), Buffer::kMaxLength);
+
+  const bool shared = args[3]->IsTrue();
+  const bool readonly = args[4]->IsTrue();
+
+  CHECK(args[5]->IsInt32());
+  const int advice = args[5].As<Int32>()->Value();
+
+#ifdef _WIN32
+  SetSyncError(env, args[6], UV_ENOSYS, "mmap");
+#else
+  // mmap() wants a page-aligned offset, so map from the start of the page
+  // that contains |offset| and hand out a Buffer that skips the slack.
+  static const int64_t page_size = sysconf(_SC_PAGESIZE);
+  const int64_t slack = offset % page_size;
+  const size_t map_length = static_cast<size_t>(length + slack);
+
+  const int prot = readonly ? PROT_READ : PROT_READ | PROT_WRITE;
+  const int flags = shared ? MAP_SHARED : MAP_PRIVATE;
+
+  void* base = mmap(nullptr, map_length, prot, flags, fd, offset - slack);
+  if (base == MAP_FAILED) {
+    SetSyncError(env, args[6], uv_translate_sys_error(errno), "mmap");
+    return;
+  }
+
+  // The advice is only a hint, failing to apply it isn't worth an error.
+  if (advice != 0)
+    madvise(base, map_length, ToMadviseAdvice(advice));
+
+  MappedRegion* region = new MappedRegion { base, map_length };
+  Local<Object> buffer;
+  if (!Buffer::New(env,
+                   static_cast<char*>(base) + slack,
+                   static_cast<size_t>(length),
+                   UnmapRegion,
+                   region).ToLocal(&buffer)) {
+    UnmapRegion(nullptr, region);
+    return;
+  }
+  args.GetReturnValue().Set(buffer);
+#endif  // _WIN32
+}
+
+// madvise(buffer, advice, ctx)
+static void Madvise(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_EQ(argc, 3);
+
+  CHECK(args[1]->IsInt32());
+  const int advice = args[1].As<Int32>()->Value();
+
+#ifdef _WIN32
+  SetSyncError(env, args[2], UV_ENOSYS, "madvise");
+#else
+  SPREAD_BUFFER_ARG(args[0], view);
+  if (view_length == 0)
+    return;
+
+  // madvise() works on whole pages. The callers only pass views of mapped
+  // regions, which always span complete pages, so widening is safe.
+  static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  const uintptr_t start = reinterpret_cast<uintptr_t>(view_data);
+  const uintptr_t aligned = start - start % page_size;
+
+  if (madvise(reinterpret_cast<void*>(aligned),
+              start + view_length - aligned,
+              ToMadviseAdvice(advice)) != 0) {
+    SetSyncError(env, args[2], uv_translate_sys_error(errno), "madvise");
+  }
+#endif  // _WIN32
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -2195,6 +2953,10 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "stat", Stat);
   env->SetMethod(target, "lstat", LStat);
   env->SetMethod(target, "fstat", FStat);
+  env->SetMethod(target, "statMany", StatMany);
+  env->SetMethod(target, "walk", Walk);
+  env->SetMethod(target, "readFileUtf8", ReadFile<true>);
+  env->SetMethod(target, "readFileBuffer", ReadFile<false>);
   env->SetMethod(target, "link", Link);
   env->SetMethod(target, "symlink", Symlink);
   env->SetMethod(target, "readlink", ReadLink);
@@ -2204,6 +2966,8 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "writeString", WriteString);
   env->SetMethod(target, "realpath", RealPath);
   env->SetMethod(target, "copyFile", CopyFile);
+  env->SetMethod(target, "mmap", Mmap);
+  env->SetMethod(target, "madvise", Madvise);
 
   env->SetMethod(target, "chmod", Chmod);
   env->SetMethod(target, "fchmod", FChmod);
@@ -505,7 +505,138 @@ Http2Session::Callbacks::~Callbacks() {
   nghttp2_session_callbacks_del(callbacks);
 }
 
-// Track memory allocated by nghttp2 using a custom allocator.
+namespace {
+
+// The sizes of the blocks handed out by Http2Arena, including their header.
+// Anything larger, such as frame buffers, is left to malloc().
+const size_t kArenaBlockSizes[] = {
+  32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024
+};
+static_assert(arraysize(kArenaBlockSizes) == Http2Arena::kSizeClassCount,
+              "kArenaBlockSizes does not match kSizeClassCount");
+
+constexpr size_t kArenaBlocksPerSlab = 16;
+
+constexpr size_t kArenaBlockTag =
+    static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1);
+constexpr size_t kArenaDetachedTag = kArenaBlockTag >> 1;
+
+}  // anonymous namespace
+
+struct Http2Arena::Slab {
+  Slab* next;
+  // The number of blocks in use, including detached ones.
+  size_t live;
+  // Reset when the arena is gone, but detached blocks are still in use.
+  Http2Arena* arena;
+};
+
+struct Http2Arena::Block {
+  Slab* slab;
+  // kArenaBlockTag, kArenaDetachedTag and the index of the size class.
+  size_t tag;
+};
+
+Http2Arena::~Http2Arena() {
+  Slab* slab = slabs_;
+  while (slab != nullptr) {
+    Slab* next = slab->next;
+    if (slab->live == 0)
+      free(slab);
+    else
+      slab->arena = nullptr;
+    slab = next;
+  }
+}
+
+void* Http2Arena::Allocate(size_t size) {
+  if (size > kArenaBlockSizes[kSizeClassCount - 1] - sizeof(Block))
+    return nullptr;
+  size_t index = 0;
+  while (kArenaBlockSizes[index] - sizeof(Block) < size)
+    index++;
+
+  SizeClass& size_class = classes_[index];
+  Block* block = size_class.free_list;
+  if (block != nullptr) {
+    // Free blocks are linked through their first word.
+    size_class.free_list = *reinterpret_cast<Block**>(block + 1);
+  } else {
+    if (size_class.next == size_class.end) {
+      size_t length = kArenaBlocksPerSlab * kArenaBlockSizes[index];
+      Slab* slab =
+          reinterpret_cast<Slab*>(UncheckedMalloc(sizeof(Slab) + length));
+      if (slab == nullptr)
+        return nullptr;
+      slab->next = slabs_;
+      slab->live = 0;
+      slab->arena = this;
+      slabs_ = slab;
+      slab_bytes_ += sizeof(Slab) + length;
+      size_class.slab = slab;
+      size_class.next = reinterpret_cast<char*>(slab + 1);
+      size_class.end = size_class.next + length;
+    }
+    block = reinterpret_cast<Block*>(size_class.next);
+    block->slab = size_class.slab;
+    size_class.next += kArenaBlockSizes[index];
+  }
+
+  block->slab->live++;
+  block->tag = kArenaBlockTag | index;
+  return block + 1;
+}
+
+void Http2Arena::Free(void* ptr) {
+  CHECK(!IsDetached(ptr));
+  Block* block = static_cast<Block*>(ptr) - 1;
+  SizeClass& size_class = classes_[block->tag & ~kArenaBlockTag];
+  block->slab->live--;
+  *reinterpret_cast<Block**>(ptr) = size_class.free_list;
+  size_class.free_list = block;
+}
+
+bool Http2Arena::Owns(void* ptr) {
+  return (static_cast<Block*>(ptr)[-1].tag & kArenaBlockTag) != 0;
+}
+
+size_t Http2Arena::BlockSize(void* ptr) {
+  size_t tag = static_cast<Block*>(ptr)[-1].tag;
+  size_t index = tag & ~(kArenaBlockTag | kArenaDetachedTag);
+  CHECK_LT(index, kSizeClassCount);
+  return kArenaBlockSizes[index];
+}
+
+size_t Http2Arena::Capacity(void* ptr) {
+  return BlockSize(ptr) - sizeof(Block);
+}
+
+void Http2Arena::Detach(void* ptr) {
+  static_cast<Block*>(ptr)[-1].tag |= kArenaDetachedTag;
+}
+
+bool Http2Arena::IsDetached(void* ptr) {
+  return (static_cast<Block*>(ptr)[-1].tag & kArenaDetachedTag) != 0;
+}
+
+void Http2Arena::FreeDetached(void* ptr) {
+  CHECK(IsDetached(ptr));
+  Block* block = static_cast<Block*>(ptr) - 1;
+  Slab* slab = block->slab;
+  // While the arena is alive, the block goes back to it like any other.
+  // Otherwise the slab is released once nothing in it is in use anymore.
+  if (slab->arena != nullptr) {
+    block->tag &= ~kArenaDetachedTag;
+    slab->arena->Free(ptr);
+  } else if (--slab->live == 0) {
+    free(slab);
+  }
+}
+
+// Track memory allocated by nghttp2 using a custom allocator. Small
+// allocations are served from the session's Http2Arena, the rest from
+// malloc(). Either way, the full size of each block, including its header,
+// counts towards the session's memory.
 class Http2Session::MemoryAllocatorInfo {
  public:
   explicit MemoryAllocatorInfo(Http2Session* session)
@@ -534,6 +665,20 @@ class Http2Session::MemoryAllocatorInfo {
     size_t previous_size = 0;
     char* original_ptr = nullptr;
 
+    if (ptr != nullptr && Http2Arena::Owns(ptr))
+      return ArenaRealloc(ptr, size, session);
+
+    if (ptr == nullptr && size > 0) {
+      void* mem = session->arena_.Allocate(size);
+      if (mem != nullptr) {
+        session->current_nghttp2_memory_ += Http2Arena::BlockSize(mem);
+        session->statistics_.pool_allocations++;
+        session->statistics_.pool_size = session->arena_.slab_bytes();
+        return mem;
+      }
+      session->statistics_.heap_allocations++;
+    }
+
     // We prepend each allocated buffer with a size_t containing the full
     // size of the allocation.
     if (size > 0) size += sizeof(size_t);
@@ -575,7 +720,48 @@ class Http2Session::MemoryAllocatorInfo {
     return mem;
   }
 
+  static void* ArenaRealloc(void* ptr, size_t size, Http2Session* session) {
+    // This block may have outlived its session, so |session| must not be
+    // touched. Move it to untracked memory, like the blocks that come from
+    // malloc(), if it is still needed.
+    if (Http2Arena::IsDetached(ptr)) {
+      char* mem = nullptr;
+      if (size > 0) {
+        mem = UncheckedMalloc(size + sizeof(size_t));
+        if (mem == nullptr)
+          return nullptr;
+        *reinterpret_cast<size_t*>(mem) = 0;
+        mem += sizeof(size_t);
+        memcpy(mem, ptr, std::min(size, Http2Arena::Capacity(ptr)));
+      }
+      Http2Arena::FreeDetached(ptr);
+      return mem;
+    }
+
+    size_t block_size = Http2Arena::BlockSize(ptr);
+    CHECK_GE(session->current_nghttp2_memory_, block_size);
+
+    if (size > 0 && size <= Http2Arena::Capacity(ptr))
+      return ptr;
+
+    void* mem = nullptr;
+    if (size > 0) {
+      mem = H2Malloc(size, session);
+      if (mem == nullptr)
+        return nullptr;
+      memcpy(mem, ptr, Http2Arena::Capacity(ptr));
+    }
+    session->current_nghttp2_memory_ -= block_size;
+    session->arena_.Free(ptr);
+    return mem;
+  }
+
   static void StopTracking(Http2Session* session, void* ptr) {
+    if (Http2Arena::Owns(ptr)) {
+      session->current_nghttp2_memory_ -= Http2Arena::BlockSize(ptr);
+      Http2Arena::Detach(ptr);
+      return;
+    }
     size_t* original_ptr = reinterpret_cast<size_t*>(
         static_cast<char*>(ptr) - sizeof(size_t));
     session->current_nghttp2_memory_ -= *original_ptr;
@@ -722,6 +908,9 @@ void Http2Session::EmitStatistics() {
     buffer[IDX_SESSION_STATS_DATA_RECEIVED] = entry->data_received();
     buffer[IDX_SESSION_STATS_MAX_CONCURRENT_STREAMS] =
         entry->max_concurrent_streams();
+    buffer[IDX_SESSION_STATS_POOL_ALLOCATIONS] = entry->pool_allocations();
+    buffer[IDX_SESSION_STATS_HEAP_ALLOCATIONS] = entry->heap_allocations();
+    buffer[IDX_SESSION_STATS_POOL_SIZE] = entry->pool_size();
     entry->Notify(entry->ToObject());
   }, static_cast<void*>(entry));
 }
@@ -670,6 +670,61 @@ class Http2Stream::Provider::Stream : public Http2Stream::Provider {
                         void* user_data);
 };
 
+// Slab allocator for the small objects that nghttp2 allocates and frees at a
+// high rate, such as streams, HPACK entries and queued frames. Every size
+// class carves blocks out of its own slabs and keeps the blocks that are
+// freed on a free list for reuse. The slabs are only released, all at once,
+// when the arena is destroyed along with its session.
+//
+// Each block is preceded by a header whose last word has the top bit set, so
+// that it can be told apart from the size that prefixes the blocks
+// Http2Session::MemoryAllocatorInfo gets from malloc().
+class Http2Arena {
+ public:
+  Http2Arena() = default;
+  ~Http2Arena();
+
+  // Returns a block with room for |size| bytes, or nullptr if |size| is too
+  // large for any of the size classes or no slab could be allocated.
+  void* Allocate(size_t size);
+  void Free(void* ptr);
+
+  // Whether |ptr| was returned by Allocate() of any arena.
+  static bool Owns(void* ptr);
+  // The size of the block, including its header.
+  static size_t BlockSize(void* ptr);
+  // The number of bytes the caller may use.
+  static size_t Capacity(void* ptr);
+
+  // Detaching a block allows it to outlive its arena. It has to be freed
+  // using FreeDetached(), which does not require the arena to be alive: the
+  // block is returned to the arena if there still is one, otherwise the slab
+  // it is part of is released once all of its blocks have been freed.
+  static void Detach(void* ptr);
+  static bool IsDetached(void* ptr);
+  static void FreeDetached(void* ptr);
+
+  // The number of bytes held in slabs.
+  size_t slab_bytes() const { return slab_bytes_; }
+
+  static constexpr size_t kSizeClassCount = 11;
+
+ private:
+  struct Slab;
+  struct Block;
+  struct SizeClass {
+    Slab* slab = nullptr;
+    char* next = nullptr;
+    char* end = nullptr;
+    Block* free_list = nullptr;
+  };
+
+  SizeClass classes_[kSizeClassCount];
+  Slab* slabs_ = nullptr;
+  size_t slab_bytes_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(Http2Arena);
+};
 
 class Http2Session : public AsyncWrap, public StreamListener {
  public:
@@ -763,6 +818,7 @@ class Http2Session : public AsyncWrap, public StreamListener {
     tracker->TrackFieldWithSize("outgoing_storage", outgoing_storage_.size());
     tracker->TrackFieldWithSize("pending_rst_streams",
                                 pending_rst_streams_.size() * sizeof(int32_t));
+    tracker->TrackFieldWithSize("nghttp2_arena", arena_.slab_bytes());
   }
 
   ADD_MEMORY_INFO_NAME(Http2Session)
@@ -853,6 +909,12 @@ class Http2Session : public AsyncWrap, public StreamListener {
     int32_t stream_count;
     size_t max_concurrent_streams;
     double stream_average_duration;
+    // Allocations by nghttp2 that were served from arena_, and those that
+    // were too large for it.
+    uint64_t pool_allocations;
+    uint64_t heap_allocations;
+    // The number of bytes held by arena_, which only ever grows.
+    uint64_t pool_size;
   };
 
   Statistics statistics_ = {};
@@ -967,6 +1029,9 @@ class Http2Session : public AsyncWrap, public StreamListener {
   uint64_t current_session_memory_ = 0;
   // The amount of memory allocated by nghttp2 internals
   uint64_t current_nghttp2_memory_ = 0;
+  // Where the small allocations by nghttp2 internals come from. This must
+  // outlive session_.
+  Http2Arena arena_;
 
   // The collection of active Http2Streams associated with this session
   std::unordered_map<int32_t, Http2Stream*> streams_;
@@ -1016,6 +1081,9 @@ class Http2SessionPerformanceEntry : public PerformanceEntry {
           stream_count_(stats.stream_count),
           max_concurrent_streams_(stats.max_concurrent_streams),
           stream_average_duration_(stats.stream_average_duration),
+          pool_allocations_(stats.pool_allocations),
+          heap_allocations_(stats.heap_allocations),
+          pool_size_(stats.pool_size),
           session_type_(type) { }
 
   uint64_t ping_rtt() const { return ping_rtt_; }
@@ -1026,6 +1094,9 @@ class Http2SessionPerformanceEntry : public PerformanceEntry {
   int32_t stream_count() const { return stream_count_; }
   size_t max_concurrent_streams() const { return max_concurrent_streams_; }
   double stream_average_duration() const { return stream_average_duration_; }
+  uint64_t pool_allocations() const { return pool_allocations_; }
+  uint64_t heap_allocations() const { return heap_allocations_; }
+  uint64_t pool_size() const { return pool_size_; }
   nghttp2_session_type type() const { return session_type_; }
 
   void Notify(Local<Value> obj) {
@@ -1041,6 +1112,9 @@ class Http2SessionPerformanceEntry : public PerformanceEntry {
   int32_t stream_count_;
   size_t max_concurrent_streams_;
   double stream_average_duration_;
+  uint64_t pool_allocations_;
+  uint64_t heap_allocations_;
+  uint64_t pool_size_;
   nghttp2_session_type session_type_;
 };
 
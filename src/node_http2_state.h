@@ -81,6 +81,9 @@ namespace http2 {
     IDX_SESSION_STATS_DATA_SENT,
     IDX_SESSION_STATS_DATA_RECEIVED,
     IDX_SESSION_STATS_MAX_CONCURRENT_STREAMS,
+    IDX_SESSION_STATS_POOL_ALLOCATIONS,
+    IDX_SESSION_STATS_HEAP_ALLOCATIONS,
+    IDX_SESSION_STATS_POOL_SIZE,
     IDX_SESSION_STATS_COUNT
   };
 
@@ -25,13 +25,17 @@
 
 #include "async_wrap-inl.h"
 #include "env-inl.h"
+#include "http_header_names.h"
 #include "http_parser.h"
+#include "node_mutex.h"
 #include "stream_base-inl.h"
 #include "util-inl.h"
 #include "v8.h"
 
 #include <stdlib.h>  // free()
-#include <string.h>  // strdup()
+#include <stdio.h>  // snprintf()
+#include <string.h>  // strchr(), strcmp(), strdup()
+#include <time.h>  // gmtime_r(), time()
 
 // This is a binding to http_parser (https://github.com/nodejs/http-parser)
 // The goal is to decouple sockets from parsing for more javascript-level
@@ -57,6 +61,7 @@ using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Isolate;
 using v8::Int32;
 using v8::Integer;
 using v8::Local;
@@ -72,6 +77,7 @@ const uint32_t kOnHeadersComplete = 1;
 const uint32_t kOnBody = 2;
 const uint32_t kOnMessageComplete = 3;
 const uint32_t kOnExecute = 4;
+const uint32_t kOnBatch = 5;
 
 
 // helper class for the Parser
@@ -150,6 +156,7 @@ class Parser : public AsyncWrap, public StreamListener {
  public:
   Parser(Environment* env, Local<Object> wrap, enum http_parser_type type)
       : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_HTTPPARSER),
+        header_names_(HTTPHeaderNames::Get(env)),
         current_buffer_len_(0),
         current_buffer_data_(nullptr) {
     Init(type);
@@ -284,6 +291,16 @@ class Parser : public AsyncWrap, public StreamListener {
 
     argv[A_UPGRADE] = Boolean::New(env()->isolate(), parser_.upgrade);
 
+    // Upgrades need the return value of the callback right away, so they
+    // are never batched.
+    if (batching_ && !parser_.upgrade) {
+      AddToBatch(kOnHeadersComplete, arraysize(argv), argv);
+      return 0;
+    }
+
+    if (!DeliverBatch())
+      return -1;
+
     Environment::AsyncCallbackScope callback_scope(env());
 
     MaybeLocal<Value> head_response =
@@ -303,6 +320,23 @@ class Parser : public AsyncWrap, public StreamListener {
 
 
   int on_body(const char* at, size_t length) {
+    if (batching_) {
+      // No handle scope here, both the buffer and the batch have to outlive
+      // this call.
+      if (current_buffer_.IsEmpty()) {
+        current_buffer_ = Buffer::Copy(env()->isolate(),
+                                       current_buffer_data_,
+                                       current_buffer_len_).ToLocalChecked();
+      }
+      Local<Value> argv[3] = {
+        current_buffer_,
+        Integer::NewFromUnsigned(env()->isolate(), at - current_buffer_data_),
+        Integer::NewFromUnsigned(env()->isolate(), length)
+      };
+      AddToBatch(kOnBody, arraysize(argv), argv);
+      return 0;
+    }
+
     EscapableHandleScope scope(env()->isolate());
 
     Local<Object> obj = object();
@@ -340,11 +374,16 @@ class Parser : public AsyncWrap, public StreamListener {
 
 
   int on_message_complete() {
-    HandleScope scope(env()->isolate());
-
     if (num_fields_)
       Flush();  // Flush trailing HTTP headers.
 
+    if (batching_) {
+      AddToBatch(kOnMessageComplete, 0, nullptr);
+      return 0;
+    }
+
+    HandleScope scope(env()->isolate());
+
     Local<Object> obj = object();
     Local<Value> cb = obj->Get(kOnMessageComplete);
 
@@ -596,9 +635,24 @@ class Parser : public AsyncWrap, public StreamListener {
     current_buffer_data_ = data;
     got_exception_ = false;
 
+    // With a kOnBatch callback, the messages parsed from this chunk are
+    // handed to JS in one call once the whole chunk has been parsed, see
+    // AddToBatch().
+    batching_ =
+        object()->Get(env()->context(), kOnBatch).ToLocalChecked()
+            ->IsFunction();
+
     size_t nparsed =
       http_parser_execute(&parser_, &settings, data, len);
 
+    if (batching_) {
+      if (got_exception_)
+        batch_.Clear();
+      else
+        DeliverBatch();
+      batching_ = false;
+    }
+
     Save();
 
     // Unassign the 'buffer_' variable
@@ -627,29 +681,74 @@ class Parser : public AsyncWrap, public StreamListener {
     return scope.Escape(nparsed_obj);
   }
 
+  // Returns the headers collected so far as a flat [name, value, ...] array,
+  // built without calling into JS. Common header names are handed out as the
+  // same internalized strings every time.
+  //
+  // These are all headers of the message unless it has more than fit into
+  // fields_, in which case the earlier ones have already been passed to JS
+  // through Flush() in chunks of arraysize(fields_) - 1.
   Local<Array> CreateHeaders() {
-    Local<Array> headers = Array::New(env()->isolate());
-    Local<Function> fn = env()->push_values_to_array_function();
-    Local<Value> argv[NODE_PUSH_VAL_TO_ARRAY_MAX * 2];
-    size_t i = 0;
-
-    do {
-      size_t j = 0;
-      while (i < num_values_ && j < arraysize(argv) / 2) {
-        argv[j * 2] = fields_[i].ToString(env());
-        argv[j * 2 + 1] = values_[i].ToString(env());
-        i++;
-        j++;
-      }
-      if (j > 0) {
-        fn->Call(env()->context(), headers, j * 2, argv).ToLocalChecked();
-      }
-    } while (i < num_values_);
+    Local<Context> context = env()->context();
+    CHECK_LE(num_values_, arraysize(fields_));
+    Local<Array> headers = Array::New(env()->isolate(), num_values_ * 2);
+
+    for (size_t i = 0; i < num_values_; i++) {
+      Local<Value> name =
+          header_names_->ToString(fields_[i].str_, fields_[i].size_);
+      headers->Set(context, i * 2, name).FromJust();
+      headers->Set(context, i * 2 + 1, values_[i].ToString(env())).FromJust();
+    }
 
     return headers;
   }
 
 
+  // Queues a callback for the current batch as [index, ...argv]. Must not be
+  // called from within a nested handle scope, since the batch is created in
+  // the scope of Execute().
+  void AddToBatch(uint32_t index, size_t argc, Local<Value>* argv) {
+    Isolate* isolate = env()->isolate();
+    if (batch_.IsEmpty()) {
+      batch_ = Array::New(isolate);
+      batch_length_ = 0;
+    }
+    Local<Value> values[1 + 9];
+    CHECK_LT(argc, arraysize(values));
+    values[0] = Integer::NewFromUnsigned(isolate, index);
+    for (size_t i = 0; i < argc; i++)
+      values[1 + i] = argv[i];
+    for (size_t i = 0; i <= argc; i++)
+      batch_->Set(env()->context(), batch_length_++, values[i]).FromJust();
+  }
+
+
+  // Hands the callbacks batched so far to JS, which has to happen before
+  // any other callback into JS so that they are seen in order. Returns false
+  // if the kOnBatch callback threw.
+  bool DeliverBatch() {
+    if (batch_.IsEmpty())
+      return true;
+
+    Local<Value> batch = batch_;
+    batch_.Clear();
+    batch_length_ = 0;
+
+    Local<Value> cb =
+        object()->Get(env()->context(), kOnBatch).ToLocalChecked();
+    if (!cb->IsFunction())
+      return true;
+
+    Environment::AsyncCallbackScope callback_scope(env());
+
+    if (MakeCallback(cb.As<Function>(), 1, &batch).IsEmpty()) {
+      got_exception_ = true;
+      return false;
+    }
+    return true;
+  }
+
+
   // spill headers and request path to JS land
   void Flush() {
     HandleScope scope(env()->isolate());
@@ -660,6 +759,9 @@ class Parser : public AsyncWrap, public StreamListener {
     if (!cb->IsFunction())
       return;
 
+    if (!DeliverBatch())
+      return;
+
     Local<Value> argv[2] = {
       CreateHeaders(),
       url_.ToString(env())
@@ -685,10 +787,14 @@ class Parser : public AsyncWrap, public StreamListener {
     num_values_ = 0;
     have_flushed_ = false;
     got_exception_ = false;
+    batching_ = false;
+    batch_.Clear();
+    batch_length_ = 0;
   }
 
 
   http_parser parser_;
+  HTTPHeaderNames* const header_names_;
   StringPtr fields_[32];  // header fields
   StringPtr values_[32];  // header values
   StringPtr url_;
@@ -697,6 +803,9 @@ class Parser : public AsyncWrap, public StreamListener {
   size_t num_values_;
   bool have_flushed_;
   bool got_exception_;
+  bool batching_;
+  Local<Array> batch_;
+  uint32_t batch_length_;
   Local<Object> current_buffer_;
   size_t current_buffer_len_;
   char* current_buffer_data_;
@@ -732,6 +841,163 @@ const struct http_parser_settings Parser::settings = {
 };
 
 
+// Writes the current time as an IMF-fixdate, e.g.
+// "Sun, 06 Nov 1994 08:49:37 GMT", to |out|, which must have room for
+// kDateLength bytes. The string is only formatted once per second.
+constexpr size_t kDateLength = 29;
+
+void WriteDate(char* out) {
+  static const char days[][4] = {
+    "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"
+  };
+  static const char months[][4] = {
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+    "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+  };
+  static Mutex mutex;
+  static time_t cached_time = -1;
+  static char cached_date[kDateLength + 1];
+
+  time_t now = time(nullptr);
+  Mutex::ScopedLock lock(mutex);
+  if (now != cached_time) {
+    struct tm tm;
+#ifdef _WIN32
+    gmtime_s(&tm, &now);
+#else
+    gmtime_r(&now, &tm);
+#endif
+    snprintf(cached_date, sizeof(cached_date),
+             "%s, %02d %s %04d %02d:%02d:%02d GMT",
+             days[tm.tm_wday], tm.tm_mday, months[tm.tm_mon],
+             tm.tm_year + 1900, tm.tm_hour, tm.tm_min, tm.tm_sec);
+    cached_time = now;
+  }
+  memcpy(out, cached_date, kDateLength);
+}
+
+
+// tchar from RFC 7230, section 3.2.6.
+inline bool IsTokenChar(uint8_t c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') ||
+         (c != 0 && strchr("!#$%&'*+-.^_`|~", c) != nullptr);
+}
+
+// field-vchar, SP or HTAB.
+inline bool IsHeaderValueChar(uint8_t c) {
+  return c == '\t' || (c >= 0x20 && c != 0x7f);
+}
+
+
+// Serializes the head of an outgoing message and returns it as a latin1
+// string. args[0] is the first line including its CRLF and args[1] a flat
+// [name, value, ...] array. If args[2] is true, names and values are
+// validated, and if args[3] is true, a Date header is added after the other
+// headers. The caller appends the remaining headers and the final CRLF.
+//
+// Returns undefined if a header has to be rejected or escaped, in which case
+// JS takes the slow path, which throws the right error.
+void SerializeHead(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsArray());
+  Local<String> first_line = args[0].As<String>();
+  Local<Array> headers = args[1].As<Array>();
+  const bool validate = args[2]->IsTrue();
+  const bool add_date = args[3]->IsTrue();
+  const uint32_t count = headers->Length() & ~1;
+
+  MaybeStackBuffer<Local<String>, 64> strings(count);
+  size_t size = first_line->Length();
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> value;
+    if (!headers->Get(context, i).ToLocal(&value))
+      return;
+    // Names have to be strings, and values must not be undefined.
+    if (i % 2 == 0 ? !value->IsString() : value->IsUndefined())
+      return;
+    if (!value->ToString(context).ToLocal(&strings[i]))
+      return;
+    if (validate && !strings[i]->ContainsOnlyOneByte())
+      return;
+    size += strings[i]->Length();
+  }
+  size += count / 2 * 4;  // ": " and CRLF.
+  if (add_date)
+    size += sizeof("Date: \r\n") - 1 + kDateLength;
+
+  MaybeStackBuffer<char, 1024> head(size);
+  uint8_t* out = reinterpret_cast<uint8_t*>(*head);
+  auto write = [&](Local<String> string) {
+    out += string->WriteOneByte(isolate, out, 0, string->Length(),
+                                String::NO_NULL_TERMINATION);
+  };
+  write(first_line);
+  for (uint32_t i = 0; i < count; i += 2) {
+    const uint8_t* name = out;
+    write(strings[i]);
+    if (validate) {
+      if (name == out)
+        return;
+      for (const uint8_t* c = name; c < out; c++) {
+        if (!IsTokenChar(*c))
+          return;
+      }
+    }
+    *out++ = ':';
+    *out++ = ' ';
+
+    const uint8_t* value = out;
+    write(strings[i + 1]);
+    for (const uint8_t* c = value; c < out; c++) {
+      // Line breaks are escaped by the slow path if the value does not need
+      // to be validated.
+      if (validate ? !IsHeaderValueChar(*c) : (*c == '\r' || *c == '\n'))
+        return;
+    }
+    *out++ = '\r';
+    *out++ = '\n';
+  }
+  if (add_date) {
+    memcpy(out, "Date: ", 6);
+    WriteDate(reinterpret_cast<char*>(out + 6));
+    memcpy(out + 6 + kDateLength, "\r\n", 2);
+    out += 6 + kDateLength + 2;
+  }
+  CHECK_EQ(static_cast<size_t>(out - reinterpret_cast<uint8_t*>(*head)), size);
+
+  Local<String> result;
+  if (String::NewFromOneByte(isolate,
+                             reinterpret_cast<const uint8_t*>(*head),
+                             v8::NewStringType::kNormal,
+                             size).ToLocal(&result)) {
+    args.GetReturnValue().Set(result);
+  }
+}
+
+
+// Switches all parsers in the process to the scanner named by the
+// --http-parser value in args[0], and returns the name of the scanner that is
+// actually used. Only meant for benchmarks and tests.
+void SetScanner(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(env->is_main_thread());
+  CHECK(args[0]->IsString());
+  Utf8Value name(env->isolate(), args[0]);
+  if (strcmp(*name, "simd") == 0) {
+    http_parser_set_scan(HTTP_PARSER_SCAN_SIMD);
+  } else {
+    CHECK_EQ(strcmp(*name, "legacy"), 0);
+    http_parser_set_scan(HTTP_PARSER_SCAN_SCALAR);
+  }
+  args.GetReturnValue().Set(
+      OneByteString(env->isolate(), http_parser_scan_name()));
+}
+
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -755,6 +1021,8 @@ void Initialize(Local<Object> target,
          Integer::NewFromUnsigned(env->isolate(), kOnMessageComplete));
   t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnExecute"),
          Integer::NewFromUnsigned(env->isolate(), kOnExecute));
+  t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnBatch"),
+         Integer::NewFromUnsigned(env->isolate(), kOnBatch));
 
   Local<Array> methods = Array::New(env->isolate());
 #define V(num, name, string)                                                  \
@@ -762,6 +1030,8 @@ void Initialize(Local<Object> target,
   HTTP_METHOD_MAP(V)
 #undef V
   target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "methods"), methods);
+  target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "knownHeaders"),
+              HTTPHeaderNames::Get(env)->ToArray());
 
   AsyncWrap::AddWrapMethods(env, t);
   env->SetProtoMethod(t, "close", Parser::Close);
@@ -777,6 +1047,8 @@ void Initialize(Local<Object> target,
 
   target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "HTTPParser"),
               t->GetFunction(env->context()).ToLocalChecked());
+  env->SetMethod(target, "setScanner", SetScanner);
+  env->SetMethod(target, "serializeHead", SerializeHead);
 }
 
 }  // anonymous namespace
@@ -308,42 +308,48 @@ v8::Maybe<bool> ProcessEmitDeprecationWarning(Environment* env,
                                               const char* warning,
                                               const char* deprecation_code);
 
-template <typename NativeT, typename V8T>
-v8::Local<v8::Value> FillStatsArray(AliasedBuffer<NativeT, V8T>* fields_ptr,
-                    const uv_stat_t* s, int offset = 0) {
-  AliasedBuffer<NativeT, V8T>& fields = *fields_ptr;
-  fields[offset + 0] = s->st_dev;
-  fields[offset + 1] = s->st_mode;
-  fields[offset + 2] = s->st_nlink;
-  fields[offset + 3] = s->st_uid;
-  fields[offset + 4] = s->st_gid;
-  fields[offset + 5] = s->st_rdev;
+// Writes the kFsStatsFieldsLength fields of |s| into |*fields|, starting at
+// |offset|. |*fields| is either an AliasedBuffer or a plain NativeT* pointing
+// at storage that is not visible to JS yet, e.g. on a threadpool thread.
+template <typename Fields>
+void FillStatsFields(Fields* fields, const uv_stat_t* s, size_t offset = 0) {
+  (*fields)[offset + 0] = s->st_dev;
+  (*fields)[offset + 1] = s->st_mode;
+  (*fields)[offset + 2] = s->st_nlink;
+  (*fields)[offset + 3] = s->st_uid;
+  (*fields)[offset + 4] = s->st_gid;
+  (*fields)[offset + 5] = s->st_rdev;
 #if defined(__POSIX__)
-  fields[offset + 6] = s->st_blksize;
+  (*fields)[offset + 6] = s->st_blksize;
 #else
-  fields[offset + 6] = 0;
+  (*fields)[offset + 6] = 0;
 #endif
-  fields[offset + 7] = s->st_ino;
-  fields[offset + 8] = s->st_size;
+  (*fields)[offset + 7] = s->st_ino;
+  (*fields)[offset + 8] = s->st_size;
 #if defined(__POSIX__)
-  fields[offset + 9] = s->st_blocks;
+  (*fields)[offset + 9] = s->st_blocks;
 #else
-  fields[offset + 9] = 0;
+  (*fields)[offset + 9] = 0;
 #endif
 // Dates.
 // NO-LINT because the fields are 'long' and we just want to cast to `unsigned`
-#define X(idx, name)                                                    \
-  /* NOLINTNEXTLINE(runtime/int) */                                     \
-  fields[offset + idx] = ((unsigned long)(s->st_##name.tv_sec) * 1e3) + \
-  /* NOLINTNEXTLINE(runtime/int) */                                     \
-                ((unsigned long)(s->st_##name.tv_nsec) / 1e6);          \
+#define X(idx, name)                                                       \
+  /* NOLINTNEXTLINE(runtime/int) */                                        \
+  (*fields)[offset + idx] = ((unsigned long)(s->st_##name.tv_sec) * 1e3) + \
+  /* NOLINTNEXTLINE(runtime/int) */                                        \
+                ((unsigned long)(s->st_##name.tv_nsec) / 1e6);             \
 
   X(10, atim)
   X(11, mtim)
   X(12, ctim)
   X(13, birthtim)
 #undef X
+}
 
+template <typename NativeT, typename V8T>
+v8::Local<v8::Value> FillStatsArray(AliasedBuffer<NativeT, V8T>* fields_ptr,
+                    const uv_stat_t* s, int offset = 0) {
+  FillStatsFields(fields_ptr, s, offset);
   return fields_ptr->GetJSArray();
 }
 
@@ -501,7 +507,11 @@ class InternalCallbackScope {
 
 class ThreadPoolWork {
  public:
-  explicit inline ThreadPoolWork(Environment* env) : env_(env) {
+  // `work_class` picks the libuv threadpool queue, and with it the thread
+  // share and priority, that this work is scheduled with.
+  explicit inline ThreadPoolWork(
+      Environment* env, uv_work_class_t work_class = UV_WORK_CLASS_CPU)
+      : env_(env), work_class_(work_class) {
     CHECK_NOT_NULL(env);
   }
   inline virtual ~ThreadPoolWork() = default;
@@ -514,14 +524,16 @@ class ThreadPoolWork {
 
  private:
   Environment* env_;
+  uv_work_class_t work_class_;
   uv_work_t work_req_;
 };
 
 void ThreadPoolWork::ScheduleWork() {
   env_->IncreaseWaitingRequestCounter();
-  int status = uv_queue_work(
+  int status = uv_queue_work_ex(
       env_->event_loop(),
       &work_req_,
+      work_class_,
       [](uv_work_t* req) {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
         self->DoThreadPoolWork();
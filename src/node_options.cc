@@ -1,4 +1,5 @@
 #include <errno.h>
+#include <limits.h>
 #include "node_internals.h"
 #include "node_options-inl.h"
 
@@ -18,6 +19,34 @@ using v8::Value;
 namespace node {
 
 void PerProcessOptions::CheckOptions(std::vector<std::string>* errors) {
+  const std::pair<const char*, const std::string*> threadpool_classes[] = {
+    { "--threadpool-fs", &threadpool_fs },
+    { "--threadpool-dns", &threadpool_dns },
+    { "--threadpool-cpu", &threadpool_cpu },
+    { "--threadpool-user", &threadpool_user }
+  };
+  for (const auto& option : threadpool_classes) {
+    unsigned int share;
+    int priority;
+    if (!option.second->empty() &&
+        !options_parser::ParseThreadpoolClass(*option.second,
+                                              &share,
+                                              &priority)) {
+      errors->push_back(std::string(option.first) +
+                        " must be <share>[:<priority>] with a share "
+                        "from 0 to 1024");
+    }
+  }
+
+  if (loop_busy_poll < 0 || loop_busy_poll > 1000000) {
+    errors->push_back("--loop-busy-poll must be from 0 to 1000000 "
+                      "microseconds");
+  }
+
+  if (http_parser != "legacy" && http_parser != "simd") {
+    errors->push_back("invalid value for --http-parser");
+  }
+
 #if HAVE_OPENSSL
   if (use_openssl_ca && use_bundled_ca) {
     errors->push_back("either --use-openssl-ca or --use-bundled-ca can be "
@@ -202,6 +231,11 @@ PerIsolateOptionsParser::PerIsolateOptionsParser() {
             "track heap object allocations for heap snapshots",
             &PerIsolateOptions::track_heap_objects,
             kAllowedInEnvironment);
+  AddOption("--v8-idle-tasks",
+            "run V8 idle tasks and garbage collection work while the event "
+            "loop is idle",
+            &PerIsolateOptions::v8_idle_tasks,
+            kAllowedInEnvironment);
 
   // Explicitly add some V8 flags to mark them as allowed in NODE_OPTIONS.
   AddOption("--abort_on_uncaught_exception",
@@ -236,10 +270,45 @@ PerProcessOptionsParser::PerProcessOptionsParser() {
             kAllowedInEnvironment);
   AddAlias("--trace-events-enabled", {
     "--trace-event-categories", "v8,node,node.async_hooks" });
+  AddOption("--http-parser",
+            "how the HTTP parser scans request targets and headers "
+            "(legacy, simd)",
+            &PerProcessOptions::http_parser,
+            kAllowedInEnvironment);
+  AddOption("--loop-busy-poll",
+            "spin for up to this many microseconds waiting for I/O before "
+            "the event loop blocks (Linux only)",
+            &PerProcessOptions::loop_busy_poll,
+            kAllowedInEnvironment);
+  AddOption("--timer-wheel",
+            "keep the event loop's timers in a timing wheel instead of a "
+            "binary heap",
+            &PerProcessOptions::timer_wheel,
+            kAllowedInEnvironment);
   AddOption("--v8-pool-size",
             "set V8's thread pool size",
             &PerProcessOptions::v8_thread_pool_size,
             kAllowedInEnvironment);
+  AddOption("--threadpool-fs",
+            "set the thread share and priority of file system work in the "
+            "libuv threadpool (<share>[:<priority>])",
+            &PerProcessOptions::threadpool_fs,
+            kAllowedInEnvironment);
+  AddOption("--threadpool-dns",
+            "set the thread share and priority of DNS lookups in the "
+            "libuv threadpool (<share>[:<priority>])",
+            &PerProcessOptions::threadpool_dns,
+            kAllowedInEnvironment);
+  AddOption("--threadpool-cpu",
+            "set the thread share and priority of CPU-bound work in the "
+            "libuv threadpool (<share>[:<priority>])",
+            &PerProcessOptions::threadpool_cpu,
+            kAllowedInEnvironment);
+  AddOption("--threadpool-user",
+            "set the thread share and priority of addon work in the "
+            "libuv threadpool (<share>[:<priority>])",
+            &PerProcessOptions::threadpool_user,
+            kAllowedInEnvironment);
   AddOption("--zero-fill-buffers",
             "automatically zero-fill all newly allocated Buffer and "
             "SlowBuffer instances",
@@ -367,6 +436,37 @@ HostPort SplitHostPort(const std::string& arg,
                     ParseAndValidatePort(arg.substr(colon + 1), errors) };
 }
 
+// Parses `<share>[:<priority>]`. `priority` is left untouched if it is not
+// part of `arg`.
+bool ParseThreadpoolClass(const std::string& arg,
+                          unsigned int* share,
+                          int* priority) {
+  const size_t colon = arg.find(':');
+  const std::string share_str = arg.substr(0, colon);
+  char* endptr;
+
+  errno = 0;
+  const long result = strtol(share_str.c_str(), &endptr, 10);  // NOLINT
+  if (share_str.empty() || errno != 0 || *endptr != '\0' ||
+      result < 0 || result > 1024) {
+    return false;
+  }
+  *share = static_cast<unsigned int>(result);
+
+  if (colon == std::string::npos)
+    return true;
+
+  const std::string priority_str = arg.substr(colon + 1);
+  errno = 0;
+  const long prio = strtol(priority_str.c_str(), &endptr, 10);  // NOLINT
+  if (priority_str.empty() || errno != 0 || *endptr != '\0' ||
+      prio < INT_MIN || prio > INT_MAX) {
+    return false;
+  }
+  *priority = static_cast<int>(prio);
+  return true;
+}
+
 // Usage: Either:
 // - getOptions() to get all options + metadata or
 // - getOptions(string) to get the value of a particular option
@@ -103,6 +103,7 @@ class PerIsolateOptions : public Options {
  public:
   std::shared_ptr<EnvironmentOptions> per_env { new EnvironmentOptions() };
   bool track_heap_objects = false;
+  bool v8_idle_tasks = false;
 
   inline EnvironmentOptions* get_per_env_options();
   void CheckOptions(std::vector<std::string>* errors);
@@ -116,8 +117,17 @@ class PerProcessOptions : public Options {
   std::string trace_event_categories;
   std::string trace_event_file_pattern = "node_trace.${rotation}.log";
   int64_t v8_thread_pool_size = 4;
+  int64_t loop_busy_poll = 0;
+  bool timer_wheel = false;
+  std::string http_parser = "legacy";
   bool zero_fill_all_buffers = false;
 
+  // `<share>[:<priority>]` for each of libuv's threadpool work classes.
+  std::string threadpool_fs;
+  std::string threadpool_dns;
+  std::string threadpool_cpu;
+  std::string threadpool_user;
+
   std::vector<std::string> security_reverts;
   bool print_bash_completion = false;
   bool print_help = false;
@@ -155,6 +165,9 @@ namespace options_parser {
 
 HostPort SplitHostPort(const std::string& arg,
     std::vector<std::string>* errors);
+bool ParseThreadpoolClass(const std::string& arg,
+                          unsigned int* share,
+                          int* priority);
 void GetOptions(const v8::FunctionCallbackInfo<v8::Value>& args);
 
 enum OptionEnvvarSettings {
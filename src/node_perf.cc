@@ -10,13 +10,16 @@ namespace performance {
 
 using v8::Array;
 using v8::Context;
+using v8::Float64Array;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Int32;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
+using v8::Map;
 using v8::Name;
 using v8::Number;
 using v8::Object;
@@ -47,6 +50,10 @@ void performance_state::Mark(enum PerformanceMilestone milestone,
       TRACE_EVENT_SCOPE_THREAD, ts / 1000);
 }
 
+void performance_state::UpdateLoopIdleTime(uv_loop_t* loop) {
+  this->loop_idle_time[0] = static_cast<double>(uv_metrics_idle_time(loop));
+}
+
 double GetCurrentTimeInMicroseconds() {
 #ifdef _WIN32
 // The difference between the Unix Epoch and the Windows Epoch in 100-ns ticks.
@@ -386,6 +393,195 @@ void Timerify(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Writes a snapshot of the threadpool counters into the Float64Array that is
+// passed in: the size and the number of idle threads, followed by queued,
+// running, completed and the wait and run time histograms of every work
+// class in turn.
+void GetThreadpoolStats(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), kThreadpoolStatsLength);
+  double* fields = static_cast<double*>(array->Buffer()->GetContents().Data());
+
+  uv_threadpool_stats_t stats;
+  CHECK_EQ(uv_threadpool_get_stats(&stats), 0);
+
+  size_t n = 0;
+  fields[n++] = stats.size;
+  fields[n++] = stats.idle;
+  for (const uv_threadpool_class_stats_t& cls : stats.classes) {
+    fields[n++] = cls.queued;
+    fields[n++] = cls.running;
+    fields[n++] = static_cast<double>(cls.completed);
+    for (uint64_t count : cls.wait_time)
+      fields[n++] = static_cast<double>(count);
+    for (uint64_t count : cls.run_time)
+      fields[n++] = static_cast<double>(count);
+  }
+  CHECK_EQ(n, kThreadpoolStatsLength);
+}
+
+// Writes the busy poll counters of the event loop into the Float64Array that
+// is passed in: the budget in microseconds, followed by the number of polls,
+// hits and blocks.
+void GetLoopBusyPollStats(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), 4);
+  double* fields = static_cast<double*>(array->Buffer()->GetContents().Data());
+
+  uv_busy_poll_stats_t stats;
+  int err = uv_loop_busy_poll_stats(env->event_loop(), &stats);
+  if (err == 0) {
+    fields[0] = stats.budget;
+    fields[1] = static_cast<double>(stats.polls);
+    fields[2] = static_cast<double>(stats.hits);
+    fields[3] = static_cast<double>(stats.blocks);
+  }
+  args.GetReturnValue().Set(err);
+}
+
+void SetThreadpoolSize(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsUint32());
+  unsigned int size = args[0].As<v8::Uint32>()->Value();
+  args.GetReturnValue().Set(uv_threadpool_set_size(size));
+}
+
+
+// Event loop delay monitoring. Delays of up to an hour are tracked; anything
+// longer is only counted in exceeds().
+static constexpr int64_t kMaxEventLoopDelay =
+    int64_t{3600} * 1000 * 1000 * 1000;
+
+ELDHistogram::ELDHistogram(Environment* env,
+                           Local<Object> wrap,
+                           int32_t resolution)
+    : HandleWrap(env,
+                 wrap,
+                 reinterpret_cast<uv_handle_t*>(&timer_),
+                 AsyncWrap::PROVIDER_ELDHISTOGRAM),
+      Histogram(kMaxEventLoopDelay),
+      resolution_(resolution) {
+  CHECK_EQ(uv_timer_init(env->event_loop(), &timer_), 0);
+  uv_unref(reinterpret_cast<uv_handle_t*>(&timer_));
+}
+
+void ELDHistogram::DelayIntervalCallback(uv_timer_t* req) {
+  ELDHistogram* histogram = ContainerOf(&ELDHistogram::timer_, req);
+  histogram->RecordDelta();
+}
+
+bool ELDHistogram::RecordDelta() {
+  uint64_t time = uv_hrtime();
+  bool ret = true;
+  if (prev_ > 0) {
+    int64_t delay = static_cast<int64_t>(time - prev_) -
+                    int64_t{resolution_} * 1000 * 1000;
+    // The timer is scheduled against the cached loop time, so it can fire a
+    // little early; that is not a negative delay.
+    ret = Record(std::max<int64_t>(delay, 0));
+  }
+  prev_ = time;
+  return ret;
+}
+
+bool ELDHistogram::Enable() {
+  if (enabled_ || IsHandleClosing()) return false;
+  enabled_ = true;
+  prev_ = 0;
+  uv_timer_start(&timer_, DelayIntervalCallback, resolution_, resolution_);
+  return true;
+}
+
+bool ELDHistogram::Disable() {
+  if (!enabled_ || IsHandleClosing()) return false;
+  enabled_ = false;
+  uv_timer_stop(&timer_);
+  return true;
+}
+
+static void ELDHistogramNew(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsInt32());
+  int32_t resolution = args[0].As<Int32>()->Value();
+  CHECK_GT(resolution, 0);
+  new ELDHistogram(env, args.This(), resolution);
+}
+
+static void ELDHistogramMin(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(static_cast<double>(histogram->Min()));
+}
+
+static void ELDHistogramMax(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(static_cast<double>(histogram->Max()));
+}
+
+static void ELDHistogramMean(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(histogram->Mean());
+}
+
+static void ELDHistogramStddev(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(histogram->Stddev());
+}
+
+static void ELDHistogramExceeds(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(static_cast<double>(histogram->Exceeds()));
+}
+
+static void ELDHistogramPercentile(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsNumber());
+  double percentile = args[0].As<Number>()->Value();
+  args.GetReturnValue().Set(
+      static_cast<double>(histogram->Percentile(percentile)));
+}
+
+static void ELDHistogramPercentiles(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsMap());
+  Local<Map> map = args[0].As<Map>();
+  histogram->Percentiles([&](double percentile, int64_t value) {
+    map->Set(env->context(),
+             Number::New(env->isolate(), percentile),
+             Number::New(env->isolate(), static_cast<double>(value)))
+        .ToLocalChecked();
+  });
+}
+
+static void ELDHistogramEnable(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(histogram->Enable());
+}
+
+static void ELDHistogramDisable(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(histogram->Disable());
+}
+
+static void ELDHistogramReset(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  histogram->ResetState();
+}
+
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context) {
@@ -399,6 +595,9 @@ void Initialize(Local<Object> target,
   target->Set(context,
               FIXED_ONE_BYTE_STRING(isolate, "milestones"),
               state->milestones.GetJSArray()).FromJust();
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "loopIdleTime"),
+              state->loop_idle_time.GetJSArray()).FromJust();
 
   Local<String> performanceEntryString =
       FIXED_ONE_BYTE_STRING(isolate, "PerformanceEntry");
@@ -415,6 +614,28 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "markMilestone", MarkMilestone);
   env->SetMethod(target, "setupObservers", SetupPerformanceObservers);
   env->SetMethod(target, "timerify", Timerify);
+  env->SetMethod(target, "getThreadpoolStats", GetThreadpoolStats);
+  env->SetMethod(target, "setThreadpoolSize", SetThreadpoolSize);
+  env->SetMethod(target, "getLoopBusyPollStats", GetLoopBusyPollStats);
+
+  Local<String> eldh_classname = FIXED_ONE_BYTE_STRING(isolate, "ELDHistogram");
+  Local<FunctionTemplate> eldh = env->NewFunctionTemplate(ELDHistogramNew);
+  eldh->SetClassName(eldh_classname);
+  eldh->InstanceTemplate()->SetInternalFieldCount(1);
+  AsyncWrap::AddWrapMethods(env, eldh);
+  HandleWrap::AddWrapMethods(env, eldh);
+  env->SetProtoMethod(eldh, "exceeds", ELDHistogramExceeds);
+  env->SetProtoMethod(eldh, "min", ELDHistogramMin);
+  env->SetProtoMethod(eldh, "max", ELDHistogramMax);
+  env->SetProtoMethod(eldh, "mean", ELDHistogramMean);
+  env->SetProtoMethod(eldh, "stddev", ELDHistogramStddev);
+  env->SetProtoMethod(eldh, "percentile", ELDHistogramPercentile);
+  env->SetProtoMethod(eldh, "percentiles", ELDHistogramPercentiles);
+  env->SetProtoMethod(eldh, "enable", ELDHistogramEnable);
+  env->SetProtoMethod(eldh, "disable", ELDHistogramDisable);
+  env->SetProtoMethod(eldh, "reset", ELDHistogramReset);
+  target->Set(context, eldh_classname,
+              eldh->GetFunction(context).ToLocalChecked()).FromJust();
 
   Local<Object> constants = Object::New(isolate);
 
@@ -423,6 +644,9 @@ void Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(constants, NODE_PERFORMANCE_GC_INCREMENTAL);
   NODE_DEFINE_CONSTANT(constants, NODE_PERFORMANCE_GC_WEAKCB);
 
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, UV_THREADPOOL_HISTOGRAM_BUCKETS);
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, UV_WORK_CLASS_MAX);
+
 #define V(name, _)                                                            \
   NODE_DEFINE_HIDDEN_CONSTANT(constants, NODE_PERFORMANCE_ENTRY_TYPE_##name);
   NODE_PERFORMANCE_ENTRY_TYPES(V)
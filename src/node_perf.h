@@ -8,6 +8,8 @@
 #include "node_perf_common.h"
 #include "env.h"
 #include "base_object-inl.h"
+#include "handle_wrap.h"
+#include "histogram-inl.h"
 
 #include "v8.h"
 #include "uv.h"
@@ -111,6 +113,12 @@ enum PerformanceGCKind {
   NODE_PERFORMANCE_GC_WEAKCB = GCType::kGCTypeProcessWeakCallbacks
 };
 
+// Layout of the array filled in by getThreadpoolStats().
+static constexpr size_t kThreadpoolClassStatsLength =
+    3 + 2 * UV_THREADPOOL_HISTOGRAM_BUCKETS;
+static constexpr size_t kThreadpoolStatsLength =
+    2 + UV_WORK_CLASS_MAX * kThreadpoolClassStatsLength;
+
 class GCPerformanceEntry : public PerformanceEntry {
  public:
   GCPerformanceEntry(Environment* env,
@@ -126,6 +134,38 @@ class GCPerformanceEntry : public PerformanceEntry {
   PerformanceGCKind gckind_;
 };
 
+// Samples the event loop delay every |resolution| milliseconds from a
+// uv_timer_t, without ever calling into JS. The recorded value is how much
+// later than scheduled the timer fired, in nanoseconds.
+class ELDHistogram : public HandleWrap, public Histogram {
+ public:
+  ELDHistogram(Environment* env,
+               Local<Object> wrap,
+               int32_t resolution);
+
+  bool RecordDelta();
+  bool Enable();
+  bool Disable();
+  void ResetState() {
+    Reset();
+    prev_ = 0;
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackThis(this);
+  }
+
+  ADD_MEMORY_INFO_NAME(ELDHistogram)
+
+ private:
+  static void DelayIntervalCallback(uv_timer_t* req);
+
+  bool enabled_ = false;
+  int32_t resolution_;
+  uint64_t prev_ = 0;
+  uv_timer_t timer_;
+};
+
 }  // namespace performance
 }  // namespace node
 
@@ -66,6 +66,11 @@ class performance_state {
       isolate,
       offsetof(performance_state_internal, observers),
       NODE_PERFORMANCE_ENTRY_TYPE_INVALID,
+      root),
+    loop_idle_time(
+      isolate,
+      offsetof(performance_state_internal, loop_idle_time),
+      1,
       root) {
     for (size_t i = 0; i < milestones.Length(); i++)
       milestones[i] = -1.;
@@ -74,14 +79,19 @@ class performance_state {
   AliasedBuffer<uint8_t, v8::Uint8Array> root;
   AliasedBuffer<double, v8::Float64Array> milestones;
   AliasedBuffer<uint32_t, v8::Uint32Array> observers;
+  // Total time in nanoseconds that the event loop has spent blocked in the
+  // poll phase, refreshed once per loop iteration by UpdateLoopIdleTime().
+  AliasedBuffer<double, v8::Float64Array> loop_idle_time;
 
   void Mark(enum PerformanceMilestone milestone,
             uint64_t ts = PERFORMANCE_NOW());
+  void UpdateLoopIdleTime(uv_loop_t* loop);
 
  private:
   struct performance_state_internal {
     // doubles first so that they are always sizeof(double)-aligned
     double milestones[NODE_PERFORMANCE_MILESTONE_INVALID];
+    double loop_idle_time[1];
     uint32_t observers[NODE_PERFORMANCE_ENTRY_TYPE_INVALID];
   };
 };
@@ -6,9 +6,14 @@
 #include "util.h"
 #include <algorithm>
 
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
 namespace node {
 
 using v8::HandleScope;
+using v8::IdleTask;
 using v8::Isolate;
 using v8::Local;
 using v8::Object;
@@ -18,6 +23,23 @@ using v8::TracingController;
 
 namespace {
 
+// The longest idle period handed to V8 at once, the same as in browsers. I/O
+// that arrives while an idle task runs waits at most this long.
+constexpr uint64_t kMaxIdlePeriodMs = 50;
+
+// Returns true if polling the loop for I/O right now would not block.
+bool HasPendingIo(uv_loop_t* loop) {
+#ifdef _WIN32
+  return false;
+#else
+  struct pollfd pfd;
+  pfd.fd = uv_backend_fd(loop);
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+  return pfd.fd >= 0 && poll(&pfd, 1, 0) > 0;
+#endif
+}
+
 static void PlatformWorkerThread(void* data) {
   TRACE_EVENT_METADATA1("__metadata", "thread_name", "name",
                         "PlatformWorkerThread");
@@ -188,11 +210,16 @@ int WorkerThreadsTaskRunner::NumberOfWorkerThreads() const {
 
 PerIsolatePlatformData::PerIsolatePlatformData(
     v8::Isolate* isolate, uv_loop_t* loop)
-  : loop_(loop) {
+  : isolate_(isolate), loop_(loop) {
   flush_tasks_ = new uv_async_t();
   CHECK_EQ(0, uv_async_init(loop, flush_tasks_, FlushTasks));
   flush_tasks_->data = static_cast<void*>(this);
   uv_unref(reinterpret_cast<uv_handle_t*>(flush_tasks_));
+
+  idle_prepare_ = new uv_prepare_t();
+  CHECK_EQ(0, uv_prepare_init(loop, idle_prepare_));
+  idle_prepare_->data = static_cast<void*>(this);
+  uv_unref(reinterpret_cast<uv_handle_t*>(idle_prepare_));
 }
 
 void PerIsolatePlatformData::FlushTasks(uv_async_t* handle) {
@@ -200,8 +227,76 @@ void PerIsolatePlatformData::FlushTasks(uv_async_t* handle) {
   platform_data->FlushForegroundTasksInternal();
 }
 
-void PerIsolatePlatformData::PostIdleTask(std::unique_ptr<v8::IdleTask> task) {
-  UNREACHABLE();
+void PerIsolatePlatformData::PostIdleTask(std::unique_ptr<IdleTask> task) {
+  CHECK(idle_tasks_enabled_);
+  CHECK_NE(flush_tasks_, nullptr);
+  idle_tasks_.Push(std::move(task));
+  uv_async_send(flush_tasks_);
+}
+
+void PerIsolatePlatformData::SetIdleTasksEnabled(bool enabled) {
+  idle_tasks_enabled_ = enabled;
+}
+
+double PerIsolatePlatformData::IdlePeriodDeadline() {
+  // Zero means that the loop has pending callbacks, closing handles or an
+  // active idle handle (e.g. for setImmediate()).
+  int timeout = uv_backend_timeout(loop_);
+  if (timeout == 0 || HasPendingIo(loop_))
+    return 0;
+
+  uint64_t period_ms = kMaxIdlePeriodMs;
+  if (timeout > 0 && static_cast<uint64_t>(timeout) < period_ms)
+    period_ms = timeout;
+
+  // Same clock as NodePlatform::MonotonicallyIncreasingTime().
+  return (uv_hrtime() + period_ms * 1000 * 1000) / 1e9;
+}
+
+// Runs from the prepare phase, which comes right before the loop blocks for
+// I/O. If nothing but timers is left to do, idle tasks can take up the time
+// until the first timer is due.
+void PerIsolatePlatformData::RunIdleTasks(uv_prepare_t* handle) {
+  auto platform_data = static_cast<PerIsolatePlatformData*>(handle->data);
+  std::queue<std::unique_ptr<IdleTask>>& pending =
+      platform_data->pending_idle_tasks_;
+
+  std::queue<std::unique_ptr<IdleTask>> posted =
+      platform_data->idle_tasks_.PopAll();
+  while (!posted.empty()) {
+    pending.push(std::move(posted.front()));
+    posted.pop();
+  }
+
+  double deadline = platform_data->IdlePeriodDeadline();
+  if (deadline == 0)
+    return;
+
+  // Idle tasks only do GC and compilation work and never call into JS, so
+  // unlike foreground tasks they don't need a callback scope.
+  Isolate* isolate = platform_data->isolate_;
+  HandleScope scope(isolate);
+
+  // Tasks posted from here on wait for the next idle period.
+  size_t count = pending.size();
+  while (count-- > 0 && uv_hrtime() / 1e9 < deadline) {
+    std::unique_ptr<IdleTask> task = std::move(pending.front());
+    pending.pop();
+    task->Run(deadline);
+  }
+
+  // Whatever time is left goes to incremental marking and other GC work.
+  bool gc_done = true;
+  if (uv_hrtime() / 1e9 < deadline)
+    gc_done = isolate->IdleNotificationDeadline(deadline);
+
+  // V8 posts new tasks when it has more work, which starts this handle again.
+  if (gc_done && pending.empty())
+    uv_prepare_stop(handle);
+
+  // The poll timeout is computed from the cached loop time, account for the
+  // time spent here so that timers don't fire late.
+  uv_update_time(platform_data->loop_);
 }
 
 void PerIsolatePlatformData::PostTask(std::unique_ptr<Task> task) {
@@ -237,6 +332,15 @@ void PerIsolatePlatformData::Shutdown() {
     delete reinterpret_cast<uv_async_t*>(handle);
   });
   flush_tasks_ = nullptr;
+
+  // Idle tasks are not guaranteed to ever run, drop them.
+  uv_close(reinterpret_cast<uv_handle_t*>(idle_prepare_),
+           [](uv_handle_t* handle) {
+    delete reinterpret_cast<uv_prepare_t*>(handle);
+  });
+  idle_prepare_ = nullptr;
+  idle_tasks_.PopAll();
+  pending_idle_tasks_ = std::queue<std::unique_ptr<IdleTask>>();
 }
 
 void PerIsolatePlatformData::ref() {
@@ -365,6 +469,11 @@ bool PerIsolatePlatformData::FlushForegroundTasksInternal() {
     did_work = true;
     RunForegroundTask(std::move(task));
   }
+
+  // New tasks can mean that V8 has new idle work, or posted idle tasks.
+  if (idle_tasks_enabled_ && idle_prepare_ != nullptr)
+    uv_prepare_start(idle_prepare_, RunIdleTasks);
+
   return did_work;
 }
 
@@ -406,7 +515,18 @@ void NodePlatform::CancelPendingDelayedTasks(v8::Isolate* isolate) {
   ForIsolate(isolate)->CancelPendingDelayedTasks();
 }
 
-bool NodePlatform::IdleTasksEnabled(Isolate* isolate) { return false; }
+void NodePlatform::CallIdleOnForegroundThread(Isolate* isolate,
+                                              IdleTask* task) {
+  ForIsolate(isolate)->PostIdleTask(std::unique_ptr<IdleTask>(task));
+}
+
+bool NodePlatform::IdleTasksEnabled(Isolate* isolate) {
+  return ForIsolate(isolate)->IdleTasksEnabled();
+}
+
+void NodePlatform::SetIdleTasksEnabled(Isolate* isolate, bool enabled) {
+  ForIsolate(isolate)->SetIdleTasksEnabled(enabled);
+}
 
 std::shared_ptr<v8::TaskRunner>
 NodePlatform::GetForegroundTaskRunner(Isolate* isolate) {
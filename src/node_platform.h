@@ -61,7 +61,8 @@ class PerIsolatePlatformData :
   void PostIdleTask(std::unique_ptr<v8::IdleTask> task) override;
   void PostDelayedTask(std::unique_ptr<v8::Task> task,
                        double delay_in_seconds) override;
-  bool IdleTasksEnabled() override { return false; };
+  bool IdleTasksEnabled() override { return idle_tasks_enabled_; }
+  void SetIdleTasksEnabled(bool enabled);
 
   void Shutdown();
 
@@ -82,13 +83,27 @@ class PerIsolatePlatformData :
   static void FlushTasks(uv_async_t* handle);
   static void RunForegroundTask(std::unique_ptr<v8::Task> task);
   static void RunForegroundTask(uv_timer_t* timer);
+  static void RunIdleTasks(uv_prepare_t* handle);
+  // Returns the deadline of the idle period that starts now, in seconds, or
+  // 0 if the loop is not about to go idle.
+  double IdlePeriodDeadline();
 
   int ref_count_ = 1;
+  v8::Isolate* const isolate_;
   uv_loop_t* const loop_;
   uv_async_t* flush_tasks_ = nullptr;
   TaskQueue<v8::Task> foreground_tasks_;
   TaskQueue<DelayedTask> foreground_delayed_tasks_;
 
+  bool idle_tasks_enabled_ = false;
+  // Active while there may be idle work to do, runs it right before the
+  // loop blocks for I/O.
+  uv_prepare_t* idle_prepare_ = nullptr;
+  TaskQueue<v8::IdleTask> idle_tasks_;
+  // Idle tasks that didn't fit into the previous idle periods, only touched
+  // on the loop thread.
+  std::queue<std::unique_ptr<v8::IdleTask>> pending_idle_tasks_;
+
   // Use a custom deleter because libuv needs to close the handle first.
   typedef std::unique_ptr<DelayedTask, std::function<void(DelayedTask*)>>
       DelayedTaskPointer;
@@ -135,7 +150,13 @@ class NodePlatform : public MultiIsolatePlatform {
   void CallOnForegroundThread(v8::Isolate* isolate, v8::Task* task) override;
   void CallDelayedOnForegroundThread(v8::Isolate* isolate, v8::Task* task,
                                      double delay_in_seconds) override;
+  void CallIdleOnForegroundThread(v8::Isolate* isolate,
+                                  v8::IdleTask* task) override;
   bool IdleTasksEnabled(v8::Isolate* isolate) override;
+  // Idle tasks are off by default. When enabled, idle tasks and V8's idle
+  // time garbage collection run while the isolate's event loop has nothing
+  // else to do, until its next timer is due.
+  void SetIdleTasksEnabled(v8::Isolate* isolate, bool enabled);
   double MonotonicallyIncreasingTime() override;
   double CurrentClockTimeMillis() override;
   v8::TracingController* GetTracingController() override;
@@ -0,0 +1,215 @@
+#include "read_buffer_pool.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "node_buffer.h"
+#include "node_internals.h"
+#include "util-inl.h"
+
+#include <algorithm>
+
+namespace node {
+
+using v8::ArrayBuffer;
+using v8::ArrayBufferCreationMode;
+using v8::Isolate;
+using v8::Local;
+using v8::Object;
+using v8::WeakCallbackInfo;
+
+namespace {
+
+inline size_t AlignUp(size_t offset) {
+  return (offset + 7) & ~static_cast<size_t>(7);
+}
+
+}  // anonymous namespace
+
+ReadBufferPool::~ReadBufferPool() {
+  // Weak callbacks are not guaranteed to run once the Environment is gone,
+  // so free every slab now. The ArrayBuffers that are still around are
+  // neutered first, which leaves the views into them empty.
+  v8::HandleScope handle_scope(env_->isolate());
+  retired_.push_back(current_);
+  retired_.insert(retired_.end(), released_.begin(), released_.end());
+  for (Slab* slab : retired_) {
+    if (slab == nullptr)
+      continue;
+    if (!slab->array_buffer.IsEmpty()) {
+      Local<ArrayBuffer> ab =
+          Local<ArrayBuffer>::New(env_->isolate(), slab->array_buffer);
+      ab->Neuter();
+    }
+    FreeSlab(slab);
+  }
+}
+
+
+ReadBufferPool* ReadBufferPool::Get(Environment* env) {
+  ReadBufferPool* pool = env->read_buffer_pool();
+  if (pool == nullptr) {
+    pool = new ReadBufferPool(env);
+    env->set_read_buffer_pool(pool);
+  }
+  return pool;
+}
+
+
+uv_buf_t ReadBufferPool::Allocate(size_t suggested_size) {
+  if (suggested_size > kMaxPooledSize)
+    return uv_buf_init(Malloc(suggested_size), suggested_size);
+
+  size_t start = current_ != nullptr ? AlignUp(current_->used) : 0;
+  if (current_ == nullptr || start + suggested_size > kSlabSize) {
+    Slab* full = current_;
+    current_ = new Slab();
+    current_->data = Malloc(kSlabSize);
+    current_->pool = this;
+    start = 0;
+    if (full != nullptr) {
+      retired_.push_back(full);
+      MaybeRetire(full);
+    }
+  }
+
+  current_->last = start;
+  current_->used = start + suggested_size;
+  current_->pending++;
+  return uv_buf_init(current_->data + start, suggested_size);
+}
+
+
+Local<Object> ReadBufferPool::Commit(const uv_buf_t& buf, size_t nread) {
+  CHECK_GT(nread, 0);
+  CHECK_LE(nread, buf.len);
+
+  Slab* slab = FindSlab(buf.base);
+  if (slab == nullptr) {
+    char* base = Realloc(buf.base, nread);
+    return Buffer::New(env_, base, nread).ToLocalChecked();
+  }
+
+  Isolate* isolate = env_->isolate();
+  Local<ArrayBuffer> ab;
+  if (slab->array_buffer.IsEmpty()) {
+    ab = ArrayBuffer::New(isolate,
+                          slab->data,
+                          kSlabSize,
+                          ArrayBufferCreationMode::kExternalized);
+    slab->array_buffer.Reset(isolate, ab);
+    isolate->AdjustAmountOfExternalAllocatedMemory(kSlabSize);
+  } else {
+    ab = Local<ArrayBuffer>::New(isolate, slab->array_buffer);
+  }
+
+  // Finish() may make the pool's reference to the slab weak, and |ab| keeps
+  // it alive until the view has been created.
+  size_t offset = buf.base - slab->data;
+  Finish(slab, buf.base, nread);
+  return Buffer::New(env_, ab, offset, nread).ToLocalChecked();
+}
+
+
+void ReadBufferPool::Release(const uv_buf_t& buf) {
+  Slab* slab = FindSlab(buf.base);
+  if (slab == nullptr) {
+    free(buf.base);
+    return;
+  }
+  Finish(slab, buf.base, 0);
+}
+
+
+ReadBufferPool::Slab* ReadBufferPool::FindSlab(const char* data) {
+  if (data == nullptr)
+    return nullptr;
+  if (current_ != nullptr &&
+      data >= current_->data && data < current_->data + kSlabSize) {
+    return current_;
+  }
+  for (Slab* slab : retired_) {
+    if (data >= slab->data && data < slab->data + kSlabSize)
+      return slab;
+  }
+  return nullptr;
+}
+
+
+void ReadBufferPool::Finish(Slab* slab, const char* data, size_t nread) {
+  CHECK_GT(slab->pending, 0);
+  slab->pending--;
+
+  if (slab == current_) {
+    // Give back what the most recent reservation did not use.
+    size_t start = data - slab->data;
+    if (start == slab->last)
+      slab->used = start + nread;
+    return;
+  }
+
+  MaybeRetire(slab);
+}
+
+
+void ReadBufferPool::MaybeRetire(Slab* slab) {
+  if (slab->pending > 0)
+    return;
+
+  auto it = std::find(retired_.begin(), retired_.end(), slab);
+  CHECK(it != retired_.end());
+  retired_.erase(it);
+
+  if (slab->array_buffer.IsEmpty()) {
+    FreeSlab(slab);
+    return;
+  }
+
+  // If JS has seen the slab, its memory is released once the ArrayBuffer,
+  // and with it the last view into the slab, is gone.
+  slab->array_buffer.SetWeak(slab,
+                             WeakCallback,
+                             v8::WeakCallbackType::kParameter);
+  released_.push_back(slab);
+}
+
+
+void ReadBufferPool::FreeSlab(Slab* slab) {
+  if (!slab->array_buffer.IsEmpty()) {
+    slab->array_buffer.Reset();
+    env_->isolate()->AdjustAmountOfExternalAllocatedMemory(
+        -static_cast<int64_t>(kSlabSize));
+  }
+  free(slab->data);
+  delete slab;
+}
+
+
+void ReadBufferPool::WeakCallback(const WeakCallbackInfo<Slab>& data) {
+  Slab* slab = data.GetParameter();
+  ReadBufferPool* pool = slab->pool;
+  auto it = std::find(pool->released_.begin(), pool->released_.end(), slab);
+  CHECK(it != pool->released_.end());
+  pool->released_.erase(it);
+  pool->FreeSlab(slab);
+}
+
+
+void ReadBufferPool::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackThis(this);
+  tracker->TrackFieldWithSize("retired_slabs",
+                              retired_.capacity() * sizeof(Slab*));
+  tracker->TrackFieldWithSize("released_slabs",
+                              released_.capacity() * sizeof(Slab*));
+  auto track_slab = [&](const Slab* slab) {
+    tracker->TrackFieldWithSize("slab", kSlabSize);
+    if (!slab->array_buffer.IsEmpty())
+      tracker->TrackField("array_buffer", slab->array_buffer);
+  };
+  if (current_ != nullptr)
+    track_slab(current_);
+  for (const Slab* slab : retired_)
+    track_slab(slab);
+  for (const Slab* slab : released_)
+    track_slab(slab);
+}
+
+}  // namespace node
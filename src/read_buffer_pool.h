@@ -0,0 +1,92 @@
+#ifndef SRC_READ_BUFFER_POOL_H_
+#define SRC_READ_BUFFER_POOL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "base_object.h"
+#include "memory_tracker.h"
+#include "node_persistent.h"
+#include "uv.h"
+#include "v8.h"
+
+#include <vector>
+
+namespace node {
+
+class Environment;
+
+// Hands out read buffers for streams and UDP sockets.
+//
+// Rather than allocating a fresh suggested_size (64 KiB) chunk for every
+// read, reservations are carved out of shared 1 MiB slabs. Since reads on
+// the event loop thread are usually filled and handed to JS before the next
+// one starts, the unused tail of a reservation is given back right away, so
+// that many small reads end up packed back to back in the same slab.
+//
+// Once data has been read into it, a slab is backed by a single ArrayBuffer
+// and every read is exposed to JS as an exact-size Buffer view into it. The
+// ArrayBuffer is externalized: the pool keeps owning the memory, which new
+// reads may still go into, so transferring the ArrayBuffer to another thread
+// copies it instead of handing it over. Once the slab is full, the pool only
+// holds on to it weakly and frees it after all of those views have been
+// garbage collected.
+class ReadBufferPool : public MemoryRetainer {
+ public:
+  static constexpr size_t kSlabSize = 1024 * 1024;
+  // Larger reservations are not worth packing, and are allocated on their
+  // own instead.
+  static constexpr size_t kMaxPooledSize = kSlabSize / 2;
+
+  ~ReadBufferPool() override;
+
+  // Returns the pool for |env|, creating it if necessary.
+  static ReadBufferPool* Get(Environment* env);
+
+  // Reserves memory for a read of up to |suggested_size| bytes. Every
+  // reservation must be passed to exactly one of Commit() or Release().
+  uv_buf_t Allocate(size_t suggested_size);
+  // Returns a Buffer that holds the first |nread| bytes of |buf|, which
+  // must be > 0 and no larger than buf.len.
+  v8::Local<v8::Object> Commit(const uv_buf_t& buf, size_t nread);
+  // Gives back a reservation that no data has been read into.
+  void Release(const uv_buf_t& buf);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  ADD_MEMORY_INFO_NAME(ReadBufferPool)
+
+ private:
+  struct Slab {
+    char* data = nullptr;
+    size_t used = 0;
+    // Reservations that have not been committed or released yet.
+    size_t pending = 0;
+    // The start of the most recent reservation, whose unused tail can be
+    // given back when it is committed.
+    size_t last = 0;
+    ReadBufferPool* pool = nullptr;
+    Persistent<v8::ArrayBuffer> array_buffer;
+  };
+
+  explicit ReadBufferPool(Environment* env) : env_(env) {}
+
+  Slab* FindSlab(const char* data);
+  void Finish(Slab* slab, const char* data, size_t nread);
+  // Drops a slab that is no longer current and has no pending reservations.
+  void MaybeRetire(Slab* slab);
+  void FreeSlab(Slab* slab);
+  static void WeakCallback(const v8::WeakCallbackInfo<Slab>& data);
+
+  Environment* const env_;
+  // The slab that new reservations are carved from.
+  Slab* current_ = nullptr;
+  // Slabs that are full but still have pending reservations.
+  std::vector<Slab*> retired_;
+  // Slabs that are done with, but may still have views into them in JS.
+  std::vector<Slab*> released_;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_READ_BUFFER_POOL_H_
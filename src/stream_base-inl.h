@@ -322,6 +322,9 @@ void StreamBase::AddMethods(Environment* env, Local<FunctionTemplate> t) {
 
   env->SetProtoMethod(t, "readStart", JSMethod<Base, &StreamBase::ReadStartJS>);
   env->SetProtoMethod(t, "readStop", JSMethod<Base, &StreamBase::ReadStopJS>);
+  env->SetProtoMethod(t,
+                      "useUserBuffer",
+                      JSMethod<Base, &StreamBase::UseUserBuffer>);
   env->SetProtoMethod(t, "shutdown", JSMethod<Base, &StreamBase::Shutdown>);
   env->SetProtoMethod(t, "writev", JSMethod<Base, &StreamBase::Writev>);
   env->SetProtoMethod(t,
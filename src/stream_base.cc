@@ -5,6 +5,7 @@
 #include "node_buffer.h"
 #include "node_errors.h"
 #include "node_internals.h"
+#include "read_buffer_pool.h"
 #include "env-inl.h"
 #include "js_stream.h"
 #include "string_bytes.h"
@@ -22,6 +23,7 @@ using v8::FunctionCallbackInfo;
 using v8::HandleScope;
 using v8::Integer;
 using v8::Local;
+using v8::MaybeLocal;
 using v8::Number;
 using v8::Object;
 using v8::String;
@@ -52,6 +54,14 @@ int StreamBase::ReadStopJS(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+int StreamBase::UseUserBuffer(const FunctionCallbackInfo<Value>& args) {
+  CHECK(Buffer::HasInstance(args[0]));
+  PushStreamListener(
+      new CustomBufferJSListener(env_, args[0].As<Object>()));
+  return 0;
+}
+
+
 int StreamBase::Shutdown(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsObject());
   Local<Object> req_wrap_obj = args[0].As<Object>();
@@ -309,7 +319,8 @@ int StreamBase::WriteString(const FunctionCallbackInfo<Value>& args) {
 }
 
 
-void StreamBase::CallJSOnreadMethod(ssize_t nread, Local<Object> buf) {
+MaybeLocal<Value> StreamBase::CallJSOnreadMethod(ssize_t nread,
+                                                Local<Object> buf) {
   Environment* env = env_;
 
   Local<Value> argv[] = {
@@ -322,7 +333,7 @@ void StreamBase::CallJSOnreadMethod(ssize_t nread, Local<Object> buf) {
 
   AsyncWrap* wrap = GetAsyncWrap();
   CHECK_NOT_NULL(wrap);
-  wrap->MakeCallback(env->onread_string(), arraysize(argv), argv);
+  return wrap->MakeCallback(env->onread_string(), arraysize(argv), argv);
 }
 
 
@@ -362,6 +373,13 @@ uv_buf_t StreamListener::OnStreamAlloc(size_t suggested_size) {
 }
 
 
+uv_buf_t EmitToJSStreamListener::OnStreamAlloc(size_t suggested_size) {
+  CHECK_NOT_NULL(stream_);
+  Environment* env = static_cast<StreamBase*>(stream_)->stream_env();
+  return ReadBufferPool::Get(env)->Allocate(suggested_size);
+}
+
+
 void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
   CHECK_NOT_NULL(stream_);
   StreamBase* stream = static_cast<StreamBase*>(stream_);
@@ -369,21 +387,61 @@ void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
+  ReadBufferPool* pool = ReadBufferPool::Get(env);
   if (nread <= 0)  {
-    free(buf.base);
+    pool->Release(buf);
     if (nread < 0)
       stream->CallJSOnreadMethod(nread, Local<Object>());
     return;
   }
 
-  CHECK_LE(static_cast<size_t>(nread), buf.len);
-  char* base = Realloc(buf.base, nread);
-
-  Local<Object> obj = Buffer::New(env, base, nread).ToLocalChecked();
+  Local<Object> obj = pool->Commit(buf, nread);
   stream->CallJSOnreadMethod(nread, obj);
 }
 
 
+CustomBufferJSListener::CustomBufferJSListener(Environment* env,
+                                               Local<Object> buffer) {
+  SetBuffer(env, buffer);
+}
+
+
+void CustomBufferJSListener::SetBuffer(Environment* env,
+                                       Local<Object> buffer) {
+  buffer_object_.Reset(env->isolate(), buffer);
+  buffer_ = uv_buf_init(Buffer::Data(buffer), Buffer::Length(buffer));
+}
+
+
+uv_buf_t CustomBufferJSListener::OnStreamAlloc(size_t suggested_size) {
+  return buffer_;
+}
+
+
+void CustomBufferJSListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
+  CHECK_NOT_NULL(stream_);
+  StreamBase* stream = static_cast<StreamBase*>(stream_);
+  Environment* env = stream->stream_env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  if (nread <= 0) {
+    if (nread < 0)
+      stream->CallJSOnreadMethod(nread, Local<Object>());
+    return;
+  }
+
+  CHECK_EQ(buf.base, buffer_.base);
+  CHECK_LE(static_cast<size_t>(nread), buffer_.len);
+
+  Local<Value> next;
+  if (stream->CallJSOnreadMethod(nread, Local<Object>()).ToLocal(&next) &&
+      Buffer::HasInstance(next)) {
+    SetBuffer(env, next.As<Object>());
+  }
+}
+
+
 void ReportWritesToJSStreamListener::OnStreamAfterReqFinished(
     StreamReq* req_wrap, int status) {
   StreamBase* stream = static_cast<StreamBase*>(stream_);
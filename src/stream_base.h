@@ -6,6 +6,7 @@
 #include "env.h"
 #include "async_wrap-inl.h"
 #include "node.h"
+#include "node_persistent.h"
 #include "util.h"
 
 #include "v8.h"
@@ -181,10 +182,33 @@ class ReportWritesToJSStreamListener : public StreamListener {
 // JS land via the handle’s .ondata method.
 class EmitToJSStreamListener : public ReportWritesToJSStreamListener {
  public:
+  // Reads are carved out of the Environment's ReadBufferPool, and emitted
+  // as views into it.
+  uv_buf_t OnStreamAlloc(size_t suggested_size) override;
   void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override;
 };
 
 
+// Reads data into a Buffer that was provided by JS land, and only passes
+// the number of bytes read to the handle’s .onread method. If that returns
+// another Buffer, the next read goes there instead.
+// This is used for the `onread` option of `net.Socket`.
+class CustomBufferJSListener : public ReportWritesToJSStreamListener {
+ public:
+  CustomBufferJSListener(Environment* env, v8::Local<v8::Object> buffer);
+
+  uv_buf_t OnStreamAlloc(size_t suggested_size) override;
+  void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override;
+  void OnStreamDestroy() override { delete this; }
+
+ private:
+  void SetBuffer(Environment* env, v8::Local<v8::Object> buffer);
+
+  Persistent<v8::Object> buffer_object_;
+  uv_buf_t buffer_;
+};
+
+
 // A generic stream, comparable to JS land’s `Duplex` streams.
 // A stream is always controlled through one `StreamListener` instance.
 class StreamResource {
@@ -264,7 +288,8 @@ class StreamBase : public StreamResource {
   virtual bool IsIPCPipe();
   virtual int GetFD();
 
-  void CallJSOnreadMethod(ssize_t nread, v8::Local<v8::Object> buf);
+  v8::MaybeLocal<v8::Value> CallJSOnreadMethod(ssize_t nread,
+                                               v8::Local<v8::Object> buf);
 
   // This is named `stream_env` to avoid name clashes, because a lot of
   // subclasses are also `BaseObject`s.
@@ -303,6 +328,7 @@ class StreamBase : public StreamResource {
   // JS Methods
   int ReadStartJS(const v8::FunctionCallbackInfo<v8::Value>& args);
   int ReadStopJS(const v8::FunctionCallbackInfo<v8::Value>& args);
+  int UseUserBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
   int Shutdown(const v8::FunctionCallbackInfo<v8::Value>& args);
   int Writev(const v8::FunctionCallbackInfo<v8::Value>& args);
   int WriteBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
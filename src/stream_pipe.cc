@@ -1,22 +1,261 @@
 #include "stream_pipe.h"
 #include "stream_base-inl.h"
+#include "stream_wrap.h"
 #include "node_buffer.h"
 #include "node_internals.h"
 
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using v8::Boolean;
 using v8::Context;
 using v8::External;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Integer;
 using v8::Local;
 using v8::Object;
 using v8::Value;
 
 namespace node {
 
+#ifdef __linux__
+namespace {
+
+// Returns |stream| if it is backed by a file descriptor that splice(2) can
+// move data to and from, i.e. a TCP socket or a pipe that is not used for
+// IPC, and nullptr otherwise.
+LibuvStreamWrap* SpliceableStream(StreamBase* stream) {
+  switch (stream->GetAsyncWrap()->provider_type()) {
+    case AsyncWrap::PROVIDER_TCPWRAP:
+    case AsyncWrap::PROVIDER_PIPEWRAP:
+      break;
+    default:
+      return nullptr;
+  }
+  LibuvStreamWrap* wrap = static_cast<LibuvStreamWrap*>(stream);
+  if (!wrap->IsAlive() || wrap->IsClosing() || wrap->IsIPCPipe() ||
+      wrap->GetFD() < 0) {
+    return nullptr;
+  }
+  return wrap;
+}
+
+}  // anonymous namespace
+
+// Does the actual splicing for a StreamPipe. This uses duplicates of the
+// streams' file descriptors, so that it can wait for them with uv_poll_t
+// handles of its own without touching the streams' I/O watchers, which
+// stay idle as long as the source is not reading and nothing is written to
+// the sink otherwise.
+//
+// Data is spliced from the source into a kernel pipe, and from there into
+// the sink. The pipe is always drained before more is read from the source,
+// so when the sink can't keep up, the source is not polled until the sink
+// becomes writable again, and backpressure builds up in the source's socket
+// buffers.
+class StreamPipe::Splicer {
+ public:
+  // The default capacity of a pipe on Linux.
+  static constexpr size_t kChunkSize = 64 * 1024;
+  // How much data to move in one go before yielding to the event loop.
+  static constexpr int kMaxChunksPerPump = 16;
+
+  explicit Splicer(StreamPipe* pipe) : pipe_(pipe) {}
+
+  int Start(LibuvStreamWrap* source, LibuvStreamWrap* sink);
+  // Detaches the splicer from its StreamPipe. It deletes itself once its
+  // handles are closed.
+  void Close();
+
+ private:
+  ~Splicer();
+
+  void Pump();
+  int WaitFor(uv_poll_t* poll, int events);
+  void Finish(int status, bool source_side);
+
+  static void OnEvent(uv_poll_t* handle, int status, int events);
+  static void OnHandleClose(uv_handle_t* handle);
+
+  StreamPipe* pipe_;
+  int source_fd_ = -1;
+  int sink_fd_ = -1;
+  int pipe_fds_[2] = { -1, -1 };
+  uv_poll_t source_poll_;
+  uv_poll_t sink_poll_;
+  int open_handles_ = 0;
+  // Bytes in the kernel pipe that have not been passed on to the sink yet.
+  size_t buffered_ = 0;
+  bool eof_ = false;
+};
+
+
+int StreamPipe::Splicer::Start(LibuvStreamWrap* source,
+                               LibuvStreamWrap* sink) {
+  source_fd_ = fcntl(source->GetFD(), F_DUPFD_CLOEXEC, 0);
+  if (source_fd_ == -1)
+    return -errno;
+  sink_fd_ = fcntl(sink->GetFD(), F_DUPFD_CLOEXEC, 0);
+  if (sink_fd_ == -1)
+    return -errno;
+  if (pipe2(pipe_fds_, O_CLOEXEC | O_NONBLOCK) == -1)
+    return -errno;
+
+  int err = uv_poll_init(pipe_->env()->event_loop(), &source_poll_, source_fd_);
+  if (err != 0)
+    return err;
+  source_poll_.data = this;
+  open_handles_++;
+
+  err = uv_poll_init(pipe_->env()->event_loop(), &sink_poll_, sink_fd_);
+  if (err != 0)
+    return err;
+  sink_poll_.data = this;
+  open_handles_++;
+
+  return WaitFor(&source_poll_, UV_READABLE);
+}
+
+
+void StreamPipe::Splicer::Close() {
+  pipe_ = nullptr;
+  if (open_handles_ == 0) {
+    delete this;
+    return;
+  }
+  // Only the handles that were initialized have been counted, and they were
+  // initialized in this order.
+  if (open_handles_ == 2)
+    uv_close(reinterpret_cast<uv_handle_t*>(&sink_poll_), OnHandleClose);
+  uv_close(reinterpret_cast<uv_handle_t*>(&source_poll_), OnHandleClose);
+}
+
+
+StreamPipe::Splicer::~Splicer() {
+  for (int fd : { source_fd_, sink_fd_, pipe_fds_[0], pipe_fds_[1] }) {
+    if (fd != -1)
+      close(fd);
+  }
+}
+
+
+void StreamPipe::Splicer::OnHandleClose(uv_handle_t* handle) {
+  Splicer* splicer = static_cast<Splicer*>(handle->data);
+  if (--splicer->open_handles_ == 0)
+    delete splicer;
+}
+
+
+int StreamPipe::Splicer::WaitFor(uv_poll_t* poll, int events) {
+  uv_poll_t* other = poll == &source_poll_ ? &sink_poll_ : &source_poll_;
+  uv_poll_stop(other);
+  return uv_poll_start(poll, events, OnEvent);
+}
+
+
+void StreamPipe::Splicer::OnEvent(uv_poll_t* handle, int status, int events) {
+  // libuv reports any error condition on the socket as UV_EBADF. splice()
+  // fails with the actual error in that case, so just try it.
+  static_cast<Splicer*>(handle->data)->Pump();
+}
+
+
+void StreamPipe::Splicer::Pump() {
+  LibuvStreamWrap* source = static_cast<LibuvStreamWrap*>(pipe_->source());
+  LibuvStreamWrap* sink = static_cast<LibuvStreamWrap*>(pipe_->sink());
+  ssize_t n;
+
+  for (int i = 0; i < kMaxChunksPerPump; i++) {
+    while (buffered_ > 0) {
+      do {
+        n = splice(pipe_fds_[0], nullptr, sink_fd_, nullptr, buffered_,
+                   SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+      } while (n == -1 && errno == EINTR);
+      if (n == -1 && errno == EAGAIN) {
+        int err = WaitFor(&sink_poll_, UV_WRITABLE);
+        if (err != 0)
+          Finish(err, false);
+        return;
+      }
+      if (n == -1)
+        return Finish(-errno, false);
+      buffered_ -= n;
+      sink->bytes_written_ += n;
+      sink->RefreshIdleTimeout();
+    }
+
+    if (eof_)
+      return Finish(UV_EOF, true);
+
+    do {
+      n = splice(source_fd_, nullptr, pipe_fds_[1], nullptr, kChunkSize,
+                 SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    } while (n == -1 && errno == EINTR);
+    if (n == -1 && errno == EAGAIN)
+      break;
+    if (n == -1)
+      return Finish(-errno, true);
+    if (n == 0) {
+      eof_ = true;
+      continue;
+    }
+    buffered_ += n;
+    source->bytes_read_ += n;
+    source->RefreshIdleTimeout();
+  }
+
+  // Either the source has no more data right now, or this is a good point
+  // to let other handles run. Polling is level-triggered, so in the latter
+  // case this is called again right away on the next loop iteration.
+  int err = buffered_ > 0 ? WaitFor(&sink_poll_, UV_WRITABLE) :
+                            WaitFor(&source_poll_, UV_READABLE);
+  if (err != 0)
+    Finish(err, buffered_ == 0);
+}
+
+
+void StreamPipe::Splicer::Finish(int status, bool source_side) {
+  uv_poll_stop(&source_poll_);
+  uv_poll_stop(&sink_poll_);
+  pipe_->OnSpliceDone(status, source_side);
+}
+
+
+void StreamPipe::OnSpliceDone(int status, bool source_side) {
+  AsyncScope async_scope(this);
+  if (source_side) {
+    // Report EOF or the read error to JS in the same way as a stream that
+    // is not spliced would.
+    unpipe_status_ = status == UV_EOF ? UV_EOF : 0;
+    readable_listener_.OnStreamRead(status, uv_buf_init(nullptr, 0));
+  } else {
+    unpipe_status_ = status;
+    is_eof_ = true;
+    Unpipe();
+  }
+}
+#endif  // __linux__
+
+
+bool StreamPipe::CanSplice(StreamBase* source, StreamBase* sink) {
+#ifdef __linux__
+  return SpliceableStream(source) != nullptr &&
+         SpliceableStream(sink) != nullptr;
+#else
+  return false;
+#endif
+}
+
+
 StreamPipe::StreamPipe(StreamBase* source,
                        StreamBase* sink,
                        Local<Object> obj)
-    : AsyncWrap(source->stream_env(), obj, AsyncWrap::PROVIDER_STREAMPIPE) {
+    : AsyncWrap(source->stream_env(), obj, AsyncWrap::PROVIDER_STREAMPIPE),
+      splice_(CanSplice(source, sink)) {
   MakeWeak();
 
   CHECK_NOT_NULL(sink);
@@ -25,7 +264,7 @@ StreamPipe::StreamPipe(StreamBase* source,
   source->PushStreamListener(&readable_listener_);
   sink->PushStreamListener(&writable_listener_);
 
-  CHECK(sink->HasWantsWrite());
+  CHECK(splice_ || sink->HasWantsWrite());
 
   // Set up links between this object and the source/sink objects.
   // In particular, this makes sure that they are garbage collected as a group,
@@ -65,6 +304,12 @@ void StreamPipe::Unpipe() {
 
   is_closed_ = true;
   is_reading_ = false;
+#ifdef __linux__
+  if (splicer_ != nullptr) {
+    splicer_->Close();
+    splicer_ = nullptr;
+  }
+#endif
   source()->RemoveStreamListener(&readable_listener_);
   sink()->RemoveStreamListener(&writable_listener_);
 
@@ -79,7 +324,11 @@ void StreamPipe::Unpipe() {
     Local<Object> object = pipe->object();
 
     if (object->Has(env->context(), env->onunpipe_string()).FromJust()) {
-      pipe->MakeCallback(env->onunpipe_string(), 0, nullptr).ToLocalChecked();
+      Local<Value> argv[] = {
+        Integer::New(env->isolate(), pipe->unpipe_status_)
+      };
+      pipe->MakeCallback(env->onunpipe_string(), arraysize(argv), argv)
+          .ToLocalChecked();
     }
 
     // Set all the links established in the constructor to `null`.
@@ -126,8 +375,11 @@ void StreamPipe::ReadableListener::OnStreamRead(ssize_t nread,
     previous_listener_->OnStreamRead(nread, uv_buf_init(nullptr, 0));
     // If we’re not writing, close now. Otherwise, we’ll do that in
     // `OnStreamAfterWrite()`.
+    // When splicing, the sink is a regular JS stream as far as JS land is
+    // concerned, and it is left to `onunpipe` to end it.
     if (!pipe->is_writing_) {
-      pipe->ShutdownWritable();
+      if (!pipe->splice_)
+        pipe->ShutdownWritable();
       pipe->Unpipe();
     }
     return;
@@ -234,6 +486,20 @@ void StreamPipe::Start(const FunctionCallbackInfo<Value>& args) {
   StreamPipe* pipe;
   ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
   pipe->is_closed_ = false;
+
+#ifdef __linux__
+  if (pipe->splice_) {
+    // The source must not read through libuv while data is spliced from it.
+    pipe->source()->ReadStop();
+    pipe->splicer_ = new Splicer(pipe);
+    int err = pipe->splicer_->Start(SpliceableStream(pipe->source()),
+                                    SpliceableStream(pipe->sink()));
+    if (err != 0)
+      pipe->Unpipe();
+    return args.GetReturnValue().Set(err);
+  }
+#endif
+
   if (pipe->wanted_data_ > 0)
     pipe->writable_listener_.OnStreamWantsWrite(pipe->wanted_data_);
 }
@@ -244,6 +510,15 @@ void StreamPipe::Unpipe(const FunctionCallbackInfo<Value>& args) {
   pipe->Unpipe();
 }
 
+void StreamPipe::CanSplice(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsExternal());
+  CHECK(args[1]->IsExternal());
+  auto source = static_cast<StreamBase*>(args[0].As<External>()->Value());
+  auto sink = static_cast<StreamBase*>(args[1].As<External>()->Value());
+  args.GetReturnValue().Set(
+      Boolean::New(args.GetIsolate(), CanSplice(source, sink)));
+}
+
 namespace {
 
 void InitializeStreamPipe(Local<Object> target,
@@ -264,6 +539,7 @@ void InitializeStreamPipe(Local<Object> target,
       ->Set(context, stream_pipe_string,
             pipe->GetFunction(context).ToLocalChecked())
       .FromJust();
+  env->SetMethod(target, "canSplice", StreamPipe::CanSplice);
 }
 
 }  // anonymous namespace
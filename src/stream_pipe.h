@@ -7,6 +7,13 @@
 
 namespace node {
 
+// Moves data from one StreamBase to another without going through JS.
+//
+// Usually, data is read from the source through a listener and written to
+// the sink once it asks for more with OnStreamWantsWrite(). On Linux, when
+// both ends are TCP sockets or non-IPC pipes, data is instead spliced from
+// one file descriptor to the other through a kernel pipe, so that it never
+// reaches userland at all.
 class StreamPipe : public AsyncWrap {
  public:
   StreamPipe(StreamBase* source, StreamBase* sink, v8::Local<v8::Object> obj);
@@ -14,9 +21,13 @@ class StreamPipe : public AsyncWrap {
 
   void Unpipe();
 
+  // Whether data can be spliced from |source| to |sink|.
+  static bool CanSplice(StreamBase* source, StreamBase* sink);
+
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Unpipe(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void CanSplice(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   void MemoryInfo(MemoryTracker* tracker) const override {
     tracker->TrackThis(this);
@@ -37,6 +48,9 @@ class StreamPipe : public AsyncWrap {
   bool is_closed_ = true;
   bool sink_destroyed_ = false;
   bool source_destroyed_ = false;
+  // Passed to `onunpipe`: UV_EOF if the source ended, an error code if
+  // writing to the sink failed, and 0 otherwise.
+  int unpipe_status_ = 0;
 
   // Set a default value so that when we’re coming from Start(), we know
   // that we don’t want to read just yet.
@@ -46,6 +60,16 @@ class StreamPipe : public AsyncWrap {
 
   void ProcessData(size_t nread, const uv_buf_t& buf);
 
+  // Set if data is spliced rather than passed through the listeners below.
+  // The listeners are still installed, to notice when either stream goes
+  // away.
+  const bool splice_;
+#ifdef __linux__
+  class Splicer;
+  Splicer* splicer_ = nullptr;
+  void OnSpliceDone(int status, bool source_side);
+#endif
+
   class ReadableListener : public StreamListener {
    public:
     uv_buf_t OnStreamAlloc(size_t suggested_size) override;
@@ -34,6 +34,14 @@
 #include <string.h>  // memcpy()
 #include <limits.h>  // INT_MAX
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>  // F_DUPFD_CLOEXEC
+#endif
+
 
 namespace node {
 
@@ -43,7 +51,10 @@ using v8::EscapableHandleScope;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Int32;
+using v8::Integer;
 using v8::Local;
+using v8::Number;
 using v8::Object;
 using v8::ReadOnly;
 using v8::Signature;
@@ -80,6 +91,15 @@ void LibuvStreamWrap::Initialize(Local<Object> target,
   target->Set(writeWrapString,
               ww->GetFunction(env->context()).ToLocalChecked());
   env->set_write_wrap_template(ww->InstanceTemplate());
+
+  Local<FunctionTemplate> sfw =
+      BaseObject::MakeLazilyInitializedJSTemplate(env);
+  Local<String> sendFileWrapString =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "SendFileWrap");
+  sfw->SetClassName(sendFileWrapString);
+  AsyncWrap::AddWrapMethods(env, sfw);
+  target->Set(sendFileWrapString,
+              sfw->GetFunction(env->context()).ToLocalChecked());
 }
 
 
@@ -109,6 +129,12 @@ void LibuvStreamWrap::AddMethods(Environment* env,
       Local<FunctionTemplate>(),
       static_cast<PropertyAttribute>(ReadOnly | DontDelete));
   env->SetProtoMethod(target, "setBlocking", SetBlocking);
+  env->SetProtoMethod(target, "setIdleTimeout", SetIdleTimeout);
+  env->SetProtoMethod(target, "getIdleTimeout", GetIdleTimeout);
+  env->SetProtoMethod(target, "getIdleSince", GetIdleSince);
+#ifndef _WIN32
+  env->SetProtoMethod(target, "sendFile", SendFile);
+#endif
   StreamBase::AddMethods<LibuvStreamWrap>(env, target);
 }
 
@@ -225,6 +251,7 @@ void LibuvStreamWrap::OnUvRead(ssize_t nread, const uv_buf_t* buf) {
     }
   }
 
+  RefreshIdleTimeout();
   EmitRead(nread, *buf);
 }
 
@@ -256,6 +283,233 @@ void LibuvStreamWrap::SetBlocking(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(uv_stream_set_blocking(wrap->stream(), enable));
 }
 
+
+// Sets the number of milliseconds of inactivity after which `ontimeout` is
+// called, like a timer that is restarted on every read and write. 0 turns
+// the timeout off. It fires once per period of inactivity.
+void LibuvStreamWrap::SetIdleTimeout(const FunctionCallbackInfo<Value>& args) {
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  CHECK(args[0]->IsNumber());
+  double msecs = args[0].As<Number>()->Value();
+  CHECK_GE(msecs, 0);
+
+  if (!wrap->IsAlive() || wrap->IsHandleClosing())
+    return;
+
+  wrap->DisarmIdleTimeout();
+
+  // Like timers, durations below 1 ms are rounded up.
+  wrap->idle_timeout_ = msecs > 0 ? std::max<uint64_t>(msecs, 1) : 0;
+  wrap->RefreshIdleTimeout();
+}
+
+
+void LibuvStreamWrap::GetIdleTimeout(const FunctionCallbackInfo<Value>& args) {
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  args.GetReturnValue().Set(static_cast<double>(wrap->idle_timeout_));
+}
+
+
+// Returns the loop time of the last read or write that restarted the idle
+// timeout, in milliseconds.
+void LibuvStreamWrap::GetIdleSince(const FunctionCallbackInfo<Value>& args) {
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  args.GetReturnValue().Set(static_cast<double>(wrap->idle_since_));
+}
+
+
+void LibuvStreamWrap::RefreshIdleTimeout() {
+  if (idle_timeout_ == 0)
+    return;
+
+  idle_since_ = uv_now(env()->event_loop());
+  if (!idle_timeout_armed_) {
+    StreamIdleTimeouts::Get(env())->Add(this);
+    idle_timeout_armed_ = true;
+  }
+}
+
+
+void LibuvStreamWrap::DisarmIdleTimeout() {
+  if (!idle_timeout_armed_)
+    return;
+
+  // It is gone when the Environment is being torn down.
+  StreamIdleTimeouts* timeouts = env()->stream_idle_timeouts();
+  if (timeouts != nullptr)
+    timeouts->Remove(this);
+  idle_timeout_armed_ = false;
+}
+
+
+void LibuvStreamWrap::OnIdleTimeout() {
+  if (!IsAlive() || IsHandleClosing())
+    return;
+
+  MakeCallback(env()->ontimeout_string(), 0, nullptr);
+}
+
+
+StreamIdleTimeouts::StreamIdleTimeouts(Environment* env) : env_(env) {
+  CHECK_EQ(0, uv_timer_init(env->event_loop(), &timer_));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&timer_));
+
+  env->RegisterHandleCleanup(
+      reinterpret_cast<uv_handle_t*>(&timer_),
+      [](Environment* env, uv_handle_t* handle, void* arg) {
+        env->set_stream_idle_timeouts(nullptr);
+        env->CloseHandle(handle, [](uv_handle_t* handle) {
+          StreamIdleTimeouts* timeouts =
+              ContainerOf(&StreamIdleTimeouts::timer_,
+                          reinterpret_cast<uv_timer_t*>(handle));
+          delete timeouts;
+        });
+      },
+      nullptr);
+}
+
+
+StreamIdleTimeouts* StreamIdleTimeouts::Get(Environment* env) {
+  StreamIdleTimeouts* timeouts = env->stream_idle_timeouts();
+  if (timeouts == nullptr) {
+    timeouts = new StreamIdleTimeouts(env);
+    env->set_stream_idle_timeouts(timeouts);
+  }
+  return timeouts;
+}
+
+
+void StreamIdleTimeouts::Add(LibuvStreamWrap* stream) {
+  streams_.insert(stream);
+  Schedule(stream->idle_since_ + stream->idle_timeout_);
+}
+
+
+void StreamIdleTimeouts::Remove(LibuvStreamWrap* stream) {
+  streams_.erase(stream);
+  if (streams_.empty()) {
+    uv_timer_stop(&timer_);
+    deadline_ = 0;
+  }
+}
+
+
+void StreamIdleTimeouts::Schedule(uint64_t deadline) {
+  if (deadline_ != 0 && deadline_ <= deadline)
+    return;
+
+  uint64_t now = uv_now(env_->event_loop());
+  deadline_ = deadline;
+  uv_timer_start(&timer_, OnTimer, deadline > now ? deadline - now : 0, 0);
+}
+
+
+void StreamIdleTimeouts::OnTimer(uv_timer_t* handle) {
+  StreamIdleTimeouts* timeouts =
+      ContainerOf(&StreamIdleTimeouts::timer_, handle);
+  timeouts->Sweep();
+}
+
+
+void StreamIdleTimeouts::Sweep() {
+  uint64_t now = uv_now(env_->event_loop());
+  uint64_t next = UINT64_MAX;
+  uint64_t shortest = UINT64_MAX;
+  std::vector<LibuvStreamWrap*> expired;
+
+  for (LibuvStreamWrap* stream : streams_) {
+    uint64_t deadline = stream->idle_since_ + stream->idle_timeout_;
+    if (deadline <= now) {
+      expired.push_back(stream);
+    } else {
+      next = std::min(next, deadline);
+      shortest = std::min(shortest, stream->idle_timeout_);
+    }
+  }
+
+  for (LibuvStreamWrap* stream : expired) {
+    streams_.erase(stream);
+    stream->idle_timeout_armed_ = false;
+  }
+
+  deadline_ = 0;
+  if (next != UINT64_MAX)
+    Schedule(std::max(next, now + shortest / kSweepSlack));
+
+  if (expired.empty())
+    return;
+
+  HandleScope handle_scope(env_->isolate());
+  Context::Scope context_scope(env_->context());
+  for (LibuvStreamWrap* stream : expired) {
+    // A previous callback may have closed the stream, or restarted or turned
+    // off its timeout. Closed streams are only deleted in the close callback,
+    // which runs later.
+    if (stream->idle_timeout_armed_ || stream->idle_timeout_ == 0)
+      continue;
+    stream->OnIdleTimeout();
+  }
+}
+
+
+#ifndef _WIN32
+void LibuvStreamWrap::SendFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsInt32());
+  CHECK(args[2]->IsNumber());
+  CHECK(args[3]->IsNumber());
+
+  Local<Object> req_wrap_obj = args[0].As<Object>();
+  uv_file in_fd = args[1].As<Int32>()->Value();
+  int64_t offset = args[2]->IntegerValue(env->context()).FromJust();
+  int64_t length = args[3]->IntegerValue(env->context()).FromJust();
+  CHECK_GE(offset, 0);
+  CHECK_GE(length, 0);
+
+  if (!wrap->IsAlive() || wrap->IsClosing())
+    return args.GetReturnValue().Set(UV_EBADF);
+  if (wrap->send_file_ != nullptr)
+    return args.GetReturnValue().Set(UV_EBUSY);
+
+  int fd = wrap->GetFD();
+  if (fd < 0)
+    return args.GetReturnValue().Set(UV_EBADF);
+
+  int out_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (out_fd == -1)
+    return args.GetReturnValue().Set(uv_translate_sys_error(errno));
+
+  SendFileWrap* req_wrap =
+      new SendFileWrap(env, req_wrap_obj, wrap, out_fd, in_fd, offset, length);
+  int err = req_wrap->SendChunk();
+  if (err == 0)
+    wrap->send_file_ = req_wrap;
+  else
+    delete req_wrap;
+
+  args.GetReturnValue().Set(err);
+}
+#endif  // _WIN32
+
+
+void LibuvStreamWrap::OnClose() {
+  DisarmIdleTimeout();
+  idle_timeout_ = 0;
+#ifndef _WIN32
+  if (send_file_ != nullptr)
+    send_file_->Abort();
+  CHECK_NULL(send_file_);
+#endif
+}
+
 typedef SimpleShutdownWrap<ReqWrap<uv_shutdown_t>> LibuvShutdownWrap;
 typedef SimpleWriteWrap<ReqWrap<uv_write_t>> LibuvWriteWrap;
 
@@ -300,6 +554,8 @@ int LibuvStreamWrap::DoTryWrite(uv_buf_t** bufs, size_t* count) {
   if (err < 0)
     return err;
 
+  RefreshIdleTimeout();
+
   // Slice off the buffers: skip all written buffers and slice the one that
   // was partially written.
   written = err;
@@ -345,6 +601,7 @@ int LibuvStreamWrap::DoWrite(WriteWrap* req_wrap,
     size_t bytes = 0;
     for (size_t i = 0; i < count; i++)
       bytes += bufs[i].len;
+    RefreshIdleTimeout();
   }
 
   return r;
@@ -358,9 +615,175 @@ void LibuvStreamWrap::AfterUvWrite(uv_write_t* req, int status) {
   CHECK_NOT_NULL(req_wrap);
   HandleScope scope(req_wrap->env()->isolate());
   Context::Scope context_scope(req_wrap->env()->context());
+  if (status == 0)
+    static_cast<LibuvStreamWrap*>(req_wrap->stream())->RefreshIdleTimeout();
   req_wrap->Done(status);
 }
 
+#ifndef _WIN32
+SendFileWrap::SendFileWrap(Environment* env,
+                           Local<Object> req_wrap_obj,
+                           LibuvStreamWrap* stream,
+                           int out_fd,
+                           uv_file in_fd,
+                           int64_t offset,
+                           int64_t length)
+    : ReqWrap(env, req_wrap_obj, AsyncWrap::PROVIDER_SENDFILEWRAP),
+      stream_(stream),
+      out_fd_(out_fd),
+      in_fd_(in_fd),
+      offset_(offset),
+      remaining_(length) {
+}
+
+
+SendFileWrap::~SendFileWrap() {
+  uv_fs_t req;
+  uv_fs_close(nullptr, &req, out_fd_, nullptr);
+  uv_fs_req_cleanup(&req);
+}
+
+
+int SendFileWrap::SendChunk() {
+  chunk_ = static_cast<size_t>(std::min<int64_t>(remaining_, INT_MAX));
+  return Dispatch(uv_fs_sendfile,
+                  out_fd_,
+                  in_fd_,
+                  offset_,
+                  chunk_,
+                  AfterSendFile);
+}
+
+
+void SendFileWrap::AfterSendFile(uv_fs_t* req) {
+  SendFileWrap* req_wrap =
+      static_cast<SendFileWrap*>(SendFileWrap::from_req(req));
+  ssize_t result = req->result;
+  uv_fs_req_cleanup(req);
+  req_wrap->Reset();
+
+  if (result > 0) {
+    req_wrap->offset_ += result;
+    req_wrap->remaining_ -= result;
+    req_wrap->bytes_ += result;
+  }
+
+  if (req_wrap->stream_ == nullptr)
+    return req_wrap->Finish(UV_ECANCELED);
+
+  if (result > 0)
+    req_wrap->stream_->RefreshIdleTimeout();
+
+  // A return value of 0 means that the file is shorter than expected.
+  if (req_wrap->remaining_ == 0 || result == 0)
+    return req_wrap->Finish(0);
+
+  if (result < 0 && result != UV_EAGAIN)
+    return req_wrap->Finish(result);
+
+  // A short transfer means that the socket's send buffer is full, so there
+  // is no point in going back to the threadpool until it has drained.
+  if (result == UV_EAGAIN || static_cast<size_t>(result) < req_wrap->chunk_)
+    return req_wrap->WaitWritable();
+
+  int err = req_wrap->SendChunk();
+  if (err != 0)
+    req_wrap->Finish(err);
+}
+
+
+void SendFileWrap::WaitWritable() {
+  int err;
+
+  if (!poll_initialized_) {
+    err = uv_poll_init(env()->event_loop(), &poll_, out_fd_);
+    if (err != 0)
+      return Finish(err);
+    poll_.data = this;
+    poll_initialized_ = true;
+  }
+
+  err = uv_poll_start(&poll_, UV_WRITABLE, OnWritable);
+  if (err != 0)
+    Finish(err);
+}
+
+
+void SendFileWrap::OnWritable(uv_poll_t* handle, int status, int events) {
+  SendFileWrap* req_wrap = static_cast<SendFileWrap*>(handle->data);
+  uv_poll_stop(handle);
+
+  if (status < 0)
+    return req_wrap->Finish(status);
+
+  // Let JS know that the peer is making progress, e.g. to refresh the idle
+  // timer of the socket.
+  Environment* env = req_wrap->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+  Local<Value> argv[] = {
+    Number::New(env->isolate(), static_cast<double>(req_wrap->bytes_))
+  };
+  req_wrap->MakeCallback(env->onprogress_string(), arraysize(argv), argv);
+
+  // The callback may have closed the stream, in which case Abort() takes
+  // care of finishing the request.
+  if (req_wrap->stream_ == nullptr || req_wrap->stream_->IsClosing())
+    return;
+
+  int err = req_wrap->SendChunk();
+  if (err != 0)
+    req_wrap->Finish(err);
+}
+
+
+void SendFileWrap::Abort() {
+  stream_->send_file_ = nullptr;
+  stream_ = nullptr;
+
+  // A running threadpool job notices the abort when it's done.
+  if (req()->data == this)
+    return;
+
+  if (poll_initialized_)
+    uv_poll_stop(&poll_);
+  Finish(UV_ECANCELED);
+}
+
+
+void SendFileWrap::Finish(int status) {
+  status_ = status;
+
+  if (stream_ != nullptr) {
+    stream_->bytes_written_ += bytes_;
+    stream_->send_file_ = nullptr;
+    stream_ = nullptr;
+  }
+
+  if (poll_initialized_)
+    uv_close(reinterpret_cast<uv_handle_t*>(&poll_), OnPollClose);
+  else
+    Complete();
+}
+
+
+void SendFileWrap::OnPollClose(uv_handle_t* handle) {
+  static_cast<SendFileWrap*>(handle->data)->Complete();
+}
+
+
+void SendFileWrap::Complete() {
+  std::unique_ptr<SendFileWrap> self(this);
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+  Local<Value> argv[] = {
+    Integer::New(env()->isolate(), status_),
+    Number::New(env()->isolate(), static_cast<double>(bytes_))
+  };
+  MakeCallback(env()->oncomplete_string(), arraysize(argv), argv);
+}
+#endif  // _WIN32
+
 }  // namespace node
 
 NODE_MODULE_CONTEXT_AWARE_INTERNAL(stream_wrap,
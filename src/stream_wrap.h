@@ -28,11 +28,96 @@
 
 #include "env.h"
 #include "handle_wrap.h"
+#include "req_wrap.h"
 #include "string_bytes.h"
 #include "v8.h"
 
+#include <unordered_set>
+
 namespace node {
 
+class LibuvStreamWrap;
+
+#ifndef _WIN32
+// Copies a byte range of a file to a stream with uv_fs_sendfile(), so that
+// the data never passes through userland.
+//
+// The transfer uses a duplicate of the stream's file descriptor. That lets it
+// wait for writability with a uv_poll_t of its own without touching the
+// stream's I/O watcher, and keeps the descriptor valid while a threadpool
+// job is using it, even if the stream is closed in the meantime.
+class SendFileWrap : public ReqWrap<uv_fs_t> {
+ public:
+  SendFileWrap(Environment* env,
+               v8::Local<v8::Object> req_wrap_obj,
+               LibuvStreamWrap* stream,
+               int out_fd,
+               uv_file in_fd,
+               int64_t offset,
+               int64_t length);
+  ~SendFileWrap() override;
+
+  int SendChunk();
+  // Called when the stream is closed while the transfer is still running.
+  void Abort();
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackThis(this);
+  }
+
+  ADD_MEMORY_INFO_NAME(SendFileWrap)
+
+ private:
+  void WaitWritable();
+  void Finish(int status);
+  void Complete();
+
+  static void AfterSendFile(uv_fs_t* req);
+  static void OnWritable(uv_poll_t* handle, int status, int events);
+  static void OnPollClose(uv_handle_t* handle);
+
+  LibuvStreamWrap* stream_;
+  uv_poll_t poll_;
+  bool poll_initialized_ = false;
+  int out_fd_;
+  uv_file in_fd_;
+  int64_t offset_;
+  int64_t remaining_;
+  size_t chunk_ = 0;
+  uint64_t bytes_ = 0;
+  int status_ = 0;
+};
+#endif  // _WIN32
+
+// Keeps track of the streams of an Environment that have an idle timeout,
+// see LibuvStreamWrap::SetIdleTimeout(). Reads and writes only store the loop
+// time on the stream. A single unref'd timer sweeps the streams at the
+// earliest deadline and calls `ontimeout` on those that have been idle for
+// too long. To keep the number of sweeps down when the deadlines keep moving,
+// a sweep is never scheduled sooner than 1/kSweepSlack of the shortest
+// timeout after the previous one, so a timeout can fire that much late.
+class StreamIdleTimeouts {
+ public:
+  static constexpr uint64_t kSweepSlack = 8;
+
+  static StreamIdleTimeouts* Get(Environment* env);
+
+  void Add(LibuvStreamWrap* stream);
+  void Remove(LibuvStreamWrap* stream);
+
+ private:
+  explicit StreamIdleTimeouts(Environment* env);
+
+  void Schedule(uint64_t deadline);
+  void Sweep();
+  static void OnTimer(uv_timer_t* handle);
+
+  Environment* const env_;
+  uv_timer_t timer_;
+  uint64_t deadline_ = 0;  // When the timer fires, 0 if it isn't running.
+  std::unordered_set<LibuvStreamWrap*> streams_;
+};
+
 class LibuvStreamWrap : public HandleWrap, public StreamBase {
  public:
   static void Initialize(v8::Local<v8::Object> target,
@@ -76,6 +161,10 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
   ShutdownWrap* CreateShutdownWrap(v8::Local<v8::Object> object) override;
   WriteWrap* CreateWriteWrap(v8::Local<v8::Object> object) override;
 
+  // Restarts the idle timeout, if there is one. Called on every read and
+  // write.
+  void RefreshIdleTimeout();
+
  protected:
   LibuvStreamWrap(Environment* env,
                   v8::Local<v8::Object> object,
@@ -87,6 +176,8 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
   static void AddMethods(Environment* env,
                          v8::Local<v8::FunctionTemplate> target);
 
+  void OnClose() override;
+
  protected:
   inline void set_fd(int fd) {
 #ifdef _WIN32
@@ -99,6 +190,12 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
   static void GetWriteQueueSize(
       const v8::FunctionCallbackInfo<v8::Value>& info);
   static void SetBlocking(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetIdleTimeout(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetIdleTimeout(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetIdleSince(const v8::FunctionCallbackInfo<v8::Value>& args);
+#ifndef _WIN32
+  static void SendFile(const v8::FunctionCallbackInfo<v8::Value>& args);
+#endif
 
   // Callbacks for libuv
   void OnUvAlloc(size_t suggested_size, uv_buf_t* buf);
@@ -107,8 +204,26 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
   static void AfterUvWrite(uv_write_t* req, int status);
   static void AfterUvShutdown(uv_shutdown_t* req, int status);
 
+  void DisarmIdleTimeout();
+  void OnIdleTimeout();
+
   uv_stream_t* const stream_;
 
+  friend class StreamIdleTimeouts;
+  uint64_t idle_timeout_ = 0;  // In milliseconds, 0 if there is none.
+  uint64_t idle_since_ = 0;  // Loop time of the last read or write.
+  // Whether the stream is registered with StreamIdleTimeouts. It is not after
+  // the timeout has fired, until the next read or write.
+  bool idle_timeout_armed_ = false;
+
+#ifndef _WIN32
+  friend class SendFileWrap;
+  SendFileWrap* send_file_ = nullptr;
+#endif
+
+  // Splices data between the file descriptors of two streams.
+  friend class StreamPipe;
+
 #ifdef _WIN32
   // We don't always have an FD that we could look up on the stream_
   // object itself on Windows. However, for some cases, we open handles
@@ -125,6 +125,8 @@ void TCPWrap::Initialize(Local<Object> target,
   Local<Object> constants = Object::New(env->isolate());
   NODE_DEFINE_CONSTANT(constants, SOCKET);
   NODE_DEFINE_CONSTANT(constants, SERVER);
+  NODE_DEFINE_CONSTANT(constants, UV_TCP_IPV6ONLY);
+  NODE_DEFINE_CONSTANT(constants, UV_TCP_REUSEPORT);
   target->Set(context,
               FIXED_ONE_BYTE_STRING(env->isolate(), "constants"),
               constants).FromJust();
@@ -231,12 +233,15 @@ void TCPWrap::Bind(const FunctionCallbackInfo<Value>& args) {
   node::Utf8Value ip_address(env->isolate(), args[0]);
   int port;
   if (!args[1]->Int32Value(env->context()).To(&port)) return;
+  // Optional UV_TCP_* flags, undefined means 0.
+  uint32_t flags;
+  if (!args[2]->Uint32Value(env->context()).To(&flags)) return;
   sockaddr_in addr;
   int err = uv_ip4_addr(*ip_address, port, &addr);
   if (err == 0) {
     err = uv_tcp_bind(&wrap->handle_,
                       reinterpret_cast<const sockaddr*>(&addr),
-                      0);
+                      flags);
   }
   args.GetReturnValue().Set(err);
 }
@@ -251,12 +256,14 @@ void TCPWrap::Bind6(const FunctionCallbackInfo<Value>& args) {
   node::Utf8Value ip6_address(env->isolate(), args[0]);
   int port;
   if (!args[1]->Int32Value(env->context()).To(&port)) return;
+  uint32_t flags;
+  if (!args[2]->Uint32Value(env->context()).To(&flags)) return;
   sockaddr_in6 addr;
   int err = uv_ip6_addr(*ip6_address, port, &addr);
   if (err == 0) {
     err = uv_tcp_bind(&wrap->handle_,
                       reinterpret_cast<const sockaddr*>(&addr),
-                      0);
+                      flags);
   }
   args.GetReturnValue().Set(err);
 }
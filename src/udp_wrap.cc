@@ -23,6 +23,7 @@
 #include "env-inl.h"
 #include "node_buffer.h"
 #include "node_internals.h"
+#include "read_buffer_pool.h"
 #include "handle_wrap.h"
 #include "req_wrap-inl.h"
 #include "util-inl.h"
@@ -38,6 +39,7 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
 using v8::Object;
 using v8::PropertyAttribute;
@@ -55,6 +57,11 @@ class SendWrap : public ReqWrap<uv_udp_send_t> {
   SendWrap(Environment* env, Local<Object> req_wrap_obj, bool have_callback);
   inline bool have_callback() const;
   size_t msg_size;
+  // For a batch send, the requests of all datagrams but the last, which uses
+  // the ReqWrap's own request. libuv completes them in order, so the batch is
+  // done when the last one is.
+  std::unique_ptr<uv_udp_send_t[]> batch_reqs;
+  int batch_status = 0;
 
   void MemoryInfo(MemoryTracker* tracker) const override {
     tracker->TrackThis(this);
@@ -85,7 +92,11 @@ UDPWrap::UDPWrap(Environment* env, Local<Object> object)
                  object,
                  reinterpret_cast<uv_handle_t*>(&handle_),
                  AsyncWrap::PROVIDER_UDPWRAP) {
-  int r = uv_udp_init(env->event_loop(), &handle_);
+  // libuv only reads with recvmmsg() when OnAlloc() returns room for more
+  // than one datagram, which it does in batch mode only.
+  int r = uv_udp_init_ex(env->event_loop(),
+                         &handle_,
+                         AF_UNSPEC | UV_UDP_RECVMMSG);
   CHECK_EQ(r, 0);  // can't fail anyway
 }
 
@@ -122,6 +133,8 @@ void UDPWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "send", Send);
   env->SetProtoMethod(t, "bind6", Bind6);
   env->SetProtoMethod(t, "send6", Send6);
+  env->SetProtoMethod(t, "sendBatch", SendBatch);
+  env->SetProtoMethod(t, "sendBatch6", SendBatch6);
   env->SetProtoMethod(t, "recvStart", RecvStart);
   env->SetProtoMethod(t, "recvStop", RecvStop);
   env->SetProtoMethod(t, "getsockname",
@@ -429,11 +442,139 @@ void UDPWrap::Send6(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Returns the number of datagrams that are still in flight and will be
+// reported through oncomplete, 0 if all of them went out synchronously, or
+// an error code.
+void UDPWrap::DoSendBatch(const FunctionCallbackInfo<Value>& args,
+                          int family) {
+  Environment* env = Environment::GetCurrent(args);
+
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  // sendBatch(req, list, list.length, port, address, hasCallback)
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsArray());
+  CHECK(args[2]->IsUint32());
+  CHECK(args[3]->IsUint32());
+  CHECK(args[4]->IsString());
+  CHECK(args[5]->IsBoolean());
+
+  Local<Object> req_wrap_obj = args[0].As<Object>();
+  Local<Array> chunks = args[1].As<Array>();
+  size_t count = args[2].As<Uint32>()->Value();
+  const unsigned short port = args[3].As<Uint32>()->Value();
+  node::Utf8Value address(env->isolate(), args[4]);
+  const bool have_callback = args[5]->IsTrue();
+  CHECK_GT(count, 0);
+
+  char addr[sizeof(sockaddr_in6)];
+  int err;
+
+  switch (family) {
+  case AF_INET:
+    err = uv_ip4_addr(*address, port, reinterpret_cast<sockaddr_in*>(&addr));
+    break;
+  case AF_INET6:
+    err = uv_ip6_addr(*address, port, reinterpret_cast<sockaddr_in6*>(&addr));
+    break;
+  default:
+    CHECK(0 && "unexpected address family");
+    ABORT();
+  }
+
+  if (err)
+    return args.GetReturnValue().Set(err);
+
+  // Unlike send(), every element of the list is a datagram of its own.
+  MaybeStackBuffer<uv_buf_t, 16> bufs(count);
+  MaybeStackBuffer<uv_buf_t*, 16> buf_ptrs(count);
+  MaybeStackBuffer<unsigned int, 16> nbufs(count);
+  MaybeStackBuffer<sockaddr*, 16> addrs(count);
+  size_t msg_size = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    Local<Value> chunk = chunks->Get(i);
+
+    size_t length = Buffer::Length(chunk);
+
+    bufs[i] = uv_buf_init(Buffer::Data(chunk), length);
+    buf_ptrs[i] = &bufs[i];
+    nbufs[i] = 1;
+    addrs[i] = reinterpret_cast<sockaddr*>(&addr);
+    msg_size += length;
+  }
+
+  // Hand as much as possible to the kernel straight away, which is a single
+  // sendmmsg() call on Linux. Errors are ignored here: the datagram that
+  // failed is queued below along with the rest and reports the error
+  // through oncomplete, the way it would have with send().
+  size_t sent = 0;
+  err = uv_udp_try_send2(&wrap->handle_, count, *buf_ptrs, *nbufs, *addrs, 0);
+  if (err > 0)
+    sent = err;
+
+  if (sent == count)
+    return args.GetReturnValue().Set(0);
+
+  SendWrap* req_wrap;
+  {
+    AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(wrap);
+    req_wrap = new SendWrap(env, req_wrap_obj, have_callback);
+  }
+  req_wrap->msg_size = msg_size;
+
+  size_t last = count - 1;
+  if (last > sent)
+    req_wrap->batch_reqs.reset(new uv_udp_send_t[last - sent]);
+
+  for (size_t i = sent; i <= last; i++) {
+    if (i < last) {
+      uv_udp_send_t* req = &req_wrap->batch_reqs[i - sent];
+      req->data = req_wrap;
+      err = uv_udp_send(req, &wrap->handle_, &bufs[i], 1, addrs[i],
+                        OnSendBatchPart);
+    } else {
+      err = req_wrap->Dispatch(uv_udp_send,
+                               &wrap->handle_,
+                               &bufs[i],
+                               1,
+                               addrs[i],
+                               OnSend);
+    }
+
+    if (err) {
+      // Only the first request can fail. By the time it has been queued the
+      // handle is bound and none of the others needs more than one buffer.
+      CHECK_EQ(i, sent);
+      delete req_wrap;
+      return args.GetReturnValue().Set(err);
+    }
+  }
+
+  args.GetReturnValue().Set(static_cast<uint32_t>(count - sent));
+}
+
+
+void UDPWrap::SendBatch(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET);
+}
+
+
+void UDPWrap::SendBatch6(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET6);
+}
+
+
 void UDPWrap::RecvStart(const FunctionCallbackInfo<Value>& args) {
   UDPWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap,
                           args.Holder(),
                           args.GetReturnValue().Set(UV_EBADF));
+  // recvStart(batch)
+  wrap->recv_batch_ = args[0]->IsTrue();
   int err = uv_udp_recv_start(&wrap->handle_, OnAlloc, OnRecv);
   // UV_EALREADY means that the socket is already bound but that's okay
   if (err == UV_EALREADY)
@@ -454,6 +595,9 @@ void UDPWrap::RecvStop(const FunctionCallbackInfo<Value>& args) {
 
 void UDPWrap::OnSend(uv_udp_send_t* req, int status) {
   SendWrap* req_wrap = static_cast<SendWrap*>(req->data);
+  // A batch reports the first of its datagrams that failed.
+  if (req_wrap->batch_status != 0)
+    status = req_wrap->batch_status;
   if (req_wrap->have_callback()) {
     Environment* env = req_wrap->env();
     HandleScope handle_scope(env->isolate());
@@ -468,11 +612,71 @@ void UDPWrap::OnSend(uv_udp_send_t* req, int status) {
 }
 
 
+void UDPWrap::OnSendBatchPart(uv_udp_send_t* req, int status) {
+  SendWrap* req_wrap = static_cast<SendWrap*>(req->data);
+  if (status < 0 && req_wrap->batch_status == 0)
+    req_wrap->batch_status = status;
+}
+
+
 void UDPWrap::OnAlloc(uv_handle_t* handle,
                       size_t suggested_size,
                       uv_buf_t* buf) {
-  buf->base = node::Malloc(suggested_size);
-  buf->len = suggested_size;
+  UDPWrap* wrap = static_cast<UDPWrap*>(handle->data);
+
+  // The batch buffer is only ever used by one read at a time: FlushBatch()
+  // copies the datagrams out before libuv asks for a buffer again.
+  if (wrap->recv_batch_) {
+    if (wrap->batch_buf_.is_empty()) {
+      wrap->batch_buf_ =
+          MallocedBuffer<char>(kRecvBatchSize * suggested_size);
+    }
+    buf->base = wrap->batch_buf_.data;
+    buf->len = wrap->batch_buf_.size;
+    return;
+  }
+
+  *buf = ReadBufferPool::Get(wrap->env())->Allocate(suggested_size);
+}
+
+
+void UDPWrap::FlushBatch() {
+  if (batch_.empty())
+    return;
+
+  Isolate* isolate = env()->isolate();
+  HandleScope handle_scope(isolate);
+  Local<Context> context = env()->context();
+  Context::Scope context_scope(context);
+
+  size_t total = 0;
+  for (const BatchedMessage& msg : batch_)
+    total += msg.length;
+
+  // The next read reuses batch_buf_, so the datagrams are copied into a
+  // single buffer that JS slices up again.
+  char* data = node::Malloc(total);
+  Local<Array> sizes = Array::New(isolate, batch_.size());
+  Local<Array> rinfos = Array::New(isolate, batch_.size());
+  size_t offset = 0;
+
+  for (size_t i = 0; i < batch_.size(); i++) {
+    const BatchedMessage& msg = batch_[i];
+    memcpy(data + offset, msg.data, msg.length);
+    offset += msg.length;
+    sizes->Set(context, i, Integer::New(isolate, msg.length)).FromJust();
+    rinfos->Set(context, i, AddressToJS(env(),
+        reinterpret_cast<const sockaddr*>(&msg.addr))).FromJust();
+  }
+  batch_.clear();
+
+  Local<Value> argv[] = {
+    object(),
+    Buffer::New(env(), data, total).ToLocalChecked(),
+    sizes,
+    rinfos
+  };
+  MakeCallback(env()->onmessagebatch_string(), arraysize(argv), argv);
 }
 
 
@@ -481,13 +685,37 @@ void UDPWrap::OnRecv(uv_udp_t* handle,
                      const uv_buf_t* buf,
                      const struct sockaddr* addr,
                      unsigned int flags) {
+  UDPWrap* wrap = static_cast<UDPWrap*>(handle->data);
+  const MallocedBuffer<char>& batch_buf = wrap->batch_buf_;
+  const bool batched = !batch_buf.is_empty() &&
+                       buf->base >= batch_buf.data &&
+                       buf->base < batch_buf.data + batch_buf.size;
+
   if (nread == 0 && addr == nullptr) {
-    if (buf->base != nullptr)
-      free(buf->base);
+    // With recvmmsg(), this is the end of the batch.
+    if (batched)
+      wrap->FlushBatch();
+    else
+      ReadBufferPool::Get(wrap->env())->Release(*buf);
+    return;
+  }
+
+  if (batched && nread >= 0) {
+    BatchedMessage msg;
+    msg.data = buf->base;
+    msg.length = nread;
+    memcpy(&msg.addr,
+           addr,
+           addr->sa_family == AF_INET6 ? sizeof(sockaddr_in6) :
+                                         sizeof(sockaddr_in));
+    wrap->batch_.push_back(msg);
+    // Without recvmmsg(), datagrams arrive one at a time and there is no
+    // end-of-batch call to wait for.
+    if (!(flags & UV_UDP_MMSG_CHUNK))
+      wrap->FlushBatch();
     return;
   }
 
-  UDPWrap* wrap = static_cast<UDPWrap*>(handle->data);
   Environment* env = wrap->env();
 
   HandleScope handle_scope(env->isolate());
@@ -501,15 +729,21 @@ void UDPWrap::OnRecv(uv_udp_t* handle,
     Undefined(env->isolate())
   };
 
+  ReadBufferPool* pool = ReadBufferPool::Get(env);
   if (nread < 0) {
-    if (buf->base != nullptr)
-      free(buf->base);
+    if (!batched)
+      pool->Release(*buf);
     wrap->MakeCallback(env->onmessage_string(), arraysize(argv), argv);
     return;
   }
 
-  char* base = node::UncheckedRealloc(buf->base, nread);
-  argv[2] = Buffer::New(env, base, nread).ToLocalChecked();
+  if (nread == 0) {
+    // An empty datagram still gets a (zero-length) Buffer.
+    pool->Release(*buf);
+    argv[2] = Buffer::New(env, 0).ToLocalChecked();
+  } else {
+    argv[2] = pool->Commit(*buf, nread);
+  }
   argv[3] = AddressToJS(env, addr);
   wrap->MakeCallback(env->onmessage_string(), arraysize(argv), argv);
 }
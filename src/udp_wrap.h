@@ -27,9 +27,12 @@
 #include "async_wrap.h"
 #include "env.h"
 #include "handle_wrap.h"
+#include "util.h"
 #include "uv.h"
 #include "v8.h"
 
+#include <vector>
+
 namespace node {
 
 class UDPWrap: public HandleWrap {
@@ -47,6 +50,8 @@ class UDPWrap: public HandleWrap {
   static void Send(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Bind6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Send6(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SendBatch(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SendBatch6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RecvStart(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RecvStop(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void AddMembership(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -67,6 +72,8 @@ class UDPWrap: public HandleWrap {
 
   void MemoryInfo(MemoryTracker* tracker) const override {
     tracker->TrackThis(this);
+    if (!batch_buf_.is_empty())
+      tracker->TrackFieldWithSize("batch_buf", batch_buf_.size);
   }
 
   ADD_MEMORY_INFO_NAME(UDPWrap)
@@ -78,12 +85,28 @@ class UDPWrap: public HandleWrap {
             int (*F)(const typename T::HandleType*, sockaddr*, int*)>
   friend void GetSockOrPeerName(const v8::FunctionCallbackInfo<v8::Value>&);
 
+  // Number of datagrams that a batched read can pick up at once. libuv asks
+  // for 64 KiB per datagram, so this sizes the receive buffer at 1 MiB.
+  static constexpr size_t kRecvBatchSize = 16;
+
+  // A datagram of the batch that is being read. |data| points into
+  // batch_buf_, which stays untouched until libuv hands the buffer back.
+  struct BatchedMessage {
+    const char* data;
+    size_t length;
+    sockaddr_storage addr;
+  };
+
   UDPWrap(Environment* env, v8::Local<v8::Object> object);
 
+  void FlushBatch();
+
   static void DoBind(const v8::FunctionCallbackInfo<v8::Value>& args,
                      int family);
   static void DoSend(const v8::FunctionCallbackInfo<v8::Value>& args,
                      int family);
+  static void DoSendBatch(const v8::FunctionCallbackInfo<v8::Value>& args,
+                          int family);
   static void SetMembership(const v8::FunctionCallbackInfo<v8::Value>& args,
                             uv_membership membership);
 
@@ -91,6 +114,7 @@ class UDPWrap: public HandleWrap {
                       size_t suggested_size,
                       uv_buf_t* buf);
   static void OnSend(uv_udp_send_t* req, int status);
+  static void OnSendBatchPart(uv_udp_send_t* req, int status);
   static void OnRecv(uv_udp_t* handle,
                      ssize_t nread,
                      const uv_buf_t* buf,
@@ -98,6 +122,9 @@ class UDPWrap: public HandleWrap {
                      unsigned int flags);
 
   uv_udp_t handle_;
+  bool recv_batch_ = false;
+  MallocedBuffer<char> batch_buf_;
+  std::vector<BatchedMessage> batch_;
 };
 
 }  // namespace node
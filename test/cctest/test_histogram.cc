@@ -0,0 +1,74 @@
+#include "histogram-inl.h"
+
+#include <stdint.h>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using node::Histogram;
+
+TEST(HistogramTest, Simple) {
+  Histogram histogram(1000000);
+  EXPECT_EQ(histogram.Count(), 0);
+  EXPECT_EQ(histogram.Min(), 0);
+  EXPECT_EQ(histogram.Max(), 0);
+  EXPECT_TRUE(std::isnan(histogram.Mean()));
+  EXPECT_EQ(histogram.Percentile(50), 0);
+
+  EXPECT_TRUE(histogram.Record(1));
+  EXPECT_TRUE(histogram.Record(2));
+  EXPECT_TRUE(histogram.Record(3));
+  EXPECT_EQ(histogram.Count(), 3);
+  EXPECT_EQ(histogram.Min(), 1);
+  EXPECT_EQ(histogram.Max(), 3);
+  EXPECT_EQ(histogram.Mean(), 2);
+  EXPECT_NEAR(histogram.Stddev(), std::sqrt(2.0 / 3), 1e-9);
+  EXPECT_EQ(histogram.Percentile(50), 2);
+  EXPECT_EQ(histogram.Percentile(100), 3);
+
+  EXPECT_FALSE(histogram.Record(-1));
+  EXPECT_FALSE(histogram.Record(1000001));
+  EXPECT_EQ(histogram.Exceeds(), 1);
+  EXPECT_EQ(histogram.Count(), 3);
+
+  histogram.Reset();
+  EXPECT_EQ(histogram.Count(), 0);
+  EXPECT_EQ(histogram.Exceeds(), 0);
+  EXPECT_EQ(histogram.Max(), 0);
+}
+
+TEST(HistogramTest, Precision) {
+  const int64_t highest = int64_t{1} << 42;
+  for (int64_t value = 1; value < highest; value += value / 3 + 1) {
+    Histogram histogram(highest);
+    histogram.Record(value);
+    histogram.Record(value);
+    histogram.Record(highest);
+    int64_t median = histogram.Percentile(50);
+    EXPECT_GE(median, value);
+    EXPECT_LE(median - value, value * 2 / Histogram::kSubBuckets);
+  }
+}
+
+TEST(HistogramTest, Percentiles) {
+  Histogram histogram(1000000);
+  for (int64_t i = 1; i <= 1000; i++)
+    histogram.Record(i * 1000);
+
+  std::vector<std::pair<double, int64_t>> percentiles;
+  histogram.Percentiles([&](double percentile, int64_t value) {
+    percentiles.emplace_back(percentile, value);
+  });
+  ASSERT_GE(percentiles.size(), 3u);
+  EXPECT_EQ(percentiles.front().first, 0);
+  EXPECT_EQ(percentiles.front().second, 1000);
+  EXPECT_EQ(percentiles[1].first, 50);
+  EXPECT_EQ(percentiles.back().first, 100);
+  EXPECT_EQ(percentiles.back().second, 1000000);
+  for (size_t i = 1; i < percentiles.size(); i++) {
+    EXPECT_GT(percentiles[i].first, percentiles[i - 1].first);
+    EXPECT_GE(percentiles[i].second, percentiles[i - 1].second);
+  }
+}
@@ -0,0 +1,86 @@
+#include "node_http2.h"
+
+#include "gtest/gtest.h"
+
+#include <string.h>
+
+using node::http2::Http2Arena;
+
+TEST(Http2ArenaTest, ServesSmallAllocations) {
+  Http2Arena arena;
+  EXPECT_EQ(arena.slab_bytes(), 0u);
+
+  void* small = arena.Allocate(1);
+  ASSERT_NE(small, nullptr);
+  EXPECT_TRUE(Http2Arena::Owns(small));
+  EXPECT_GE(Http2Arena::Capacity(small), 1u);
+  EXPECT_GT(Http2Arena::BlockSize(small), Http2Arena::Capacity(small));
+  EXPECT_FALSE(Http2Arena::IsDetached(small));
+  EXPECT_GT(arena.slab_bytes(), 0u);
+
+  void* large = arena.Allocate(1000);
+  ASSERT_NE(large, nullptr);
+  EXPECT_GE(Http2Arena::Capacity(large), 1000u);
+
+  // Anything beyond the largest size class is left to malloc().
+  EXPECT_EQ(arena.Allocate(64 * 1024), nullptr);
+
+  arena.Free(small);
+  arena.Free(large);
+}
+
+TEST(Http2ArenaTest, ReusesFreedBlocks) {
+  Http2Arena arena;
+  void* first = arena.Allocate(40);
+  ASSERT_NE(first, nullptr);
+  arena.Free(first);
+
+  void* second = arena.Allocate(40);
+  EXPECT_EQ(first, second);
+  arena.Free(second);
+}
+
+TEST(Http2ArenaTest, ReusesDetachedBlocks) {
+  Http2Arena arena;
+  void* ptr = arena.Allocate(100);
+  ASSERT_NE(ptr, nullptr);
+  const size_t slab_bytes = arena.slab_bytes();
+
+  // Blocks that are detached and freed while the arena is alive go back to
+  // it, so the arena doesn't grow no matter how often that happens.
+  for (int i = 0; i < 1000; i++) {
+    Http2Arena::Detach(ptr);
+    EXPECT_TRUE(Http2Arena::IsDetached(ptr));
+    Http2Arena::FreeDetached(ptr);
+
+    void* next = arena.Allocate(100);
+    EXPECT_EQ(next, ptr);
+    EXPECT_FALSE(Http2Arena::IsDetached(next));
+    ptr = next;
+  }
+  EXPECT_EQ(arena.slab_bytes(), slab_bytes);
+
+  arena.Free(ptr);
+}
+
+TEST(Http2ArenaTest, ReleasesOrphanedSlabs) {
+  void* detached;
+  void* kept;
+  {
+    Http2Arena arena;
+    detached = arena.Allocate(200);
+    kept = arena.Allocate(200);
+    ASSERT_NE(detached, nullptr);
+    ASSERT_NE(kept, nullptr);
+    Http2Arena::Detach(detached);
+    Http2Arena::Detach(kept);
+    arena.Free(arena.Allocate(10));
+  }
+
+  // Both blocks share a slab that outlives the arena, and that is released
+  // once the last of them has been freed.
+  memset(detached, 0xab, Http2Arena::Capacity(detached));
+  Http2Arena::FreeDetached(detached);
+  memset(kept, 0xcd, Http2Arena::Capacity(kept));
+  Http2Arena::FreeDetached(kept);
+}
@@ -0,0 +1,54 @@
+#include "http_header_names.h"
+#include "env-inl.h"
+#include "node_internals.h"
+
+#include "gtest/gtest.h"
+#include "node_test_fixture.h"
+
+#include <string.h>
+
+using node::HTTPHeaderNames;
+using v8::Local;
+using v8::String;
+
+class HTTPHeaderNamesTest : public EnvironmentTestFixture {};
+
+static int Lookup(const char* name) {
+  return HTTPHeaderNames::Lookup(name, strlen(name));
+}
+
+TEST_F(HTTPHeaderNamesTest, LookupIgnoresCase) {
+  EXPECT_NE(Lookup("content-type"), HTTPHeaderNames::kUnknown);
+  EXPECT_EQ(Lookup("content-type"), Lookup("Content-Type"));
+  EXPECT_EQ(Lookup("content-type"), Lookup("CONTENT-TYPE"));
+  EXPECT_EQ(Lookup("www-authenticate"), Lookup("WWW-Authenticate"));
+  EXPECT_NE(Lookup("host"), Lookup("content-type"));
+
+  EXPECT_EQ(Lookup(""), HTTPHeaderNames::kUnknown);
+  EXPECT_EQ(Lookup("content-typ"), HTTPHeaderNames::kUnknown);
+  EXPECT_EQ(Lookup("content-typf"), HTTPHeaderNames::kUnknown);
+  EXPECT_EQ(Lookup("x-custom-header"), HTTPHeaderNames::kUnknown);
+  EXPECT_EQ(HTTPHeaderNames::Lookup("host\0", 5), HTTPHeaderNames::kUnknown);
+}
+
+TEST_F(HTTPHeaderNamesTest, KnownSpellingsAreShared) {
+  const v8::HandleScope handle_scope(isolate_);
+  const Argv argv;
+  Env env {handle_scope, argv};
+  HTTPHeaderNames* names = HTTPHeaderNames::Get(*env);
+  EXPECT_EQ(names, HTTPHeaderNames::Get(*env));
+
+  // The lowercase and canonical spellings are the same string every time.
+  Local<String> lower = names->ToString("user-agent", 10);
+  Local<String> canonical = names->ToString("User-Agent", 10);
+  EXPECT_TRUE(lower == names->ToString("user-agent", 10));
+  EXPECT_TRUE(canonical == names->ToString("User-Agent", 10));
+  EXPECT_FALSE(lower == canonical);
+
+  // Other spellings and names are passed through unchanged.
+  String::Utf8Value shouting(isolate_, names->ToString("USER-AGENT", 10));
+  EXPECT_STREQ(*shouting, "USER-AGENT");
+  String::Utf8Value custom(isolate_, names->ToString("X-Custom", 8));
+  EXPECT_STREQ(*custom, "X-Custom");
+  EXPECT_EQ(names->ToString("", 0)->Length(), 0);
+}
@@ -53,3 +53,54 @@ TEST_F(PlatformTest, SkipNewTasksInFlushForegroundTasks) {
   EXPECT_EQ(3, run_count);
   EXPECT_FALSE(platform->FlushForegroundTasks(isolate_));
 }
+
+// Records the deadline that it was run with.
+class DeadlineIdleTask : public v8::IdleTask {
+ public:
+  DeadlineIdleTask(double* deadline, double* ran_at)
+      : deadline_(deadline), ran_at_(ran_at) {}
+
+  // v8::IdleTask implementation
+  void Run(double deadline_in_seconds) final {
+    *deadline_ = deadline_in_seconds;
+    *ran_at_ = uv_hrtime() / 1e9;
+  }
+
+ private:
+  double* deadline_;
+  double* ran_at_;
+};
+
+TEST_F(PlatformTest, RunIdleTasksUntilNextTimer) {
+  v8::Isolate::Scope isolate_scope(isolate_);
+  const v8::HandleScope handle_scope(isolate_);
+  const Argv argv;
+  Env env {handle_scope, argv};
+  EXPECT_FALSE(platform->IdleTasksEnabled(isolate_));
+  platform->SetIdleTasksEnabled(isolate_, true);
+  EXPECT_TRUE(platform->IdleTasksEnabled(isolate_));
+
+  double deadline = 0;
+  double ran_at = 0;
+  platform->CallIdleOnForegroundThread(
+      isolate_, new DeadlineIdleTask(&deadline, &ran_at));
+
+  // The task runs when the loop is about to wait for the timer, and has to
+  // be done by the time the timer is due.
+  bool fired = false;
+  uv_timer_t timer;
+  uv_timer_init(&current_loop, &timer);
+  timer.data = &fired;
+  uv_timer_start(&timer, [](uv_timer_t* handle) {
+    *static_cast<bool*>(handle->data) = true;
+  }, 20, 0);
+  while (!fired)
+    uv_run(&current_loop, UV_RUN_ONCE);
+  uv_close(reinterpret_cast<uv_handle_t*>(&timer), nullptr);
+  uv_run(&current_loop, UV_RUN_NOWAIT);
+
+  EXPECT_GT(ran_at, 0);
+  EXPECT_GT(deadline, ran_at);
+  EXPECT_LE(deadline - ran_at, 0.02);
+  platform->SetIdleTasksEnabled(isolate_, false);
+}
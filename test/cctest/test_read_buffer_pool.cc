@@ -0,0 +1,94 @@
+#include "read_buffer_pool.h"
+#include "env-inl.h"
+#include "node_buffer.h"
+#include "node_internals.h"
+
+#include "gtest/gtest.h"
+#include "node_test_fixture.h"
+
+using node::ReadBufferPool;
+using v8::Local;
+using v8::Object;
+
+class ReadBufferPoolTest : public EnvironmentTestFixture {};
+
+TEST_F(ReadBufferPoolTest, PacksConsecutiveReads) {
+  const v8::HandleScope handle_scope(isolate_);
+  const Argv argv;
+  Env env {handle_scope, argv};
+  ReadBufferPool* pool = ReadBufferPool::Get(*env);
+  EXPECT_EQ(pool, ReadBufferPool::Get(*env));
+
+  uv_buf_t first = pool->Allocate(65536);
+  EXPECT_EQ(first.len, 65536u);
+  Local<Object> first_obj = pool->Commit(first, 100);
+  EXPECT_EQ(node::Buffer::Data(first_obj), first.base);
+  EXPECT_EQ(node::Buffer::Length(first_obj), 100u);
+
+  // The unused tail of the first reservation has been given back, and the
+  // next one starts at the next 8-byte boundary.
+  uv_buf_t second = pool->Allocate(65536);
+  EXPECT_EQ(second.base, first.base + 104);
+  Local<Object> second_obj = pool->Commit(second, 1);
+  EXPECT_EQ(node::Buffer::Length(second_obj), 1u);
+  EXPECT_TRUE(first_obj.As<v8::Uint8Array>()->Buffer()->StrictEquals(
+      second_obj.As<v8::Uint8Array>()->Buffer()));
+
+  // A released reservation is handed out again.
+  uv_buf_t third = pool->Allocate(65536);
+  pool->Release(third);
+  uv_buf_t fourth = pool->Allocate(65536);
+  EXPECT_EQ(third.base, fourth.base);
+  pool->Release(fourth);
+}
+
+TEST_F(ReadBufferPoolTest, LargeReadsAreNotPooled) {
+  const v8::HandleScope handle_scope(isolate_);
+  const Argv argv;
+  Env env {handle_scope, argv};
+  ReadBufferPool* pool = ReadBufferPool::Get(*env);
+
+  uv_buf_t small = pool->Allocate(16);
+  uv_buf_t large = pool->Allocate(ReadBufferPool::kMaxPooledSize + 1);
+  EXPECT_TRUE(large.base < small.base ||
+              large.base >= small.base + ReadBufferPool::kSlabSize);
+  Local<Object> obj = pool->Commit(large, 10);
+  EXPECT_EQ(node::Buffer::Length(obj), 10u);
+  pool->Release(small);
+}
+
+TEST_F(ReadBufferPoolTest, PendingReservationsOutliveTheirSlab) {
+  const v8::HandleScope handle_scope(isolate_);
+  const Argv argv;
+  Env env {handle_scope, argv};
+  ReadBufferPool* pool = ReadBufferPool::Get(*env);
+
+  // Keep one reservation outstanding while the slab fills up and a new one
+  // is started.
+  uv_buf_t pending = pool->Allocate(65536);
+  const size_t reads = ReadBufferPool::kSlabSize / 65536;
+  for (size_t i = 0; i < reads; i++) {
+    uv_buf_t buf = pool->Allocate(65536);
+    pool->Commit(buf, 65536);
+  }
+
+  pending.base[0] = 'x';
+  Local<Object> obj = pool->Commit(pending, 1);
+  EXPECT_EQ(node::Buffer::Data(obj), pending.base);
+  EXPECT_EQ(node::Buffer::Data(obj)[0], 'x');
+}
+
+TEST_F(ReadBufferPoolTest, SlabsAreNotHandedToV8) {
+  const v8::HandleScope handle_scope(isolate_);
+  const Argv argv;
+  Env env {handle_scope, argv};
+  ReadBufferPool* pool = ReadBufferPool::Get(*env);
+
+  // Transferring the ArrayBuffer must not take the slab's memory away from
+  // the pool, which keeps reading into it.
+  uv_buf_t buf = pool->Allocate(65536);
+  Local<Object> obj = pool->Commit(buf, 100);
+  Local<v8::ArrayBuffer> ab = obj.As<v8::Uint8Array>()->Buffer();
+  EXPECT_TRUE(ab->IsExternal());
+  EXPECT_EQ(ab->ByteLength(), ReadBufferPool::kSlabSize);
+}
@@ -0,0 +1,44 @@
+'use strict';
+const common = require('../common');
+
+// Tests that requests are parsed the same with --http-parser=simd.
+
+const assert = require('assert');
+const http = require('http');
+const { spawnSync } = require('child_process');
+
+const path = `/${'a/b-c_d.e'.repeat(20)}?q=${'x%20y?z'.repeat(20)}`;
+const headers = {
+  'x-a-long-header-name-with-dashes-1234567890': 'v'.repeat(100),
+  'x-tab': `a\tb${'c'.repeat(40)}`,
+  'connection': 'close'
+};
+
+if (process.argv[2] === 'child') {
+  const server = http.createServer(common.mustCall((req, res) => {
+    console.log(JSON.stringify({ url: req.url, headers: req.headers }));
+    res.end();
+    server.close();
+  }));
+  server.listen(0, common.mustCall(() => {
+    http.get({ port: server.address().port, path, headers });
+  }));
+  return;
+}
+
+for (const scanner of ['legacy', 'simd']) {
+  const r = spawnSync(process.execPath,
+                      [`--http-parser=${scanner}`, __filename, 'child'],
+                      { encoding: 'utf8' });
+  assert.strictEqual(r.stderr, '');
+  assert.strictEqual(r.status, 0);
+  const seen = JSON.parse(r.stdout);
+  assert.strictEqual(seen.url, path);
+  for (const name of Object.keys(headers))
+    assert.strictEqual(seen.headers[name], headers[name]);
+}
+
+const r = spawnSync(process.execPath, ['--http-parser=fast', '-e', '0'],
+                    { encoding: 'utf8' });
+assert.strictEqual(r.status, 9);
+assert.ok(r.stderr.includes('invalid value for --http-parser'));
@@ -0,0 +1,58 @@
+'use strict';
+const common = require('../common');
+
+// Tests the --loop-busy-poll option and perf_hooks.eventLoopBusyPoll().
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const { eventLoopBusyPoll } = require('perf_hooks');
+
+if (process.argv[2] === 'child') {
+  const net = require('net');
+  const server = net.createServer((socket) => socket.pipe(socket));
+  server.listen(0, () => {
+    const socket = net.connect(server.address().port);
+    let echoed = 0;
+    socket.on('data', (data) => {
+      echoed += data.length;
+      if (echoed < 10) {
+        socket.write('x');
+      } else {
+        socket.end();
+        server.close();
+      }
+    });
+    socket.write('x');
+  });
+  process.on('exit', () => {
+    console.log(JSON.stringify(eventLoopBusyPoll()));
+  });
+  return;
+}
+
+// Off by default.
+assert.deepStrictEqual(eventLoopBusyPoll(),
+                       { budget: 0, polls: 0, hits: 0, blocks: 0 });
+
+{
+  const r = spawnSync(process.execPath,
+                      ['--loop-busy-poll=500', __filename, 'child'],
+                      { encoding: 'utf8' });
+  assert.strictEqual(r.stderr, '');
+  assert.strictEqual(r.status, 0);
+  const stats = JSON.parse(r.stdout);
+  if (common.isLinux) {
+    assert.strictEqual(stats.budget, 500);
+    assert(stats.polls > 0);
+    assert(stats.polls >= stats.hits + stats.blocks);
+  } else {
+    assert.deepStrictEqual(stats, { budget: 0, polls: 0, hits: 0, blocks: 0 });
+  }
+}
+
+for (const value of ['-1', '1000001']) {
+  const r = spawnSync(process.execPath,
+                      [`--loop-busy-poll=${value}`, '-e', '0'],
+                      { encoding: 'utf8' });
+  assert.strictEqual(r.status, 9);
+}
@@ -0,0 +1,52 @@
+'use strict';
+require('../common');
+
+// Tests the --threadpool-<class> options.
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+const script = `
+  require('crypto').pbkdf2Sync('secret', 'salt', 1, 8, 'sha256');
+  require('crypto').pbkdf2('secret', 'salt', 1000, 8, 'sha256', (err) => {
+    if (err) throw err;
+    require('fs').readFile(__filename, (err) => {
+      if (err) throw err;
+      require('dns').lookup('localhost', () => console.log('ok'));
+    });
+  });
+`;
+
+function run(args, env) {
+  return spawnSync(process.execPath, [...args, '-e', script], {
+    encoding: 'utf8',
+    env: Object.assign({}, process.env, env)
+  });
+}
+
+for (const [option, value] of [['fs', '1'], ['dns', '0'], ['cpu', '2:5'],
+                               ['user', '128:-1']]) {
+  const r = run([`--threadpool-${option}=${value}`]);
+  assert.strictEqual(r.stderr, '');
+  assert.strictEqual(r.stdout.trim(), 'ok');
+  assert.strictEqual(r.status, 0);
+}
+
+for (const [option, value] of [['fs', '-1'], ['dns', '1025'], ['cpu', 'x'],
+                               ['user', '1:'], ['cpu', ':1'], ['cpu', '1:x'],
+                               ['cpu', '1:2:3']]) {
+  const r = run([`--threadpool-${option}=${value}`]);
+  assert.strictEqual(r.status, 9);
+  assert.ok(r.stderr.includes(
+    `--threadpool-${option} must be <share>[:<priority>]`), r.stderr);
+}
+
+// Also accepted from NODE_OPTIONS, and next to the environment variables that
+// libuv reads itself.
+const r = run([], {
+  NODE_OPTIONS: '--threadpool-cpu=1:0',
+  UV_THREADPOOL_CPU_SHARE: '2',
+  UV_THREADPOOL_FS_PRIORITY: '3'
+});
+assert.strictEqual(r.stderr, '');
+assert.strictEqual(r.stdout.trim(), 'ok');
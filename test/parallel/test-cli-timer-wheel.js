@@ -0,0 +1,37 @@
+'use strict';
+require('../common');
+
+// Tests that timers behave the same with --timer-wheel.
+
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+
+if (process.argv[2] === 'child') {
+  const fired = [];
+  // setTimeout(fn, 0) is the same as setTimeout(fn, 1).
+  const durations = [50, 1, 100, 0, 70, 1, 200, 10];
+  for (const [i, ms] of durations.entries())
+    setTimeout(() => fired.push(i), ms);
+  clearTimeout(setTimeout(() => fired.push('cleared'), 5));
+
+  let ticks = 0;
+  const interval = setInterval(() => {
+    if (++ticks === 3) clearInterval(interval);
+  }, 30);
+
+  // A far-away timer that does not keep the process alive.
+  setTimeout(() => fired.push('unref'), 1e9).unref();
+
+  process.on('exit', () => {
+    console.log(JSON.stringify({ fired, ticks }));
+  });
+  return;
+}
+
+const r = spawnSync(process.execPath,
+                    ['--timer-wheel', __filename, 'child'],
+                    { encoding: 'utf8' });
+assert.strictEqual(r.stderr, '');
+assert.strictEqual(r.status, 0);
+assert.deepStrictEqual(JSON.parse(r.stdout),
+                       { fired: [1, 3, 5, 7, 0, 4, 2, 6], ticks: 3 });
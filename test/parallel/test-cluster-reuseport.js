@@ -0,0 +1,53 @@
+'use strict';
+const common = require('../common');
+
+// Tests cluster.SCHED_REUSEPORT: every worker listens on a socket of its own,
+// on the port that the master has picked, and accepts connections itself.
+
+if (!common.isLinux)
+  common.skip('SO_REUSEPORT balancing is only used on Linux');
+
+const assert = require('assert');
+const cluster = require('cluster');
+const net = require('net');
+
+const NUM_WORKERS = 2;
+
+if (cluster.isMaster) {
+  cluster.schedulingPolicy = cluster.SCHED_REUSEPORT;
+
+  const ports = [];
+  for (let i = 0; i < NUM_WORKERS; i++) {
+    cluster.fork().on('message', common.mustCall((msg) => {
+      // A real TCP handle, not the faux one used for round-robin.
+      assert.strictEqual(msg.handle, 'TCP');
+      ports.push(msg.port);
+      if (ports.length === NUM_WORKERS)
+        connect();
+    }));
+  }
+
+  const connect = () => {
+    assert.strictEqual(ports[0], ports[1]);
+    assert.notStrictEqual(ports[0], 0);
+
+    const socket = net.connect(ports[0], common.mustCall(() => {
+      socket.end();
+    }));
+    socket.setEncoding('utf8');
+    socket.on('data', common.mustCall((data) => {
+      assert.strictEqual(data, 'hello');
+      cluster.disconnect();
+    }));
+  };
+} else {
+  const server = net.createServer((socket) => {
+    socket.end('hello');
+  });
+  server.listen(0, common.mustCall(() => {
+    process.send({
+      handle: server._handle.constructor.name,
+      port: server.address().port
+    });
+  }));
+}
@@ -0,0 +1,100 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+const count = 32;
+const msgs = [];
+for (let i = 0; i < count; i++)
+  msgs.push(i % 2 ? Buffer.from(`datagram ${i}`) : `datagram ${i}`);
+
+function check(received, rinfos, sender) {
+  assert.strictEqual(received.length, count);
+  for (let i = 0; i < count; i++) {
+    assert.strictEqual(received[i].toString(), `datagram ${i}`);
+    assert.strictEqual(rinfos[i].address, common.localhostIPv4);
+    assert.strictEqual(rinfos[i].port, sender.address().port);
+    assert.strictEqual(rinfos[i].size, received[i].length);
+  }
+}
+
+{
+  // A socket in batch mode emits 'messages' with the datagrams of each read.
+  const receiver = dgram.createSocket({ type: 'udp4', recvBatch: true });
+  const sender = dgram.createSocket('udp4');
+  const received = [];
+  const rinfos = [];
+
+  receiver.on('message', common.mustNotCall());
+  receiver.on('messages', common.mustCallAtLeast((batch, infos) => {
+    assert.strictEqual(batch.length, infos.length);
+    assert(batch.length > 0);
+    received.push(...batch);
+    rinfos.push(...infos);
+    if (received.length < count)
+      return;
+    check(received, rinfos, sender);
+    receiver.close();
+    sender.close();
+  }, 1));
+
+  receiver.bind(0, common.localhostIPv4, common.mustCall(() => {
+    const bytes = msgs.reduce((sum, msg) => sum + msg.length, 0);
+    sender.sendBatch(msgs,
+                     receiver.address().port,
+                     common.localhostIPv4,
+                     common.mustCall((err, sent) => {
+                       assert.ifError(err);
+                       assert.strictEqual(sent, bytes);
+                     }));
+  }));
+}
+
+{
+  // Without a 'messages' listener, a batch is emitted as 'message' events.
+  const receiver = dgram.createSocket({ type: 'udp4', recvBatch: true });
+  const sender = dgram.createSocket('udp4');
+  const received = [];
+  const rinfos = [];
+
+  receiver.on('message', common.mustCall((msg, rinfo) => {
+    received.push(msg);
+    rinfos.push(rinfo);
+    if (received.length < count)
+      return;
+    check(received, rinfos, sender);
+    receiver.close();
+    sender.close();
+  }, count));
+
+  receiver.bind(0, common.localhostIPv4, common.mustCall(() => {
+    sender.sendBatch(msgs, receiver.address().port, common.localhostIPv4);
+  }));
+}
+
+{
+  const socket = dgram.createSocket('udp4');
+
+  common.expectsError(() => socket.sendBatch('foo', 1234), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError
+  });
+  common.expectsError(() => socket.sendBatch(['foo', 42], 1234), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError,
+    message: 'The "msgs[1]" argument must be one of type Buffer, ' +
+             'Uint8Array, or string. Received type number'
+  });
+  common.expectsError(() => socket.sendBatch(['foo'], 0), {
+    code: 'ERR_SOCKET_BAD_PORT',
+    type: RangeError
+  });
+
+  // An empty batch completes without binding the socket.
+  socket.sendBatch([], 1234, common.mustCall((err, sent) => {
+    assert.strictEqual(err, null);
+    assert.strictEqual(sent, 0);
+    socket.close();
+  }));
+}
@@ -33,6 +33,18 @@ function verify(src, dest) {
   assert.strictEqual(srcStat.size, destStat.size);
 }
 
+const methods = [
+  'clone', 'copy_file_range', 'copy_file_range+sendfile', 'sendfile', 'system',
+];
+
+function verifyMethod(method) {
+  assert(methods.includes(method), `unexpected copy method ${method}`);
+  if (common.isWindows || common.isOSX)
+    assert.strictEqual(method, 'system');
+  else
+    assert.notStrictEqual(method, 'system');
+}
+
 tmpdir.refresh();
 
 // Verify that flags are defined.
@@ -49,13 +61,28 @@ assert.strictEqual(COPYFILE_FICLONE_FORCE, UV_FS_COPYFILE_FICLONE_FORCE);
 // Verify that files are overwritten when no flags are provided.
 fs.writeFileSync(dest, '', 'utf8');
 const result = fs.copyFileSync(src, dest);
-assert.strictEqual(result, undefined);
+verifyMethod(result);
+// A plain copy never clones.
+assert.notStrictEqual(result, 'clone');
 verify(src, dest);
 
 // Verify that files are overwritten with default flags.
 fs.copyFileSync(src, dest, 0);
 verify(src, dest);
 
+// Copying an empty file takes no copy mechanism at all.
+{
+  const empty = path.join(tmpdir.path, 'copyfile-empty.in');
+  fs.writeFileSync(empty, '');
+  const method = fs.copyFileSync(empty, dest);
+  if (common.isWindows || common.isOSX)
+    assert.strictEqual(method, 'system');
+  else
+    assert.strictEqual(method, 'none');
+  verify(empty, dest);
+  fs.unlinkSync(empty);
+}
+
 // Verify that UV_FS_COPYFILE_FICLONE can be used.
 fs.unlinkSync(dest);
 fs.copyFileSync(src, dest, UV_FS_COPYFILE_FICLONE);
@@ -64,7 +91,9 @@ verify(src, dest);
 // Verify that COPYFILE_FICLONE_FORCE can be used.
 try {
   fs.unlinkSync(dest);
-  fs.copyFileSync(src, dest, COPYFILE_FICLONE_FORCE);
+  const method = fs.copyFileSync(src, dest, COPYFILE_FICLONE_FORCE);
+  if (common.isLinux)
+    assert.strictEqual(method, 'clone');
   verify(src, dest);
 } catch (err) {
   assert.strictEqual(err.syscall, 'copyfile');
@@ -76,12 +105,14 @@ try {
 
 // Copies asynchronously.
 tmpdir.refresh(); // Don't use unlinkSync() since the last test may fail.
-fs.copyFile(src, dest, common.mustCall((err) => {
+fs.copyFile(src, dest, common.mustCall((err, method) => {
   assert.ifError(err);
+  verifyMethod(method);
   verify(src, dest);
 
   // Copy asynchronously with flags.
-  fs.copyFile(src, dest, COPYFILE_EXCL, common.mustCall((err) => {
+  fs.copyFile(src, dest, COPYFILE_EXCL, common.mustCall((err, method) => {
+    assert.strictEqual(method, undefined);
     if (err.code === 'ENOENT') {  // Could be ENOENT or EEXIST
       assert.strictEqual(err.message,
                          'ENOENT: no such file or directory, copyfile ' +
@@ -0,0 +1,118 @@
+'use strict';
+
+const common = require('../common');
+
+// The following tests validate base functionality for the fs.promises
+// FileHandle.map method and fs.promises.madvise.
+
+if (common.isWindows)
+  common.skip('mmap is not supported on Windows');
+
+const fs = require('fs');
+const { open, madvise } = fs.promises;
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+
+tmpdir.refresh();
+
+const filePath = path.resolve(tmpdir.path, 'tmp-map-file.bin');
+// Span a few pages so that unaligned offsets cross page boundaries.
+const contents = Buffer.alloc(3 * 4096 + 123);
+for (let i = 0; i < contents.length; i++)
+  contents[i] = i % 251;
+fs.writeFileSync(filePath, contents);
+
+async function validateMap() {
+  const fileHandle = await open(filePath, 'r');
+
+  const whole = await fileHandle.map();
+  assert(Buffer.isBuffer(whole));
+  assert.deepStrictEqual(whole, contents);
+
+  // Unaligned offset, explicit length.
+  const part = await fileHandle.map(4097, 5000, { advice: 'sequential' });
+  assert.deepStrictEqual(part, contents.slice(4097, 4097 + 5000));
+
+  // Offset at the end of the file maps nothing.
+  const empty = await fileHandle.map(contents.length);
+  assert.strictEqual(empty.length, 0);
+
+  await madvise(whole, 'willneed');
+  await madvise(part.subarray(10, 20), 'random');
+  await madvise(empty, 'normal');
+
+  await fileHandle.close();
+
+  // The mapping outlives the file descriptor.
+  assert.deepStrictEqual(whole, contents);
+}
+
+async function validatePrivateWritableMap() {
+  const fileHandle = await open(filePath, 'r');
+  // Mappings are private and writable by default.
+  const buf = await fileHandle.map(0, 16);
+  buf.fill(0);
+  await fileHandle.close();
+
+  // Private mappings are copy-on-write.
+  assert.deepStrictEqual(fs.readFileSync(filePath), contents);
+}
+
+async function validateSharedWritableMap() {
+  const sharedPath = path.resolve(tmpdir.path, 'tmp-map-shared.bin');
+  fs.writeFileSync(sharedPath, 'hello world');
+
+  const fileHandle = await open(sharedPath, 'r+');
+  const buf = await fileHandle.map(0, 5, { shared: true });
+  buf.write('HELLO');
+  await fileHandle.close();
+
+  assert.strictEqual(fs.readFileSync(sharedPath, 'utf8'), 'HELLO world');
+}
+
+async function validateErrors() {
+  const fileHandle = await open(filePath, 'r');
+
+  await assert.rejects(fileHandle.map(-1), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+  await assert.rejects(fileHandle.map(0, 1.5), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+  await assert.rejects(fileHandle.map(0, 1, { shared: 1 }), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  await assert.rejects(fileHandle.map(0, 1, { advice: 'sometimes' }), {
+    code: 'ERR_INVALID_OPT_VALUE'
+  });
+
+  // Writable shared mappings need a writable descriptor.
+  await assert.rejects(fileHandle.map(0, 1, { shared: true }), {
+    code: 'EACCES', syscall: 'mmap'
+  });
+  const readonlyShared = await fileHandle.map(0, 1, {
+    shared: true, readonly: true
+  });
+  assert.strictEqual(readonlyShared[0], contents[0]);
+
+  await assert.rejects(madvise(Buffer.alloc(4096), 'dontneed'), {
+    code: 'ERR_INVALID_ARG_VALUE'
+  });
+  await assert.rejects(madvise('not a buffer', 'normal'), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+
+  const buf = await fileHandle.map(0, 1);
+  await assert.rejects(madvise(buf), {
+    code: 'ERR_INVALID_OPT_VALUE'
+  });
+
+  await fileHandle.close();
+}
+
+validateMap()
+  .then(validatePrivateWritableMap)
+  .then(validateSharedWritableMap)
+  .then(validateErrors)
+  .then(common.mustCall());
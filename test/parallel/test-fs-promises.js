@@ -68,7 +68,8 @@ function verifyStatObject(stat) {
   async function doTest() {
     tmpdir.refresh();
     const dest = path.resolve(tmpDir, 'baz.js');
-    await copyFile(fixtures.path('baz.js'), dest);
+    const method = await copyFile(fixtures.path('baz.js'), dest);
+    assert.strictEqual(typeof method, 'string');
     await access(dest, 'r');
 
     const handle = await open(dest, 'r+');
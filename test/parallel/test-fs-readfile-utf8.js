@@ -0,0 +1,63 @@
+'use strict';
+const common = require('../common');
+
+// readFile() reads the file and scans it for non-ASCII bytes in one threadpool
+// job, ASCII-only data then skips UTF-8 decoding on the main thread. Make sure
+// ASCII-only and non-ASCII contents, and the other encodings, round-trip
+// correctly.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const contents = {
+  ascii: 'hello world\n'.repeat(10000),
+  latin1: 'café '.repeat(10000),
+  multibyte: '中文 😀 '.repeat(10000),
+  mixed: 'x'.repeat(100000) + 'é'
+};
+
+for (const [name, str] of Object.entries(contents)) {
+  const file = path.join(tmpdir.path, `readfile-${name}.txt`);
+  fs.writeFileSync(file, str);
+
+  fs.readFile(file, 'utf8', common.mustCall((err, data) => {
+    assert.ifError(err);
+    assert.strictEqual(data, str);
+  }));
+
+  fs.readFile(file, { encoding: 'utf-8' }, common.mustCall((err, data) => {
+    assert.ifError(err);
+    assert.strictEqual(data, str);
+  }));
+
+  fs.readFile(file, 'hex', common.mustCall((err, data) => {
+    assert.ifError(err);
+    assert.strictEqual(data, Buffer.from(str).toString('hex'));
+  }));
+
+  fs.readFile(file, common.mustCall((err, data) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(data, Buffer.from(str));
+  }));
+}
+
+// Invalid sequences are replaced the same way Buffer#toString() does it.
+const invalid = Buffer.from([0x61, 0xff, 0x62, 0xc3]);
+const invalidFile = path.join(tmpdir.path, 'readfile-invalid.txt');
+fs.writeFileSync(invalidFile, invalid);
+fs.readFile(invalidFile, 'utf8', common.mustCall((err, data) => {
+  assert.ifError(err);
+  assert.strictEqual(data, invalid.toString('utf8'));
+}));
+
+// Errors carry the path and the failing syscall.
+const missing = path.join(tmpdir.path, 'readfile-missing.txt');
+fs.readFile(missing, 'utf8', common.mustCall((err) => {
+  assert.strictEqual(err.code, 'ENOENT');
+  assert.strictEqual(err.syscall, 'open');
+  assert.strictEqual(err.path, missing);
+}));
@@ -0,0 +1,85 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'stat-many-file');
+const dir = path.join(tmpdir.path, 'stat-many-dir');
+const missing = path.join(tmpdir.path, 'stat-many-missing');
+fs.writeFileSync(file, 'test');
+fs.mkdirSync(dir);
+
+const paths = [file, dir, missing, Buffer.from(file)];
+
+function verify(results, bigint) {
+  assert.strictEqual(results.length, paths.length);
+
+  assert(results[0] instanceof fs.Stats);
+  assert(results[0].isFile());
+  assert.strictEqual(results[0].size, bigint ? 4n : 4);
+  assert.strictEqual(results[0].ino, fs.statSync(file, { bigint }).ino);
+
+  assert(results[1] instanceof fs.Stats);
+  assert(results[1].isDirectory());
+
+  assert(results[2] instanceof Error);
+  assert.strictEqual(results[2].code, 'ENOENT');
+  assert.strictEqual(results[2].syscall, 'stat');
+  assert.strictEqual(results[2].path, missing);
+
+  assert(results[3].isFile());
+  assert.strictEqual(results[3].ino, results[0].ino);
+}
+
+verify(fs.statManySync(paths), false);
+verify(fs.statManySync(paths, { bigint: true }), true);
+
+fs.statMany(paths, common.mustCall((err, results) => {
+  assert.ifError(err);
+  verify(results, false);
+}));
+
+fs.statMany(paths, { bigint: true }, common.mustCall((err, results) => {
+  assert.ifError(err);
+  verify(results, true);
+}));
+
+fs.statMany([], common.mustCall((err, results) => {
+  assert.ifError(err);
+  assert.deepStrictEqual(results, []);
+}));
+
+fs.promises.statMany(paths).then(common.mustCall((results) => {
+  verify(results, false);
+}));
+
+if (common.canCreateSymLink()) {
+  const link = path.join(tmpdir.path, 'stat-many-link');
+  fs.symlinkSync(file, link);
+  const [linkStats] = fs.statManySync([link], { followSymlinks: false });
+  assert(linkStats.isSymbolicLink());
+  assert(fs.statManySync([link])[0].isFile());
+}
+
+common.expectsError(
+  () => fs.statMany('not-an-array', common.mustNotCall()),
+  {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError
+  }
+);
+
+common.expectsError(
+  () => fs.statManySync([file, 42]),
+  {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError,
+    message: 'The "paths[1]" argument must be one of type string, Buffer, ' +
+             'or URL. Received type number'
+  }
+);
@@ -0,0 +1,130 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const root = path.join(tmpdir.path, 'walk');
+fs.mkdirSync(path.join(root, 'a', 'b', 'c'), { recursive: true });
+fs.mkdirSync(path.join(root, 'd'));
+fs.writeFileSync(path.join(root, 'f1'), '');
+fs.writeFileSync(path.join(root, 'a', 'f2'), '');
+fs.writeFileSync(path.join(root, 'a', 'b', 'f3'), '');
+fs.writeFileSync(path.join(root, 'a', 'b', 'c', 'f4'), '');
+
+// Enough directories to need several threadpool batches.
+for (let i = 0; i < 100; i++) {
+  const dir = path.join(root, 'd', `sub${i}`);
+  fs.mkdirSync(dir);
+  fs.writeFileSync(path.join(dir, 'file'), '');
+}
+
+const canSymlink = common.canCreateSymLink();
+if (canSymlink)
+  fs.symlinkSync(root, path.join(root, 'a', 'loop'), 'dir');
+
+async function collect(options) {
+  const entries = [];
+  for await (const { path: entry, type } of fs.walk(root, options))
+    entries.push(`${path.relative(root, entry)}:${type}`);
+  return entries.sort();
+}
+
+function expected(withSubdirs) {
+  const entries = [
+    'a:directory',
+    path.join('a', 'b') + ':directory',
+    path.join('a', 'b', 'c') + ':directory',
+    path.join('a', 'b', 'c', 'f4') + ':file',
+    path.join('a', 'b', 'f3') + ':file',
+    path.join('a', 'f2') + ':file',
+    'd:directory',
+    'f1:file'
+  ];
+  if (withSubdirs) {
+    for (let i = 0; i < 100; i++) {
+      entries.push(path.join('d', `sub${i}`) + ':directory');
+      entries.push(path.join('d', `sub${i}`, 'file') + ':file');
+    }
+  }
+  return entries;
+}
+
+async function testWalk() {
+  const all = expected(true);
+  if (canSymlink)
+    all.push(path.join('a', 'loop') + ':symlink');
+  assert.deepStrictEqual(await collect(), all.sort());
+
+  assert.deepStrictEqual(await collect({ maxDepth: 1 }),
+                         ['a:directory', 'd:directory', 'f1:file']);
+  assert.deepStrictEqual(await collect({ maxDepth: 0 }), []);
+
+  // filter() prunes whole subtrees.
+  const filter = ({ path: entry }) => path.basename(entry) !== 'd' &&
+                                      path.basename(entry) !== 'loop';
+  assert.deepStrictEqual(await collect({ filter }), expected(false).filter(
+    (entry) => !entry.startsWith('d')).sort());
+
+  if (canSymlink) {
+    // The link back to the root is reported as a directory, but not
+    // walked into a second time.
+    const followed = await collect({ followSymlinks: true });
+    const withLoop = expected(true);
+    withLoop.push(path.join('a', 'loop') + ':directory');
+    assert.deepStrictEqual(followed, withLoop.sort());
+  }
+
+  // Stopping early is fine.
+  for await (const entry of fs.walk(root)) {
+    assert.strictEqual(typeof entry.path, 'string');
+    break;
+  }
+
+  await assert.rejects(async () => {
+    for await (const entry of fs.walk(path.join(root, 'missing')))
+      assert.fail(`unexpected entry ${entry.path}`);
+  }, { code: 'ENOENT', syscall: 'scandir' });
+
+  // Permissions don't apply to root, and Windows has no mode bits.
+  if (!common.isWindows && process.getuid() !== 0)
+    await testUnreadable();
+}
+
+async function testUnreadable() {
+  const locked = path.join(root, 'a', 'b');
+  fs.chmodSync(locked, 0);
+  try {
+    // Without onError() the whole walk fails.
+    await assert.rejects(collect(), { code: 'EACCES', path: locked });
+
+    // With it, the error is reported and the rest of the tree is walked.
+    const onError = common.mustCall((err) => {
+      assert.strictEqual(err.code, 'EACCES');
+      assert.strictEqual(err.syscall, 'scandir');
+      assert.strictEqual(err.path, locked);
+    });
+    const entries = await collect({ onError });
+    assert(entries.includes(path.join('a', 'b') + ':directory'));
+    assert(entries.includes(path.join('a', 'f2') + ':file'));
+    assert(!entries.includes(path.join('a', 'b', 'f3') + ':file'));
+  } finally {
+    fs.chmodSync(locked, 0o755);
+  }
+}
+
+testWalk().then(common.mustCall());
+
+[
+  [() => fs.walk(42), 'ERR_INVALID_ARG_TYPE'],
+  [() => fs.walk(root, null), 'ERR_INVALID_ARG_TYPE'],
+  [() => fs.walk(root, { maxDepth: -1 }), 'ERR_OUT_OF_RANGE'],
+  [() => fs.walk(root, { maxDepth: '1' }), 'ERR_INVALID_ARG_TYPE'],
+  [() => fs.walk(root, { followSymlinks: 1 }), 'ERR_INVALID_ARG_TYPE'],
+  [() => fs.walk(root, { filter: true }), 'ERR_INVALID_ARG_TYPE'],
+  [() => fs.walk(root, { onError: true }), 'ERR_INVALID_ARG_TYPE']
+].forEach(([fn, code]) => common.expectsError(fn, { code }));
@@ -19,7 +19,9 @@ server.listen(0, common.localhostIPv4, common.mustCall(() => {
   req.on('socket', common.mustCall((socket) => {
     assert.strictEqual(socket[kTimeout], null);
     socket.on('connect', common.mustCall(() => {
-      assert.strictEqual(socket[kTimeout]._idleTimeout, 1);
+      // The handle keeps track of the timeout once there is one.
+      assert.strictEqual(socket[kTimeout], null);
+      assert.strictEqual(socket._handle.getIdleTimeout(), 1);
     }));
   }));
   req.on('timeout', common.mustCall(() => req.abort()));
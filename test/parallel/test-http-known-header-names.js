@@ -0,0 +1,63 @@
+'use strict';
+const common = require('../common');
+
+// Common header names are recognized whatever their spelling, and are
+// reported with their original spelling in rawHeaders.
+
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+const request = [
+  'GET / HTTP/1.1',
+  'Host: localhost',
+  'user-agent: test',
+  'Cookie: a=1',
+  'cookie: b=2',
+  'COOKIE: c=3',
+  'Accept: text/html',
+  'accept: text/plain',
+  'Content-Type: text/plain',
+  'content-type: ignored',
+  'X-Request-ID: 1',
+  'x-custom: yes',
+  'Connection: close',
+  '',
+  ''
+].join('\r\n');
+
+const server = http.createServer(common.mustCall((req, res) => {
+  assert.deepStrictEqual(req.headers, {
+    'host': 'localhost',
+    'user-agent': 'test',
+    'cookie': 'a=1; b=2; c=3',
+    'accept': 'text/html, text/plain',
+    'content-type': 'text/plain',
+    'x-request-id': '1',
+    'x-custom': 'yes',
+    'connection': 'close'
+  });
+  assert.deepStrictEqual(req.rawHeaders, [
+    'Host', 'localhost',
+    'user-agent', 'test',
+    'Cookie', 'a=1',
+    'cookie', 'b=2',
+    'COOKIE', 'c=3',
+    'Accept', 'text/html',
+    'accept', 'text/plain',
+    'Content-Type', 'text/plain',
+    'content-type', 'ignored',
+    'X-Request-ID', '1',
+    'x-custom', 'yes',
+    'Connection', 'close'
+  ]);
+  res.end();
+  server.close();
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port, () => {
+    client.end(request);
+  });
+  client.resume();
+}));
@@ -0,0 +1,62 @@
+'use strict';
+// Flags: --expose-internals
+
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const { internalBinding } = require('internal/test/binding');
+const { serializeHead } = internalBinding('http_parser');
+
+const firstLine = 'HTTP/1.1 200 OK\r\n';
+
+assert.strictEqual(
+  serializeHead(firstLine, ['Content-Type', 'text/plain', 'X-Num', 42],
+                true, false),
+  'HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nX-Num: 42\r\n');
+assert.strictEqual(serializeHead(firstLine, [], true, false), firstLine);
+
+// Date headers use the same format as Date#toUTCString().
+{
+  const head = serializeHead(firstLine, ['X', 'y'], false, true);
+  const match = /^HTTP\/1\.1 200 OK\r\nX: y\r\nDate: (.+)\r\n$/.exec(head);
+  assert.ok(match);
+  assert.strictEqual(new Date(match[1]).toUTCString(), match[1]);
+}
+
+// Anything that has to be rejected or escaped is left to JS.
+for (const [name, value] of [
+  ['', 'x'],
+  ['Bad Name', 'x'],
+  ['X', 'a\r\nb'],
+  ['X', 'a\u0000b'],
+  ['X', 'aĀb'],
+  ['X', undefined]
+]) {
+  assert.strictEqual(serializeHead(firstLine, [name, value], true, false),
+                     undefined);
+}
+assert.strictEqual(serializeHead(firstLine, ['X', 'a\r\nb'], false, false),
+                   undefined);
+assert.strictEqual(serializeHead(firstLine, ['X', 'aéb'], true, false),
+                   'HTTP/1.1 200 OK\r\nX: aéb\r\n');
+
+// Invalid headers still throw the usual errors.
+const server = http.createServer(common.mustCall((req, res) => {
+  common.expectsError(() => res.writeHead(200, { 'Bad Name': 'x' }), {
+    code: 'ERR_INVALID_HTTP_TOKEN'
+  });
+  common.expectsError(() => res.writeHead(200, { 'X': 'aĀb' }), {
+    code: 'ERR_INVALID_CHAR'
+  });
+  res.writeHead(200, { 'X-Test': 'yes' });
+  res.end('ok');
+}));
+
+server.listen(0, common.mustCall(() => {
+  http.get({ port: server.address().port }, common.mustCall((res) => {
+    assert.strictEqual(res.headers['x-test'], 'yes');
+    assert.ok(res.headers.date);
+    res.resume();
+    res.on('end', common.mustCall(() => server.close()));
+  }));
+}));
@@ -0,0 +1,80 @@
+'use strict';
+const common = require('../common');
+
+// With batchPipelinedRequests, requests that arrive in a single read are
+// handled in one go, and responses that are sent right away are written to
+// the socket together.
+
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+const requests = [
+  'GET /a HTTP/1.1\r\nHost: localhost\r\n\r\n',
+  'POST /b HTTP/1.1\r\nHost: localhost\r\nContent-Length: 5\r\n\r\nhello',
+  'GET /c HTTP/1.1\r\nHost: localhost\r\n\r\n',
+  'GET /d HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n'
+].join('');
+
+function pipeline(onRequest, onConnection, callback) {
+  const seen = [];
+  const server = http.createServer({ batchPipelinedRequests: true },
+                                   common.mustCall((req, res) => {
+                                     seen.push(req.url);
+                                     onRequest(req, res);
+                                   }, 4));
+  server.on('connection', common.mustCall(onConnection));
+
+  server.listen(0, common.mustCall(() => {
+    const client = net.connect(server.address().port, () => {
+      client.write(requests);
+    });
+    let data = '';
+    client.setEncoding('utf8');
+    client.on('data', (chunk) => data += chunk);
+    client.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(seen, ['/a', '/b', '/c', '/d']);
+      const bodies = data.split('HTTP/1.1 200 OK\r\n').slice(1).map((res) => {
+        return res.slice(res.indexOf('\r\n\r\n') + 4);
+      });
+      server.close();
+      callback(bodies);
+    }));
+  }));
+}
+
+// Responses that are sent while the batch is handled take a single write.
+pipeline((req, res) => {
+  res.end(req.url);
+}, (socket) => {
+  let writes = 0;
+  const writev = socket._writev;
+  const write = socket._write;
+  socket._writev = function(chunks, cb) {
+    writes++;
+    return writev.call(this, chunks, cb);
+  };
+  socket._write = function(chunk, encoding, cb) {
+    writes++;
+    return write.call(this, chunk, encoding, cb);
+  };
+  socket.on('close', common.mustCall(() => {
+    assert.strictEqual(writes, 1);
+  }));
+}, common.mustCall((bodies) => {
+  assert.deepStrictEqual(bodies, ['/a', '/b', '/c', '/d']);
+
+  // Responses that are sent later still go out in order.
+  pipeline((req, res) => {
+    if (req.url !== '/b')
+      return res.end(req.url);
+    let body = '';
+    req.setEncoding('utf8');
+    req.on('data', (chunk) => body += chunk);
+    req.on('end', common.mustCall(() => {
+      setImmediate(() => res.end(`${req.url} ${body}`));
+    }));
+  }, () => {}, common.mustCall((bodies) => {
+    assert.deepStrictEqual(bodies, ['/a', '/b hello', '/c', '/d']);
+  }));
+}));
@@ -0,0 +1,52 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const http = require('http');
+const fixtures = require('../common/fixtures');
+
+const file = fixtures.path('person.jpg');
+const data = fs.readFileSync(file);
+const fd = fs.openSync(file, 'r');
+
+const server = http.createServer(common.mustCall((req, res) => {
+  if (req.url === '/content-length') {
+    // Single range, framed by Content-Length.
+    res.setHeader('Content-Length', data.length);
+    res.sendFile(fd, common.mustCall());
+    res.end();
+  } else {
+    // Mixed with regular writes, framed by chunked encoding.
+    res.write('<');
+    res.sendFile(fd, { offset: 10, length: 100 }, common.mustCall());
+    res.sendFile(fd, { offset: 200 }, common.mustCall());
+    res.end('>');
+  }
+}, 2));
+
+server.listen(0, common.mustCall(() => {
+  const { port } = server.address();
+  let pending = 2;
+
+  function get(path, expected) {
+    http.get({ port, path }, common.mustCall((res) => {
+      const chunks = [];
+      res.on('data', (chunk) => chunks.push(chunk));
+      res.on('end', common.mustCall(() => {
+        assert(Buffer.concat(chunks).equals(expected));
+        if (--pending === 0) {
+          server.close();
+          fs.closeSync(fd);
+        }
+      }));
+    }));
+  }
+
+  get('/content-length', data);
+  get('/chunked', Buffer.concat([
+    Buffer.from('<'),
+    data.slice(10, 110),
+    data.slice(200),
+    Buffer.from('>')
+  ]));
+}));
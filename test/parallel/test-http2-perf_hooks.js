@@ -23,6 +23,9 @@ const obs = new PerformanceObserver(common.mustCall((items) => {
       assert.strictEqual(typeof entry.bytesWritten, 'number');
       assert.strictEqual(typeof entry.bytesRead, 'number');
       assert.strictEqual(typeof entry.maxConcurrentStreams, 'number');
+      assert(entry.poolAllocations > 0);
+      assert.strictEqual(typeof entry.heapAllocations, 'number');
+      assert(entry.poolSize > 0);
       switch (entry.type) {
         case 'server':
           assert.strictEqual(entry.streamCount, 1);
@@ -0,0 +1,124 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+const message = Buffer.alloc(64 * 1024, 'a');
+
+function startServer(cb) {
+  const server = net.createServer((socket) => {
+    socket.end(message);
+  }).listen(0, common.mustCall(() => cb(server)));
+}
+
+// Reads go into a single, reused buffer.
+startServer((server) => {
+  const buffer = Buffer.alloc(1024);
+  const chunks = [];
+  let bytes = 0;
+  const client = net.connect({
+    port: server.address().port,
+    onread: {
+      buffer,
+      callback: common.mustCallAtLeast((nread, buf) => {
+        assert.strictEqual(buf, buffer);
+        assert.ok(nread > 0 && nread <= buffer.length);
+        chunks.push(Buffer.from(buf.slice(0, nread)));
+        bytes += nread;
+      })
+    }
+  });
+  client.on('data', common.mustNotCall());
+  client.on('end', common.mustCall(() => {
+    assert.strictEqual(bytes, message.length);
+    assert.deepStrictEqual(Buffer.concat(chunks), message);
+    server.close();
+  }));
+});
+
+// A function can hand out a new buffer for every read.
+startServer((server) => {
+  const buffers = [];
+  let bytes = 0;
+  const client = net.connect({
+    port: server.address().port,
+    onread: {
+      buffer: common.mustCallAtLeast(() => {
+        const buf = Buffer.alloc(2048);
+        buffers.push(buf);
+        return buf;
+      }),
+      callback: common.mustCallAtLeast((nread, buf) => {
+        assert.strictEqual(buf, buffers[buffers.length - 1]);
+        bytes += nread;
+      })
+    }
+  });
+  client.on('end', common.mustCall(() => {
+    assert.strictEqual(bytes, message.length);
+    server.close();
+  }));
+});
+
+// Returning false from the callback pauses the socket.
+startServer((server) => {
+  let bytes = 0;
+  const client = net.connect({
+    port: server.address().port,
+    onread: {
+      buffer: Buffer.alloc(1024),
+      callback: common.mustCallAtLeast((nread) => {
+        bytes += nread;
+        if (bytes === nread) {
+          setImmediate(common.mustCall(() => {
+            assert.strictEqual(client.isPaused(), true);
+            assert.strictEqual(bytes, nread);
+            client.resume();
+          }));
+          client.pause();
+          return false;
+        }
+      })
+    }
+  });
+  client.on('end', common.mustCall(() => {
+    assert.strictEqual(bytes, message.length);
+    server.close();
+  }));
+});
+
+// The buffer function has to return a Uint8Array, when the socket is set up
+// as well as after every read.
+{
+  const server = net.createServer((socket) => {
+    // The client goes away in the middle of the data.
+    socket.on('error', () => {});
+    socket.end(message);
+  });
+  server.listen(0, common.mustCall(() => {
+    common.expectsError(() => net.connect({
+      port: server.address().port,
+      onread: {
+        buffer: () => 'not a buffer',
+        callback: common.mustNotCall()
+      }
+    }), {
+      code: 'ERR_INVALID_RETURN_VALUE',
+      type: TypeError
+    });
+
+    const buffers = [Buffer.alloc(16), null];
+    const client = net.connect({
+      port: server.address().port,
+      onread: {
+        buffer: common.mustCall(() => buffers.shift(), 2),
+        callback: common.mustCall()
+      }
+    });
+    client.on('error', common.expectsError({
+      code: 'ERR_INVALID_RETURN_VALUE',
+      type: TypeError
+    }));
+    client.on('close', common.mustCall(() => server.close()));
+  }));
+}
@@ -0,0 +1,127 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+function makePayload(size) {
+  const payload = Buffer.alloc(size);
+  for (let i = 0; i < payload.length; i++)
+    payload[i] = i % 251;
+  return payload;
+}
+
+common.expectsError(() => new net.Socket().pipeNative({}), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  type: TypeError
+});
+
+// Forwards everything between the clients of the returned server and the
+// backend. The proxy has to be half-open so that the response can still come
+// back once the client has ended its side.
+function createProxy(backend, onPipes) {
+  return net.createServer({ allowHalfOpen: true }, common.mustCall((client) => {
+    const upstream = net.connect({
+      port: backend.address().port,
+      allowHalfOpen: true
+    });
+
+    // On Linux, TCP sockets are spliced in the kernel rather than piped
+    // through JS, which leaves the streams' own pipe bookkeeping untouched.
+    for (const [source, dest] of [[client, upstream], [upstream, client]]) {
+      dest.on('pipe', common.mustCall((src) => {
+        assert.strictEqual(src, source);
+        if (common.isLinux)
+          assert.strictEqual(src._readableState.pipesCount, 0);
+      }));
+    }
+
+    assert.strictEqual(client.pipeNative(upstream), upstream);
+    upstream.pipeNative(client);
+    onPipes(client, upstream);
+  }));
+}
+
+// Data sent to the proxy comes out of the backend unchanged, and both
+// directions end once the client is done.
+{
+  const payload = makePayload(4 * 1024 * 1024);
+
+  const backend = net.createServer(common.mustCall((socket) => {
+    const chunks = [];
+    socket.on('data', (chunk) => chunks.push(chunk));
+    socket.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks), payload);
+      socket.end('done');
+    }));
+  }));
+
+  const proxy = createProxy(backend, (client, upstream) => {
+    upstream.on('close', common.mustCall(() => {
+      assert.strictEqual(client.bytesRead, payload.length);
+      assert.strictEqual(upstream.bytesWritten, payload.length);
+    }));
+  });
+
+  backend.listen(0, common.mustCall(() => {
+    proxy.listen(0, common.mustCall(() => {
+      const client = net.connect(proxy.address().port);
+      let response = '';
+      client.setEncoding('utf8');
+      client.on('data', (chunk) => response += chunk);
+      client.on('end', common.mustCall(() => {
+        assert.strictEqual(response, 'done');
+        proxy.close();
+        backend.close();
+      }));
+      client.end(payload);
+    }));
+  }));
+}
+
+// A backend that doesn't read holds the client back, without the proxy
+// buffering the data in the meantime.
+{
+  // More than the socket buffers of both hops can hold.
+  const payload = makePayload(64 * 1024 * 1024);
+  let backendSocket;
+  let proxySockets;
+
+  const backend = net.createServer(common.mustCall((socket) => {
+    backendSocket = socket;
+    socket.pause();
+    const chunks = [];
+    socket.on('data', (chunk) => chunks.push(chunk));
+    socket.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks), payload);
+      socket.end();
+    }));
+  }));
+
+  const proxy = createProxy(backend, (client, upstream) => {
+    proxySockets = [client, upstream];
+  });
+
+  backend.listen(0, common.mustCall(() => {
+    proxy.listen(0, common.mustCall(() => {
+      const client = net.connect(proxy.address().port);
+      client.on('end', common.mustCall(() => {
+        proxy.close();
+        backend.close();
+      }));
+      client.resume();
+      client.end(payload);
+
+      setTimeout(common.mustCall(() => {
+        assert(client.writableLength > 0);
+        // stream.pipe() would hold up to a highWaterMark in each of them.
+        if (common.isLinux) {
+          for (const socket of proxySockets) {
+            assert.strictEqual(socket.readableLength, 0);
+            assert.strictEqual(socket.writableLength, 0);
+          }
+        }
+        backendSocket.resume();
+      }), common.platformTimeout(500));
+    }));
+  }));
+}
@@ -0,0 +1,49 @@
+// Flags: --experimental-worker
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { MessageChannel } = require('worker_threads');
+
+// Socket reads are views into a slab that later reads go into as well.
+// Transferring its ArrayBuffer copies it, and leaves the socket, the chunks
+// it has already emitted and the ones that follow intact.
+
+const payload = Buffer.alloc(256 * 1024);
+for (let i = 0; i < payload.length; i++)
+  payload[i] = i % 251;
+
+const server = net.createServer(common.mustCall((socket) => {
+  socket.write('first');
+  socket.once('data', common.mustCall(() => socket.end(payload)));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const { port1, port2 } = new MessageChannel();
+  const client = net.connect(server.address().port);
+  const chunks = [];
+
+  client.once('data', common.mustCall((first) => {
+    const ab = first.buffer;
+    const byteLength = ab.byteLength;
+    port1.postMessage(ab, [ab]);
+    assert.strictEqual(ab.byteLength, byteLength);
+    assert.strictEqual(first.toString(), 'first');
+
+    port2.once('message', common.mustCall((received) => {
+      assert.strictEqual(received.byteLength, byteLength);
+      const copy = Buffer.from(received, first.byteOffset, first.length);
+      assert.strictEqual(copy.toString(), 'first');
+      port2.close();
+    }));
+
+    client.on('data', (chunk) => chunks.push(chunk));
+    client.write('go');
+  }));
+
+  client.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(chunks), payload);
+    client.end();
+    server.close();
+  }));
+}));
@@ -0,0 +1,78 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+// Large enough to fill up the socket buffers, so that the transfer has to
+// wait for the reader a couple of times.
+const data = Buffer.alloc(8 * 1024 * 1024);
+for (let i = 0; i < data.length; i++)
+  data[i] = i % 251;
+const file = path.join(tmpdir.path, 'sendfile.bin');
+fs.writeFileSync(file, data);
+
+const expected = Buffer.concat([
+  Buffer.from('head'),
+  data.slice(1000, 1000 + 4096),
+  Buffer.from('mid'),
+  data,
+  data.slice(data.length - 10),
+  Buffer.from('tail')
+]);
+
+const server = net.createServer(common.mustCall((socket) => {
+  const chunks = [];
+  socket.pause();
+  // Read slowly at first to apply backpressure.
+  setTimeout(() => socket.resume(), common.platformTimeout(100));
+  socket.on('data', (chunk) => chunks.push(chunk));
+  socket.on('end', common.mustCall(() => {
+    server.close();
+    assert(Buffer.concat(chunks).equals(expected));
+  }));
+}));
+
+server.listen(0, common.mustCall(async () => {
+  const socket = net.connect(server.address().port);
+  const fd = fs.openSync(file, 'r');
+  const filehandle = await fs.promises.open(file, 'r');
+
+  socket.write('head');
+  socket.sendFile(fd, { offset: 1000, length: 4096 }, common.mustCall());
+  socket.write('mid');
+  socket.sendFile(filehandle, common.mustCall());
+  // Ranges that extend past the end of the file are truncated.
+  socket.sendFile(fd, { offset: data.length - 10, length: 100 },
+                  common.mustCall());
+  socket.sendFile(fd, { offset: data.length * 2 }, common.mustCall());
+  socket.end('tail', common.mustCall(() => {
+    assert.strictEqual(socket.bytesWritten, expected.length);
+    fs.closeSync(fd);
+    filehandle.close();
+  }));
+}));
+
+{
+  const socket = new net.Socket();
+
+  [null, 'fd', -1, 1.5].forEach((file) => {
+    common.expectsError(() => socket.sendFile(file), {
+      type: file === -1 || file === 1.5 ? RangeError : TypeError
+    });
+  });
+
+  common.expectsError(() => socket.sendFile(0, { offset: -1 }), {
+    code: 'ERR_OUT_OF_RANGE',
+    type: RangeError
+  });
+
+  common.expectsError(() => socket.sendFile(0, { length: 'all' }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError
+  });
+}
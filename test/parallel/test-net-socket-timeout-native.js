@@ -0,0 +1,49 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+
+// Sockets with a libuv handle keep track of their idle timeout natively.
+// Tests that reads restart it, that it fires once per idle period, and that
+// it can be turned off.
+
+const assert = require('assert');
+const net = require('net');
+const { kTimeout } = require('internal/timers');
+
+const timeout = common.platformTimeout(100);
+
+const server = net.createServer(common.mustCall((socket) => {
+  socket.setTimeout(timeout);
+  assert.strictEqual(socket[kTimeout], null);
+  assert.strictEqual(socket._handle.getIdleTimeout(), timeout);
+
+  let lastData = Date.now();
+  socket.on('data', () => {
+    lastData = Date.now();
+  });
+
+  socket.once('timeout', common.mustCall(() => {
+    // The client was writing every timeout / 4 ms for a while.
+    assert(Date.now() - lastData >= timeout - 1);
+    socket.on('timeout', common.mustNotCall());
+
+    setTimeout(common.mustCall(() => {
+      socket.removeAllListeners('timeout');
+      socket.setTimeout(0);
+      assert.strictEqual(socket._handle.getIdleTimeout(), 0);
+      socket.end();
+      server.close();
+    }), timeout * 2);
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port);
+  let writes = 0;
+  const interval = setInterval(() => {
+    client.write('x');
+    if (++writes === 8)
+      clearInterval(interval);
+  }, timeout / 4);
+  client.resume();
+}));
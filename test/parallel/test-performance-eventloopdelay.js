@@ -0,0 +1,94 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { monitorEventLoopDelay } = require('perf_hooks');
+
+{
+  const histogram = monitorEventLoopDelay();
+  assert(histogram);
+  assert(histogram.enable());
+  assert(!histogram.enable());
+  histogram.reset();
+  assert(histogram.disable());
+  assert(!histogram.disable());
+}
+
+[null, 'a', 1, false, Infinity].forEach((options) => {
+  common.expectsError(() => monitorEventLoopDelay(options), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError
+  });
+});
+
+[null, 'a', false, {}, []].forEach((resolution) => {
+  common.expectsError(() => monitorEventLoopDelay({ resolution }), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError
+  });
+});
+
+[-1, 0, 1.5, Infinity].forEach((resolution) => {
+  common.expectsError(() => monitorEventLoopDelay({ resolution }), {
+    code: 'ERR_OUT_OF_RANGE',
+    type: RangeError
+  });
+});
+
+{
+  const histogram = monitorEventLoopDelay({ resolution: 1 });
+  histogram.enable();
+  let m = 5;
+  function spinAWhile() {
+    // Block the loop for longer than the sampling interval, so that there is
+    // a delay to record.
+    common.busyLoop(20);
+    if (--m > 0) {
+      setTimeout(spinAWhile, common.platformTimeout(50));
+    } else {
+      histogram.disable();
+      // The values are non-deterministic, so we just check that a value is
+      // present, as opposed to a specific value.
+      assert(histogram.min >= 0);
+      assert(histogram.max >= histogram.min);
+      assert(histogram.max >= 10e6);
+      assert(histogram.mean > 0);
+      assert(histogram.stddev >= 0);
+      assert.strictEqual(histogram.exceeds, 0);
+      assert(histogram.percentiles.size > 0);
+      let last = 0;
+      for (const [percentile, value] of histogram.percentiles) {
+        assert(percentile >= 0 && percentile <= 100);
+        assert(value >= last);
+        last = value;
+      }
+      assert.strictEqual(histogram.percentiles.get(100), histogram.max);
+      for (let n = 1; n < 100; n = n + 10) {
+        assert(histogram.percentile(n) >= histogram.min);
+        assert(histogram.percentile(n) <= histogram.max);
+      }
+      assert.strictEqual(histogram.percentile(100), histogram.max);
+
+      [null, 'a', false, {}, []].forEach((i) => {
+        common.expectsError(() => histogram.percentile(i), {
+          code: 'ERR_INVALID_ARG_TYPE',
+          type: TypeError
+        });
+      });
+      [-1, 0, 101, NaN].forEach((i) => {
+        common.expectsError(() => histogram.percentile(i), {
+          code: 'ERR_INVALID_ARG_VALUE',
+          type: RangeError
+        });
+      });
+
+      histogram.reset();
+      assert.strictEqual(histogram.min, 0);
+      assert.strictEqual(histogram.max, 0);
+      assert(Number.isNaN(histogram.mean));
+      assert(Number.isNaN(histogram.stddev));
+      assert.strictEqual(histogram.percentiles.size, 0);
+    }
+  }
+  spinAWhile();
+}
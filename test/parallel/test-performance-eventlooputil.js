@@ -0,0 +1,45 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { performance } = require('perf_hooks');
+
+const { eventLoopUtilization } = performance;
+
+function checkUtilization(elu) {
+  assert(elu.idle >= 0);
+  assert(elu.active >= 0);
+  assert(elu.utilization >= 0 && elu.utilization <= 1);
+}
+
+// The loop has not been entered yet.
+assert.deepStrictEqual(eventLoopUtilization(),
+                       { idle: 0, active: 0, utilization: 0 });
+
+setTimeout(common.mustCall(() => {
+  const elu1 = eventLoopUtilization();
+  checkUtilization(elu1);
+  // Most of the time until now was spent waiting for the timer.
+  assert(elu1.idle > 0);
+
+  common.busyLoop(50);
+  const elu2 = eventLoopUtilization(elu1);
+  checkUtilization(elu2);
+  // The loop has not been back to the poll phase since elu1, so all of the
+  // time since then counts as active.
+  assert.strictEqual(elu2.idle, 0);
+  assert(elu2.active >= 45);
+  assert.strictEqual(elu2.utilization, 1);
+
+  setTimeout(common.mustCall(() => {
+    const elu3 = eventLoopUtilization();
+    checkUtilization(elu3);
+    assert(elu3.idle > elu1.idle);
+    assert(elu3.active >= elu1.active + 45);
+
+    const diff = eventLoopUtilization(elu3, elu1);
+    checkUtilization(diff);
+    assert.strictEqual(diff.idle, elu3.idle - elu1.idle);
+    assert.strictEqual(diff.active, elu3.active - elu1.active);
+  }), common.platformTimeout(100));
+}), common.platformTimeout(50));
@@ -0,0 +1,94 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const zlib = require('zlib');
+const { threadpool } = require('perf_hooks');
+
+const kClasses = ['fs', 'dns', 'cpu', 'user'];
+const kRequests = 10;
+
+function checkStats(stats) {
+  assert.strictEqual(stats.size, threadpool.size);
+  assert(stats.idle >= 0 && stats.idle <= stats.size);
+  assert.deepStrictEqual(Object.keys(stats.classes), kClasses);
+  for (const name of kClasses) {
+    const cls = stats.classes[name];
+    assert.strictEqual(typeof cls.queued, 'number');
+    assert.strictEqual(typeof cls.running, 'number');
+    assert.strictEqual(cls.waitTime.count, cls.completed);
+    assert.strictEqual(cls.runTime.count, cls.completed);
+    assert.strictEqual(cls.waitTime.buckets.length, 24);
+  }
+}
+
+const size = threadpool.size;
+assert(size >= 1);
+threadpool.resize(size + 2);
+assert.strictEqual(threadpool.size, size + 2);
+
+const before = threadpool.stats();
+checkStats(before);
+
+let pending = 2 * kRequests;
+const done = common.mustCall(() => {
+  if (--pending > 0)
+    return;
+
+  const after = threadpool.stats();
+  checkStats(after);
+  assert(after.classes.fs.completed >= before.classes.fs.completed + kRequests);
+  assert(after.classes.cpu.completed >=
+         before.classes.cpu.completed + kRequests);
+
+  const { runTime } = after.classes.cpu;
+  const median = runTime.percentile(50);
+  assert(median > 0);
+  assert(median <= runTime.percentile(100));
+
+  // Threads above the new size retire, their counters stay.
+  threadpool.resize(1);
+  assert.strictEqual(threadpool.size, 1);
+  fs.stat(__filename, common.mustCall((err) => {
+    assert.ifError(err);
+    assert(threadpool.stats().classes.fs.completed >
+           after.classes.fs.completed);
+    threadpool.resize(size);
+  }));
+}, 2 * kRequests);
+
+const input = Buffer.alloc(64 * 1024, 'x');
+for (let i = 0; i < kRequests; i++) {
+  fs.stat(__filename, common.mustCall((err) => {
+    assert.ifError(err);
+    done();
+  }));
+  zlib.deflate(input, common.mustCall((err) => {
+    assert.ifError(err);
+    done();
+  }));
+}
+
+[0, 1025, -1, 1.5].forEach((value) => {
+  common.expectsError(() => threadpool.resize(value), {
+    code: 'ERR_OUT_OF_RANGE',
+    type: RangeError
+  });
+});
+common.expectsError(() => threadpool.resize('4'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  type: TypeError
+});
+
+const histogram = threadpool.stats().classes.user.runTime;
+[0, 101, NaN].forEach((p) => {
+  common.expectsError(() => histogram.percentile(p), {
+    code: 'ERR_OUT_OF_RANGE',
+    type: RangeError
+  });
+});
+common.expectsError(() => histogram.percentile('50'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  type: TypeError
+});
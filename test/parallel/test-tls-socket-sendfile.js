@@ -0,0 +1,45 @@
+'use strict';
+const common = require('../common');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// TLS sockets can't use sendfile(2), sendFile() copies the file through
+// userland instead.
+
+const assert = require('assert');
+const fs = require('fs');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+
+const file = fixtures.path('person.jpg');
+const data = fs.readFileSync(file);
+
+const options = {
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem')
+};
+
+const server = tls.createServer(options, common.mustCall((socket) => {
+  const fd = fs.openSync(file, 'r');
+  socket.write('head');
+  socket.sendFile(fd, { offset: 1 }, common.mustCall(() => {
+    fs.closeSync(fd);
+  }));
+  socket.end('tail');
+}));
+
+server.listen(0, common.mustCall(() => {
+  const socket = tls.connect({
+    port: server.address().port,
+    rejectUnauthorized: false
+  });
+  const chunks = [];
+  socket.on('data', (chunk) => chunks.push(chunk));
+  socket.on('end', common.mustCall(() => {
+    server.close();
+    const expected =
+      Buffer.concat([Buffer.from('head'), data.slice(1), Buffer.from('tail')]);
+    assert(Buffer.concat(chunks).equals(expected));
+  }));
+}));
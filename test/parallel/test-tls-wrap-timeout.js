@@ -17,19 +17,21 @@ const options = {
   cert: fixtures.readKey('agent1-cert.pem')
 };
 
+// Wait a bit before writing, so that the loop time has moved on when the
+// client reads the data.
 const server = tls.createServer(options, common.mustCall((c) => {
-  setImmediate(() => {
+  setTimeout(() => {
     c.write('hello', () => {
       setImmediate(() => {
         c.destroy();
         server.close();
       });
     });
-  });
+  }, common.platformTimeout(10));
 }));
 
 let socket;
-let lastIdleStart;
+let lastIdleSince;
 
 server.listen(0, () => {
   socket = net.connect(server.address().port, function() {
@@ -38,18 +40,20 @@ server.listen(0, () => {
     });
     assert.ok(s instanceof net.Socket);
 
-    assert.notStrictEqual(socket[kTimeout]._idleTimeout, -1);
-    lastIdleStart = socket[kTimeout]._idleStart;
+    // The TCP handle keeps track of the timeout, and restarts it whenever
+    // the TLS layer on top of it reads or writes.
+    assert.strictEqual(socket[kTimeout], null);
+    assert.strictEqual(socket._handle.getIdleTimeout(), TIMEOUT_MAX);
+    lastIdleSince = socket._handle.getIdleSince();
 
     const tsocket = tls.connect({
       socket: socket,
       rejectUnauthorized: false
     });
+    tsocket.once('data', common.mustCall(() => {
+      // Reading the TLS data went through the TCP handle and refreshed it.
+      assert(lastIdleSince < socket._handle.getIdleSince());
+    }));
     tsocket.resume();
   });
 });
-
-process.on('exit', () => {
-  assert.strictEqual(socket[kTimeout]._idleTimeout, -1);
-  assert(lastIdleStart < socket[kTimeout]._idleStart);
-});
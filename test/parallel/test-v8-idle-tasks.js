@@ -0,0 +1,30 @@
+// Flags: --v8-idle-tasks
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+
+// Leave garbage behind between timers so that V8 has idle work to do, and
+// check that the timers still fire on time.
+const kDelay = 10;
+let rounds = 20;
+let garbage;
+
+function tick() {
+  garbage = [];
+  for (let i = 0; i < 1e4; i++)
+    garbage.push({ i, s: `${i}` });
+
+  const start = process.hrtime();
+  setTimeout(common.mustCall(() => {
+    const [sec, nsec] = process.hrtime(start);
+    const elapsed = sec * 1e3 + nsec / 1e6;
+    assert(elapsed >= kDelay - 1, `timer fired early after ${elapsed}ms`);
+    assert(elapsed < kDelay + common.platformTimeout(500),
+           `timer fired late after ${elapsed}ms`);
+    if (--rounds > 0)
+      tick();
+  }), kDelay);
+}
+
+tick();
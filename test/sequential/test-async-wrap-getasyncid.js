@@ -47,6 +47,9 @@ const { getSystemErrorName } = require('util');
     if (!common.isMainThread)
       delete providers.INSPECTORJSBINDING;
     delete providers.KEYPAIRGENREQUEST;
+    // sendfile(2) is not used on Windows.
+    if (common.isWindows)
+      delete providers.SENDFILEWRAP;
 
     const objKeys = Object.keys(providers);
     if (objKeys.length > 0)
@@ -88,6 +91,14 @@ function testInitialized(req, ctor_name) {
 }
 
 
+{
+  const { ELDHistogram } = internalBinding('performance');
+  const histogram = new ELDHistogram(1);
+  testInitialized(histogram, 'ELDHistogram');
+  histogram.close();
+}
+
+
 {
   const FSEvent = internalBinding('fs_event_wrap').FSEvent;
   testInitialized(new FSEvent(), 'FSEvent');
@@ -206,6 +217,20 @@ if (common.hasCrypto) { // eslint-disable-line node-core/crypto-check
   testUninitialized(new binding.WriteWrap(), 'WriteWrap');
 }
 
+if (!common.isWindows) {
+  const server = net.createServer(common.mustCall((socket) => {
+    server.close();
+    socket.resume();
+  })).listen(0, common.localhostIPv4, common.mustCall(() => {
+    const socket = net.connect(server.address().port, common.localhostIPv4);
+    const fd = fs.openSync(__filename, 'r');
+    socket.sendFile(fd, common.mustCall(() => {
+      fs.closeSync(fd);
+      socket.end();
+    }));
+  }));
+}
+
 {
   const stream_wrap = internalBinding('stream_wrap');
   const tcp_wrap = internalBinding('tcp_wrap');
@@ -91,6 +91,7 @@ const customTypesMap = {
 
   'os.constants.dlopen': 'os.html#os_dlopen_constants',
 
+  'Histogram': 'perf_hooks.html#perf_hooks_class_histogram',
   'PerformanceEntry': 'perf_hooks.html#perf_hooks_class_performanceentry',
   'PerformanceNodeTiming':
     'perf_hooks.html#perf_hooks_class_performancenodetiming_extends_performanceentry', // eslint-disable-line max-len